@@ -26,6 +26,12 @@ namespace I18nTokenEngine
         }
 
         private EngineHandle _handle;
+        private ReloadCallback _reloadCallback; // keeps the delegate alive while the native watcher runs
+
+        /// <summary>
+        /// Raised on the engine's watcher thread after each background reload: (success, error message).
+        /// </summary>
+        public event Action<bool, string> Reloaded;
 
         public enum MetaPluralRule : byte
         {
@@ -47,6 +53,21 @@ namespace I18nTokenEngine
         [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
         private static extern int i18n_load_txt_file(IntPtr ptr, byte[] path, int strict);
 
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int i18n_add_locale_file(IntPtr ptr, byte[] name, byte[] path, int strict);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int i18n_set_locale(IntPtr ptr, byte[] name);
+
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        private delegate void ReloadCallback(IntPtr user, int status, IntPtr error);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int i18n_watch_start(IntPtr ptr, byte[] path, int strict, int debounceMs, ReloadCallback onReload, IntPtr user);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int i18n_watch_stop(IntPtr ptr);
+
         [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
         private static extern int i18n_translate(IntPtr ptr, byte[] token, IntPtr args, int argsLen, byte[] outBuf, int bufSize);
 
@@ -89,6 +110,32 @@ namespace I18nTokenEngine
         [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
         private static extern int i18n_get_native_style(IntPtr ptr, byte[] token, IntPtr args, int argsLen, out NativeStyle style);
 
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int i18n_register_property(IntPtr ptr, byte[] name);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int i18n_get_native_property(IntPtr ptr, byte[] token, IntPtr args, int argsLen, int propertyId, out float value);
+
+        // Span variants: token and args travel as (pointer, length), without NUL terminator.
+        [StructLayout(LayoutKind.Sequential)]
+        private struct NativeArg
+        {
+            public IntPtr Data;
+            public int Len;
+        }
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int i18n_translate_n(IntPtr ptr, ref byte token, int tokenLen, NativeArg[] args, int argsLen, ref byte outBuf, int bufSize);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int i18n_translate_plural_n(IntPtr ptr, ref byte token, int tokenLen, int count, NativeArg[] args, int argsLen, ref byte outBuf, int bufSize);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int i18n_render_to_html_n(IntPtr ptr, ref byte token, int tokenLen, NativeArg[] args, int argsLen, int flags, ref byte outBuf, int bufSize);
+
+        [DllImport(DllName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int i18n_get_native_style_n(IntPtr ptr, ref byte token, int tokenLen, NativeArg[] args, int argsLen, out NativeStyle style);
+
         public I18n()
         {
             _handle = new EngineHandle();
@@ -110,6 +157,76 @@ namespace I18nTokenEngine
             });
         }
 
+        /// <summary>
+        /// Adds one locale catalog (name null: taken from @meta locale). Its @meta fallback chain is merged
+        /// at load time, so a token missing in the active locale is served from the fallback in one lookup.
+        /// </summary>
+        public void AddLocale(string path, string name = null, bool strict = true)
+        {
+            var pathBytes = Encoding.UTF8.GetBytes(path);
+            var pathStr = new byte[pathBytes.Length + 1];
+            Array.Copy(pathBytes, pathStr, pathBytes.Length);
+            byte[] nameStr = null;
+            if (name != null)
+            {
+                var nameBytes = Encoding.UTF8.GetBytes(name);
+                nameStr = new byte[nameBytes.Length + 1];
+                Array.Copy(nameBytes, nameStr, nameBytes.Length);
+            }
+            Execute(handle =>
+            {
+                if (i18n_add_locale_file(handle, nameStr, pathStr, strict ? 1 : 0) != 0)
+                {
+                    throw new InvalidOperationException($"I18n Locale Error: {_last_error()}");
+                }
+            });
+        }
+
+        /// <summary>Switches the active locale atomically; "en_US" also matches a locale named "en".</summary>
+        public void SetLocale(string name)
+        {
+            var nameBytes = Encoding.UTF8.GetBytes(name);
+            var nameStr = new byte[nameBytes.Length + 1];
+            Array.Copy(nameBytes, nameStr, nameBytes.Length);
+            Execute(handle =>
+            {
+                if (i18n_set_locale(handle, nameStr) != 0)
+                {
+                    throw new InvalidOperationException($"I18n Locale Error: {_last_error()}");
+                }
+            });
+        }
+
+        /// <summary>
+        /// Watches the catalog file (null: the file passed to LoadFile) and reloads it in the background
+        /// when its content changes. Replaces a managed FileSystemWatcher; subscribe to <see cref="Reloaded"/>.
+        /// </summary>
+        public void StartWatching(string path = null, int debounceMs = 100, bool strict = true)
+        {
+            byte[] cstr = null;
+            if (path != null)
+            {
+                var data = Encoding.UTF8.GetBytes(path);
+                cstr = new byte[data.Length + 1];
+                Array.Copy(data, cstr, data.Length);
+            }
+
+            _reloadCallback ??= (user, status, error) =>
+                Reloaded?.Invoke(status == 0, error == IntPtr.Zero ? null : Marshal.PtrToStringUTF8(error));
+            Execute(handle =>
+            {
+                if (i18n_watch_start(handle, cstr, strict ? 1 : 0, debounceMs, _reloadCallback, IntPtr.Zero) != 0)
+                {
+                    throw new InvalidOperationException($"I18n Watch Error: {_last_error()}");
+                }
+            });
+        }
+
+        public void StopWatching()
+        {
+            Execute(handle => i18n_watch_stop(handle));
+        }
+
         public string Translate(string token, params string[] args)
         {
             var tokenBytes = Encoding.UTF8.GetBytes(token);
@@ -208,6 +325,126 @@ namespace I18nTokenEngine
             }
         }
 
+        public int RegisterProperty(string name)
+        {
+            var bytes = Encoding.UTF8.GetBytes(name);
+            var cstr = new byte[bytes.Length + 1];
+            Array.Copy(bytes, cstr, bytes.Length);
+
+            int id = Execute(handle => i18n_register_property(handle, cstr));
+            if (id < 0) throw new InvalidOperationException($"I18n error: {_last_error()}");
+            return id;
+        }
+
+        public bool TryGetNativeProperty(string styleToken, int propertyId, out float value, params string[] dynamicValues)
+        {
+            value = 0.0f;
+            var tokenBytes = Encoding.UTF8.GetBytes(NormalizeStyleToken(styleToken));
+            var tokenCStr = new byte[tokenBytes.Length + 1];
+            Array.Copy(tokenBytes, tokenCStr, tokenBytes.Length);
+
+            PrepareArgs(dynamicValues, out var handles, out var argPtrs);
+            try
+            {
+                using var argsRoot = GCHandle.Alloc(argPtrs, GCHandleType.Pinned);
+                IntPtr argsPtr = dynamicValues.Length > 0 ? argsRoot.AddrOfPinnedObject() : IntPtr.Zero;
+                float native = 0.0f;
+                int result = Execute(handle => i18n_get_native_property(handle, tokenCStr, argsPtr, dynamicValues.Length, propertyId, out native));
+                if (result < 0) throw new InvalidOperationException($"I18n error: {_last_error()}");
+                value = native;
+                return result == 1;
+            }
+            finally
+            {
+                ReleaseHandles(handles);
+            }
+        }
+
+        /// <summary>
+        /// Translates a UTF-8 token given as a span into <paramref name="output"/> (UTF-8, NUL-terminated when it fits).
+        /// Token and args are passed by pointer and length, so no NUL terminator and no managed copy is needed;
+        /// args may contain NUL bytes. Returns the full result length in bytes. A value of output.Length or more
+        /// means output was too small and holds a truncated prefix.
+        /// </summary>
+        public int TranslateUtf8(ReadOnlySpan<byte> token, Span<byte> output, params ReadOnlyMemory<byte>[] args)
+        {
+            var nativeArgs = PinArgs(args, out var handles);
+            bool added = false;
+            try
+            {
+                IntPtr engine = AcquireHandle(ref added);
+                int len = i18n_translate_n(engine, ref MemoryMarshal.GetReference(token), token.Length, nativeArgs, args.Length,
+                                           ref MemoryMarshal.GetReference(output), output.Length);
+                if (len < 0) throw new InvalidOperationException($"I18n error: {_last_error()}");
+                return len;
+            }
+            finally
+            {
+                if (added) _handle.DangerousRelease();
+                ReleaseHandles(handles);
+            }
+        }
+
+        /// <summary>Span variant of <see cref="TranslatePlural"/>; output and return value as in <see cref="TranslateUtf8"/>.</summary>
+        public int TranslatePluralUtf8(ReadOnlySpan<byte> token, int count, Span<byte> output, params ReadOnlyMemory<byte>[] args)
+        {
+            var nativeArgs = PinArgs(args, out var handles);
+            bool added = false;
+            try
+            {
+                IntPtr engine = AcquireHandle(ref added);
+                int len = i18n_translate_plural_n(engine, ref MemoryMarshal.GetReference(token), token.Length, count, nativeArgs,
+                                                  args.Length, ref MemoryMarshal.GetReference(output), output.Length);
+                if (len < 0) throw new InvalidOperationException($"I18n error: {_last_error()}");
+                return len;
+            }
+            finally
+            {
+                if (added) _handle.DangerousRelease();
+                ReleaseHandles(handles);
+            }
+        }
+
+        /// <summary>Span variant of <see cref="RenderToHtml"/>; output and return value as in <see cref="TranslateUtf8"/>.</summary>
+        public int RenderToHtmlUtf8(ReadOnlySpan<byte> token, Span<byte> output, params ReadOnlyMemory<byte>[] args)
+        {
+            var nativeArgs = PinArgs(args, out var handles);
+            bool added = false;
+            try
+            {
+                IntPtr engine = AcquireHandle(ref added);
+                int len = i18n_render_to_html_n(engine, ref MemoryMarshal.GetReference(token), token.Length, nativeArgs, args.Length,
+                                                0, ref MemoryMarshal.GetReference(output), output.Length);
+                if (len < 0) throw new InvalidOperationException($"I18n error: {_last_error()}");
+                return len;
+            }
+            finally
+            {
+                if (added) _handle.DangerousRelease();
+                ReleaseHandles(handles);
+            }
+        }
+
+        /// <summary>Span variant of <see cref="TryGetNativeStyle"/>. The token must already carry the style_ prefix.</summary>
+        public bool TryGetNativeStyleUtf8(ReadOnlySpan<byte> styleToken, out NativeStyle style, params ReadOnlyMemory<byte>[] dynamicValues)
+        {
+            var nativeArgs = PinArgs(dynamicValues, out var handles);
+            bool added = false;
+            try
+            {
+                IntPtr engine = AcquireHandle(ref added);
+                int result = i18n_get_native_style_n(engine, ref MemoryMarshal.GetReference(styleToken), styleToken.Length, nativeArgs,
+                                                     dynamicValues.Length, out style);
+                if (result < 0) throw new InvalidOperationException($"I18n error: {_last_error()}");
+                return style.HasValues != 0;
+            }
+            finally
+            {
+                if (added) _handle.DangerousRelease();
+                ReleaseHandles(handles);
+            }
+        }
+
         private static string NormalizeStyleToken(string styleToken)
         {
             if (string.IsNullOrEmpty(styleToken)) return "style_";
@@ -287,6 +524,24 @@ namespace I18nTokenEngine
             }
         }
 
+        // Array-backed memory is pinned in place; anything else is copied once.
+        private static NativeArg[] PinArgs(ReadOnlyMemory<byte>[] args, out GCHandle[] handles)
+        {
+            handles = new GCHandle[args.Length];
+            var native = new NativeArg[args.Length];
+            for (int i = 0; i < args.Length; i++)
+            {
+                if (!MemoryMarshal.TryGetArray(args[i], out ArraySegment<byte> segment) || segment.Array == null)
+                {
+                    segment = new ArraySegment<byte>(args[i].ToArray());
+                }
+                handles[i] = GCHandle.Alloc(segment.Array, GCHandleType.Pinned);
+                native[i].Data = segment.Count > 0 ? Marshal.UnsafeAddrOfPinnedArrayElement(segment.Array, segment.Offset) : IntPtr.Zero;
+                native[i].Len = segment.Count;
+            }
+            return native;
+        }
+
         private static void ReleaseHandles(GCHandle[] handles)
         {
             foreach (var handle in handles)
@@ -319,6 +574,14 @@ namespace I18nTokenEngine
             });
         }
 
+        // For span calls, which cannot run inside the Execute lambdas: the caller releases when added is set.
+        private IntPtr AcquireHandle(ref bool added)
+        {
+            EnsureHandle();
+            _handle.DangerousAddRef(ref added);
+            return _handle.DangerousGetHandle();
+        }
+
         private void EnsureHandle()
         {
             if (_handle == null || _handle.IsInvalid)
@@ -0,0 +1,288 @@
+// Mikrobenchmarks der Engine auf synthetischen Katalogen. Ausgabe: JSON mit ns/op, Allokationen/op
+// und Bytes/op je Benchmark und Kataloggröße. Die Engine wird direkt einkompiliert, damit die
+// ersetzten globalen operator new/delete auch ihre Allokationen zählen.
+//
+//   i18n_bench [--sizes 1000,100000,1000000] [--ref-depth N] [--style-depth N] [--plural-percent N]
+//              [--template-styles N] [--min-ms N] [--filter name] [--out datei.json]
+//   i18n_bench --emit ENTRIES datei.txt   (nur den Katalog erzeugen)
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "i18n_api.h"
+#include "i18n_engine.h"
+#include "synthetic_catalog.h"
+
+namespace {
+
+std::atomic<uint64_t> g_allocs{ 0 };
+std::atomic<uint64_t> g_alloc_bytes{ 0 };
+
+void* counted_alloc(size_t size) {
+  g_allocs.fetch_add(1, std::memory_order_relaxed);
+  g_alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (void* p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+
+} // namespace
+
+void* operator new(size_t size) { return counted_alloc(size); }
+void* operator new[](size_t size) { return counted_alloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+struct BenchResult {
+  std::string name;
+  size_t entries = 0;
+  uint64_t iterations = 0;
+  double ns_per_op = 0;
+  double allocs_per_op = 0;
+  double bytes_per_op = 0;
+};
+
+struct BenchConfig {
+  std::vector<size_t> sizes{ 1000, 100000, 1000000 };
+  SyntheticCatalogOptions catalog;
+  int min_ms = 200;
+  std::string filter;
+  std::string out_path;
+};
+
+// Wiederholt op, bis min_ms erreicht sind (mindestens einmal). setup läuft vor jeder Wiederholung
+// außerhalb der Messung, etwa um eine Eingabe zu kopieren, die op verbraucht.
+BenchResult run_bench(const BenchConfig& config, const std::string& name, size_t entries,
+                      const std::function<void()>& setup, const std::function<void(uint64_t)>& op) {
+  using clock = std::chrono::steady_clock;
+  BenchResult result;
+  result.name = name;
+  result.entries = entries;
+  uint64_t ns = 0, allocs = 0, bytes = 0;
+  const uint64_t budget_ns = (uint64_t)config.min_ms * 1000000u;
+  // Lookups einmal ungemessen aufwärmen: die Scratch-Puffer je Thread wachsen nur beim ersten Aufruf.
+  if (!setup) op(0);
+  // Lookups laufen in Blöcken, damit die Uhr nicht die Messung dominiert.
+  uint64_t batch = setup ? 1 : 64;
+  while (result.iterations == 0 || ns < budget_ns) {
+    if (setup) setup();
+    const uint64_t allocs_before = g_allocs.load(std::memory_order_relaxed);
+    const uint64_t bytes_before = g_alloc_bytes.load(std::memory_order_relaxed);
+    const auto start = clock::now();
+    for (uint64_t i = 0; i < batch; ++i) op(result.iterations + i);
+    ns += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+    allocs += g_allocs.load(std::memory_order_relaxed) - allocs_before;
+    bytes += g_alloc_bytes.load(std::memory_order_relaxed) - bytes_before;
+    result.iterations += batch;
+    if (!setup && batch < 65536) batch *= 2;
+  }
+  result.ns_per_op = (double)ns / (double)result.iterations;
+  result.allocs_per_op = (double)allocs / (double)result.iterations;
+  result.bytes_per_op = (double)bytes / (double)result.iterations;
+  return result;
+}
+
+bool parse_sizes(const std::string& text, std::vector<size_t>& out) {
+  out.clear();
+  size_t pos = 0;
+  while (pos <= text.size()) {
+    const size_t comma = std::min(text.find(',', pos), text.size());
+    const std::string part = text.substr(pos, comma - pos);
+    char* end = nullptr;
+    const unsigned long long value = std::strtoull(part.c_str(), &end, 10);
+    if (part.empty() || *end != '\0' || value == 0) return false;
+    out.push_back((size_t)value);
+    pos = comma + 1;
+  }
+  return !out.empty();
+}
+
+bool wanted(const BenchConfig& config, const std::string& name) {
+  return config.filter.empty() || name.find(config.filter) != std::string::npos;
+}
+
+// Bis zu 4096 Tokens gleichmäßig über die Liste verteilt; Lookups laufen reihum darüber.
+std::vector<std::string> spread(const std::vector<std::string>& tokens) {
+  std::vector<std::string> picked;
+  const size_t step = std::max<size_t>(1, tokens.size() / 4096);
+  for (size_t i = 0; i < tokens.size() && picked.size() < 4096; i += step) picked.push_back(tokens[i]);
+  return picked;
+}
+
+void run_size(const BenchConfig& config, size_t entries, std::vector<BenchResult>& results) {
+  SyntheticCatalogOptions options = config.catalog;
+  options.entries = entries;
+  const SyntheticCatalog cat = generate_synthetic_catalog(options);
+  // Das Binärformat kennt nur Hex-Tokens; Export und Binär-Laden laufen daher auf einer Textvariante
+  // gleicher Größe ohne Styles und Templates.
+  options.text_only = true;
+  const SyntheticCatalog text_cat = generate_synthetic_catalog(options);
+  const std::filesystem::path bin_path =
+      std::filesystem::temp_directory_path() / ("i18n_bench_" + std::to_string(entries) + ".i18n");
+
+  I18nEngine engine;
+  I18nEngine text_engine;
+  if (!engine.load_txt_catalog(cat.text, false) || !text_engine.load_txt_catalog(text_cat.text, false)) {
+    std::cerr << "Katalog (" << entries << ") nicht ladbar: " << engine.get_last_error() << "\n";
+    std::exit(1);
+  }
+  if (!text_engine.export_binary_catalog(bin_path.string().c_str())) {
+    std::cerr << "Binärexport nach " << bin_path.string() << " fehlgeschlagen\n";
+    std::exit(1);
+  }
+  auto report = [&](BenchResult r) {
+    std::fprintf(stderr, "%8zu  %-20s %14.1f ns/op %10.1f allocs/op %12.1f B/op\n", r.entries, r.name.c_str(),
+                 r.ns_per_op, r.allocs_per_op, r.bytes_per_op);
+    results.push_back(std::move(r));
+  };
+
+  if (wanted(config, "parse_text")) {
+    I18nEngine target;
+    std::string src;
+    report(run_bench(config, "parse_text", entries, [&]() { src = cat.text; },
+                     [&](uint64_t) { target.load_txt_catalog(std::move(src), false); }));
+  }
+  if (wanted(config, "load_binary")) {
+    I18nEngine target;
+    const std::string path = bin_path.string();
+    report(run_bench(config, "load_binary", entries, [] {}, [&](uint64_t) { target.load_txt_file(path.c_str(), false); }));
+  }
+
+  // Sehr kleine Kataloge haben nicht für jede Art Einträge; Fälle ohne Tokens fallen dann weg.
+  const std::vector<std::string> args{ "42" };
+  if (wanted(config, "translate") && !cat.chain_tails.empty()) {
+    const auto tokens = spread(cat.chain_tails);
+    report(run_bench(config, "translate", entries, nullptr,
+                     [&](uint64_t i) { engine.translate(tokens[i % tokens.size()], args); }));
+  }
+  if (wanted(config, "translate_ref_arg") && !cat.chain_tails.empty()) {
+    // Arg als Katalog-Referenz: Ketten reichen es an jedes %0 ihrer Glieder weiter.
+    const auto tokens = spread(cat.chain_tails);
+    const std::vector<std::string> ref_args{ tokens.back() };
+    report(run_bench(config, "translate_ref_arg", entries, nullptr,
+                     [&](uint64_t i) { engine.translate(tokens[i % tokens.size()], ref_args); }));
+  }
+  if (wanted(config, "translate_c") && !cat.chain_tails.empty()) {
+    // Über die C-ABI mit Span-Args in einen festen Puffer: der Weg, den Frame-Loops nehmen.
+    const auto tokens = spread(cat.chain_tails);
+    const I18nArg span_args[] = { { "42", 2 } };
+    char buf[1024];
+    report(run_bench(config, "translate_c", entries, nullptr, [&](uint64_t i) {
+      const std::string& token = tokens[i % tokens.size()];
+      i18n_translate_n(&engine, token.data(), (int)token.size(), span_args, 1, buf, (int)sizeof(buf));
+    }));
+  }
+  if (wanted(config, "translate_plural") && !cat.plural_bases.empty()) {
+    const auto tokens = spread(cat.plural_bases);
+    report(run_bench(config, "translate_plural", entries, nullptr,
+                     [&](uint64_t i) { engine.translate_plural(tokens[i % tokens.size()], (int)(i % 3), args); }));
+  }
+  if (wanted(config, "render_to_html") && !cat.templates.empty()) {
+    const auto tokens = spread(cat.templates);
+    const std::vector<std::string> render_args{ "#336699", "Titel" };
+    report(run_bench(config, "render_to_html", entries, nullptr,
+                     [&](uint64_t i) { engine.render_to_html(tokens[i % tokens.size()], render_args); }));
+  }
+  if (wanted(config, "get_native_style") && !cat.styles.empty()) {
+    const auto tokens = spread(cat.styles);
+    const std::vector<std::string> style_args{ "#336699" };
+    report(run_bench(config, "get_native_style", entries, nullptr,
+                     [&](uint64_t i) { engine.get_native_style(tokens[i % tokens.size()], style_args); }));
+  }
+  if (wanted(config, "check_catalog")) {
+    report(run_bench(config, "check_catalog", entries, [] {}, [&](uint64_t) {
+      int code = 0;
+      engine.check_catalog_report(code);
+    }));
+  }
+  if (wanted(config, "export_binary")) {
+    const std::string path = bin_path.string() + ".out";
+    report(run_bench(config, "export_binary", entries, [] {},
+                     [&](uint64_t) { text_engine.export_binary_catalog(path.c_str()); }));
+    std::filesystem::remove(path);
+  }
+  std::filesystem::remove(bin_path);
+}
+
+void write_json(std::ostream& out, const BenchConfig& config, const std::vector<BenchResult>& results) {
+  out << "{\"config\":{\"ref_depth\":" << config.catalog.ref_depth << ",\"style_depth\":" << config.catalog.style_depth
+      << ",\"plural_percent\":" << config.catalog.plural_percent
+      << ",\"template_styles\":" << config.catalog.template_styles << ",\"min_ms\":" << config.min_ms
+      << "},\"results\":[";
+  char buf[256];
+  for (size_t i = 0; i < results.size(); ++i) {
+    const BenchResult& r = results[i];
+    std::snprintf(buf, sizeof(buf),
+                  "%s\n{\"name\":\"%s\",\"entries\":%zu,\"iterations\":%llu,\"ns_per_op\":%.1f,"
+                  "\"allocs_per_op\":%.2f,\"bytes_per_op\":%.1f}",
+                  i ? "," : "", r.name.c_str(), r.entries, (unsigned long long)r.iterations, r.ns_per_op,
+                  r.allocs_per_op, r.bytes_per_op);
+    out << buf;
+  }
+  out << "\n]}\n";
+}
+
+int usage() {
+  std::cerr << "Aufruf: i18n_bench [--sizes a,b,c] [--ref-depth N] [--style-depth N] [--plural-percent N]\n"
+               "                  [--template-styles N] [--min-ms N] [--filter name] [--out datei.json]\n"
+               "       i18n_bench --emit ENTRIES datei.txt\n";
+  return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  BenchConfig config;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--emit" && i + 2 < argc) {
+      config.catalog.entries = std::strtoull(argv[i + 1], nullptr, 10);
+      std::ofstream file(argv[i + 2], std::ios::binary);
+      file << generate_synthetic_catalog(config.catalog).text;
+      return file ? 0 : 1;
+    } else if (arg == "--sizes" && has_value) {
+      if (!parse_sizes(argv[++i], config.sizes)) return usage();
+    } else if (arg == "--ref-depth" && has_value) {
+      config.catalog.ref_depth = std::atoi(argv[++i]);
+    } else if (arg == "--style-depth" && has_value) {
+      config.catalog.style_depth = std::atoi(argv[++i]);
+    } else if (arg == "--plural-percent" && has_value) {
+      config.catalog.plural_percent = std::max(0, std::min(100, std::atoi(argv[++i])));
+    } else if (arg == "--template-styles" && has_value) {
+      config.catalog.template_styles = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "--min-ms" && has_value) {
+      config.min_ms = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "--filter" && has_value) {
+      config.filter = argv[++i];
+    } else if (arg == "--out" && has_value) {
+      config.out_path = argv[++i];
+    } else {
+      return usage();
+    }
+  }
+
+  std::vector<BenchResult> results;
+  for (size_t entries : config.sizes) run_size(config, entries, results);
+
+  if (config.out_path.empty()) {
+    write_json(std::cout, config, results);
+    return 0;
+  }
+  std::ofstream file(config.out_path);
+  write_json(file, config, results);
+  return file ? 0 : 1;
+}
@@ -0,0 +1,377 @@
+// Last- und Latenztest gegen die gebaute Bibliothek (nur C-ABI, wie main.cpp und das Unity-Sample):
+// N Leser-Threads rufen i18n_get_native_style und i18n_translate im Frame-Takt oder ungebremst auf,
+// während ein Watcher-Thread den Katalog im festen Takt neu schreibt und i18n_reload aufruft.
+//
+// Gemessen werden je API Durchsatz und p50/p99/p99.9, die Dauer der Reloads und die Sichtbarkeit
+// eines Snapshot-Wechsels: Jeder Reload schreibt eine neue Generationsnummer in den Marker-Eintrag,
+// die Leser prüfen ihn einmal pro Frame (bzw. alle 64 Aufrufe) und notieren, wann sie die neue
+// Generation zum ersten Mal sehen.
+//
+//   i18n_stress [--readers 1,2,4,8] [--seconds S] [--reload-ms M] [--frame-hz H] [--calls-per-frame K]
+//               [--entries E] [--out datei.json]
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "i18n_api.h"
+#include "synthetic_catalog.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr const char* MARKER_TOKEN = "feedface00";
+constexpr int MARKER_CHECK_EVERY = 64;
+
+uint64_t now_ns() {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// Log-lineares Histogramm: 16 Unterteilungen je Zweierpotenz, also höchstens ~6 % Abweichung
+// pro Quantil. Jeder Thread füllt sein eigenes; ausgewertet wird nach dem Join.
+struct LatencyHistogram {
+  static constexpr int SUB_BITS = 4;
+  static constexpr int SUB = 1 << SUB_BITS;
+  std::vector<uint64_t> counts = std::vector<uint64_t>(64 * SUB, 0);
+  uint64_t total = 0;
+  uint64_t max_ns = 0;
+
+  static size_t bucket_of(uint64_t ns) {
+    if (ns < SUB) return (size_t)ns;
+    const int msb = 63 - __builtin_clzll(ns);
+    return (size_t)(msb - SUB_BITS + 1) * SUB + ((ns >> (msb - SUB_BITS)) & (SUB - 1));
+  }
+  static uint64_t bucket_floor(size_t index) {
+    if (index < (size_t)SUB) return index;
+    const int msb = (int)(index / SUB) + SUB_BITS - 1;
+    return (1ull << msb) | ((uint64_t)(index % SUB) << (msb - SUB_BITS));
+  }
+
+  void add(uint64_t ns) {
+    ++counts[bucket_of(ns)];
+    ++total;
+    max_ns = std::max(max_ns, ns);
+  }
+  void merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < counts.size(); ++i) counts[i] += other.counts[i];
+    total += other.total;
+    max_ns = std::max(max_ns, other.max_ns);
+  }
+  uint64_t quantile(double q) const {
+    if (!total) return 0;
+    const uint64_t rank = std::max<uint64_t>(1, (uint64_t)(q * (double)total + 0.5));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+      seen += counts[i];
+      if (seen >= rank) return std::min(bucket_floor(i), max_ns);
+    }
+    return max_ns;
+  }
+};
+
+enum class Api { NativeStyle, Translate, Count };
+constexpr const char* API_NAMES[] = { "get_native_style", "translate" };
+
+struct Observation {
+  uint32_t generation;
+  uint64_t seen_ns;
+};
+
+struct ReaderState {
+  LatencyHistogram latency[(int)Api::Count];
+  std::vector<Observation> observations;
+  uint64_t errors = 0;
+};
+
+struct ReloadRecord {
+  uint64_t start_ns = 0;
+  uint64_t end_ns = 0;
+  bool ok = false;
+};
+
+struct StressConfig {
+  std::vector<int> readers{ 1, 2, 4, 8 };
+  int seconds = 5;
+  int reload_ms = 50;
+  int frame_hz = 0;
+  int calls_per_frame = 64;
+  size_t entries = 100000;
+  std::string out_path;
+};
+
+struct RunResult {
+  int readers = 0;
+  double seconds = 0;
+  LatencyHistogram latency[(int)Api::Count];
+  uint64_t errors = 0;
+  LatencyHistogram reload;
+  uint64_t reload_failures = 0;
+  LatencyHistogram visible_from_start;   // Reload-Beginn bis ein Leser die Generation sieht
+  LatencyHistogram visible_after_return; // Rückkehr von i18n_reload bis dahin (0, wenn schon vorher sichtbar)
+  uint64_t seen_before_return = 0;
+  uint64_t missed = 0;                   // Generationen, die ein Leser nie gesehen hat (übersprungen)
+};
+
+std::string marker_line(uint32_t generation) {
+  char buf[64];
+  std::snprintf(buf, sizeof(buf), "%s: gen %u\n", MARKER_TOKEN, generation);
+  return buf;
+}
+
+// Schreibt per Umbenennen, damit ein Reload nie eine halb geschriebene Datei liest.
+bool write_catalog(const std::filesystem::path& path, const std::string& body, uint32_t generation) {
+  const std::filesystem::path tmp = path.string() + ".tmp";
+  {
+    std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+    file << marker_line(generation) << body;
+    if (!file) return false;
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp, path, ec);
+  return !ec;
+}
+
+uint32_t read_generation(void* engine, char* buf, int size) {
+  const int n = i18n_translate(engine, MARKER_TOKEN, nullptr, 0, buf, size);
+  if (n <= 4 || n >= size) return 0;
+  return (uint32_t)std::strtoul(buf + 4, nullptr, 10);
+}
+
+void reader_loop(void* engine, const SyntheticCatalog& cat, const StressConfig& config, int seed,
+                 const std::atomic<bool>& stop, ReaderState& state) {
+  const char* style_args[] = { "#336699" };
+  const char* text_args[] = { "42" };
+  char buf[4096];
+  uint32_t last_generation = read_generation(engine, buf, sizeof(buf));
+  size_t style_i = (size_t)seed * 7919, text_i = (size_t)seed * 104729;
+  const auto frame = config.frame_hz > 0 ? std::chrono::nanoseconds(1000000000 / config.frame_hz)
+                                         : std::chrono::nanoseconds(0);
+  auto next_frame = Clock::now();
+
+  while (!stop.load(std::memory_order_relaxed)) {
+    const int calls = config.frame_hz > 0 ? config.calls_per_frame : MARKER_CHECK_EVERY;
+    for (int c = 0; c < calls; ++c) {
+      uint64_t start = now_ns();
+      int rc;
+      Api api;
+      if (c & 1) {
+        const std::string& token = cat.chain_tails[text_i++ % cat.chain_tails.size()];
+        rc = i18n_translate(engine, token.c_str(), text_args, 1, buf, sizeof(buf));
+        api = Api::Translate;
+      } else {
+        I18nNativeStyle style;
+        const std::string& token = cat.styles[style_i++ % cat.styles.size()];
+        rc = i18n_get_native_style(engine, token.c_str(), style_args, 1, &style);
+        api = Api::NativeStyle;
+      }
+      state.latency[(int)api].add(now_ns() - start);
+      if (rc < 0) ++state.errors;
+    }
+
+    const uint32_t generation = read_generation(engine, buf, sizeof(buf));
+    if (generation != last_generation) {
+      state.observations.push_back({ generation, now_ns() });
+      last_generation = generation;
+    }
+    if (config.frame_hz > 0) {
+      next_frame += frame;
+      std::this_thread::sleep_until(next_frame);
+    }
+  }
+}
+
+RunResult run_stress(const StressConfig& config, const SyntheticCatalog& cat, const std::string& body,
+                     const std::filesystem::path& path, int readers) {
+  RunResult result;
+  result.readers = readers;
+  if (!write_catalog(path, body, 1)) {
+    std::cerr << "Katalog nicht schreibbar: " << path.string() << "\n";
+    std::exit(1);
+  }
+  void* engine = i18n_new();
+  if (i18n_load_txt_file(engine, path.string().c_str(), 0) != 0) {
+    std::cerr << "Katalog nicht ladbar: " << i18n_last_error(engine) << "\n";
+    std::exit(1);
+  }
+
+  std::atomic<bool> stop{ false };
+  std::vector<ReaderState> states((size_t)readers);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < readers; ++i)
+    threads.emplace_back(reader_loop, engine, std::cref(cat), std::cref(config), i, std::cref(stop),
+                         std::ref(states[(size_t)i]));
+
+  // Generation g liegt bei reloads[g]; Generation 1 ist der Startkatalog.
+  std::vector<ReloadRecord> reloads(2);
+  const auto begin = Clock::now();
+  const auto deadline = begin + std::chrono::seconds(config.seconds);
+  auto next_reload = begin;
+  while (Clock::now() < deadline) {
+    if (config.reload_ms <= 0) {
+      std::this_thread::sleep_until(deadline);
+      break;
+    }
+    next_reload += std::chrono::milliseconds(config.reload_ms);
+    std::this_thread::sleep_until(std::min(next_reload, deadline));
+    if (Clock::now() >= deadline) break;
+    const uint32_t generation = (uint32_t)reloads.size();
+    if (!write_catalog(path, body, generation)) break;
+    ReloadRecord record;
+    record.start_ns = now_ns();
+    record.ok = i18n_reload(engine) == 0;
+    record.end_ns = now_ns();
+    if (record.ok) {
+      result.reload.add(record.end_ns - record.start_ns);
+    } else {
+      ++result.reload_failures;
+    }
+    reloads.push_back(record);
+  }
+  stop.store(true, std::memory_order_relaxed);
+  for (auto& t : threads) t.join();
+  result.seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+  i18n_free(engine);
+
+  for (const ReaderState& state : states) {
+    for (int a = 0; a < (int)Api::Count; ++a) result.latency[a].merge(state.latency[a]);
+    result.errors += state.errors;
+    uint32_t previous = 1;
+    for (const Observation& seen : state.observations) {
+      if (seen.generation <= previous || seen.generation >= reloads.size()) continue;
+      result.missed += seen.generation - previous - 1;
+      previous = seen.generation;
+      const ReloadRecord& record = reloads[seen.generation];
+      result.visible_from_start.add(seen.seen_ns - record.start_ns);
+      if (seen.seen_ns < record.end_ns) {
+        ++result.seen_before_return;
+        result.visible_after_return.add(0);
+      } else {
+        result.visible_after_return.add(seen.seen_ns - record.end_ns);
+      }
+    }
+  }
+  return result;
+}
+
+void print_histogram(std::ostream& out, const char* name, const LatencyHistogram& h, const std::string& extra = "") {
+  out << "\"" << name << "\":{\"count\":" << h.total << ",\"p50_ns\":" << h.quantile(0.50)
+      << ",\"p99_ns\":" << h.quantile(0.99) << ",\"p999_ns\":" << h.quantile(0.999) << ",\"max_ns\":" << h.max_ns
+      << extra << "}";
+}
+
+void report(const RunResult& r) {
+  std::fprintf(stderr, "readers=%d  %.1fs\n", r.readers, r.seconds);
+  for (int a = 0; a < (int)Api::Count; ++a) {
+    const LatencyHistogram& h = r.latency[a];
+    std::fprintf(stderr, "  %-18s %12.0f ops/s  p50 %8llu  p99 %8llu  p99.9 %9llu  max %10llu ns\n", API_NAMES[a],
+                 (double)h.total / r.seconds, (unsigned long long)h.quantile(0.50),
+                 (unsigned long long)h.quantile(0.99), (unsigned long long)h.quantile(0.999),
+                 (unsigned long long)h.max_ns);
+  }
+  std::fprintf(stderr, "  %-18s %12llu x      p50 %8llu  p99 %8llu  max %10llu ns\n", "reload",
+               (unsigned long long)r.reload.total, (unsigned long long)r.reload.quantile(0.50),
+               (unsigned long long)r.reload.quantile(0.99), (unsigned long long)r.reload.max_ns);
+  std::fprintf(stderr, "  %-18s p50 %llu  p99 %llu ns nach Rückkehr (%llu von %llu schon vorher sichtbar)\n",
+               "sichtbar", (unsigned long long)r.visible_after_return.quantile(0.50),
+               (unsigned long long)r.visible_after_return.quantile(0.99), (unsigned long long)r.seen_before_return,
+               (unsigned long long)r.visible_after_return.total);
+}
+
+void write_json(std::ostream& out, const StressConfig& config, const std::vector<RunResult>& results) {
+  out << "{\"config\":{\"seconds\":" << config.seconds << ",\"reload_ms\":" << config.reload_ms
+      << ",\"frame_hz\":" << config.frame_hz << ",\"calls_per_frame\":" << config.calls_per_frame
+      << ",\"entries\":" << config.entries << "},\"runs\":[";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const RunResult& r = results[i];
+    out << (i ? "," : "") << "\n{\"readers\":" << r.readers << ",\"seconds\":" << r.seconds << ",\"errors\":" << r.errors
+        << ",\"apis\":{";
+    for (int a = 0; a < (int)Api::Count; ++a) {
+      if (a) out << ",";
+      const uint64_t ops_per_s = (uint64_t)((double)r.latency[a].total / r.seconds);
+      print_histogram(out, API_NAMES[a], r.latency[a], ",\"ops_per_s\":" + std::to_string(ops_per_s));
+    }
+    out << "},";
+    print_histogram(out, "reload", r.reload);
+    out << ",\"reload_failures\":" << r.reload_failures << ",\"visibility\":{";
+    print_histogram(out, "from_reload_start", r.visible_from_start);
+    out << ",";
+    print_histogram(out, "after_reload_return", r.visible_after_return);
+    out << ",\"seen_before_return\":" << r.seen_before_return << ",\"skipped_generations\":" << r.missed << "}}";
+  }
+  out << "\n]}\n";
+}
+
+bool parse_list(const std::string& text, std::vector<int>& out) {
+  out.clear();
+  size_t pos = 0;
+  while (pos <= text.size()) {
+    const size_t comma = std::min(text.find(',', pos), text.size());
+    const int value = std::atoi(text.substr(pos, comma - pos).c_str());
+    if (value <= 0) return false;
+    out.push_back(value);
+    pos = comma + 1;
+  }
+  return !out.empty();
+}
+
+int usage() {
+  std::cerr << "Aufruf: i18n_stress [--readers 1,2,4,8] [--seconds S] [--reload-ms M] [--frame-hz H]\n"
+               "                   [--calls-per-frame K] [--entries E] [--out datei.json]\n";
+  return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  StressConfig config;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc) return usage();
+    const char* value = argv[++i];
+    if (arg == "--readers") {
+      if (!parse_list(value, config.readers)) return usage();
+    } else if (arg == "--seconds") {
+      config.seconds = std::max(1, std::atoi(value));
+    } else if (arg == "--reload-ms") {
+      config.reload_ms = std::max(0, std::atoi(value));
+    } else if (arg == "--frame-hz") {
+      config.frame_hz = std::max(0, std::atoi(value));
+    } else if (arg == "--calls-per-frame") {
+      config.calls_per_frame = std::max(1, std::atoi(value));
+    } else if (arg == "--entries") {
+      config.entries = (size_t)std::max(1000ll, std::atoll(value));
+    } else if (arg == "--out") {
+      config.out_path = value;
+    } else {
+      return usage();
+    }
+  }
+
+  SyntheticCatalogOptions options;
+  options.entries = config.entries;
+  const SyntheticCatalog cat = generate_synthetic_catalog(options);
+  const std::filesystem::path path = std::filesystem::temp_directory_path() / "i18n_stress_catalog.txt";
+
+  std::vector<RunResult> results;
+  for (int readers : config.readers) {
+    results.push_back(run_stress(config, cat, cat.text, path, readers));
+    report(results.back());
+  }
+  std::filesystem::remove(path);
+
+  if (config.out_path.empty()) {
+    write_json(std::cout, config, results);
+    return 0;
+  }
+  std::ofstream file(config.out_path);
+  write_json(file, config, results);
+  return file ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+#pragma once
+// Deterministischer Generator für synthetische Kataloge (Benchmarks, Lasttests). Gleiche Optionen
+// ergeben byte-gleiche Kataloge, unabhängig von Plattform und Lauf.
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct SyntheticCatalogOptions {
+  size_t entries = 1000;      // Zielgröße inklusive Styles, Templates und Plural-Varianten
+  int ref_depth = 4;          // Länge der @-Referenzketten zwischen Texten (1: keine Referenzen)
+  int style_depth = 3;        // Länge der Vererbungsketten zwischen Styles (1: keine Vererbung)
+  int plural_percent = 10;    // Anteil der Texteinträge, die als Pluralfamilie (Basis, {one}, {other}) entstehen
+  int template_styles = 4;    // Style-Referenzen je Template
+  bool text_only = false;     // keine Styles/Templates: nur Hex-Tokens, wie sie der Binärexport verlangt
+  uint64_t seed = 0x5eed;
+};
+
+// Tokens des erzeugten Katalogs, nach Rolle getrennt, damit Benchmarks gezielt auswählen können.
+struct SyntheticCatalog {
+  std::string text;
+  std::vector<std::string> chain_tails;    // Texte am Ende einer Referenzkette (tiefste Auflösung)
+  std::vector<std::string> plural_bases;
+  std::vector<std::string> styles;
+  std::vector<std::string> templates;
+};
+
+namespace synthetic_detail {
+
+inline uint64_t splitmix64(uint64_t& state) {
+  uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+// Eindeutig je Index: ungerader Multiplikator modulo 2^32 ist eine Bijektion.
+inline std::string hex_token(uint32_t index) {
+  static constexpr char HEX[] = "0123456789abcdef";
+  const uint32_t value = index * 0x9E3779B1u;
+  std::string token(8, '0');
+  for (int i = 7, shift = 0; i >= 0; --i, shift += 4) token[(size_t)i] = HEX[(value >> shift) & 0xF];
+  return token;
+}
+
+inline void append_words(std::string& out, uint64_t& rng, int count) {
+  static constexpr const char* WORDS[] = { "alpha", "beta", "gamma", "delta", "eta", "theta", "iota", "kappa",
+                                           "lambda", "mu", "nu", "xi", "omicron", "pi", "rho", "sigma" };
+  for (int i = 0; i < count; ++i) {
+    if (i) out += ' ';
+    out += WORDS[splitmix64(rng) & 15];
+  }
+}
+
+inline void append_color(std::string& out, uint64_t& rng) {
+  static constexpr char HEX[] = "0123456789abcdef";
+  const uint64_t bits = splitmix64(rng);
+  out += '#';
+  for (int i = 0; i < 6; ++i) out += HEX[(bits >> (i * 4)) & 0xF];
+}
+
+} // namespace synthetic_detail
+
+inline SyntheticCatalog generate_synthetic_catalog(const SyntheticCatalogOptions& options) {
+  using namespace synthetic_detail;
+  SyntheticCatalog cat;
+  uint64_t rng = options.seed;
+  const int ref_depth = options.ref_depth < 1 ? 1 : options.ref_depth;
+  const int style_depth = options.style_depth < 1 ? 1 : options.style_depth;
+
+  const size_t styles = options.text_only ? 0 : options.entries / 50 < 8 ? 8 : options.entries / 50;
+  const size_t templates = options.text_only ? 0 : options.entries / 100 < 4 ? 4 : options.entries / 100;
+  const size_t fixed = styles + templates;
+  const size_t rest = options.entries > fixed ? options.entries - fixed : 0;
+  const size_t families = rest * (size_t)options.plural_percent / 100 / 3;
+  const size_t texts = rest - families * 3;
+
+  std::string& out = cat.text;
+  out.reserve(options.entries * 48);
+  out += "@meta locale=en\n@meta note=synthetic\n\n";
+
+  // Styles: Kettenköpfe tragen Physik-Kanäle, alle weiteren erben vom Vorgänger per @-Referenz.
+  for (size_t i = 0; i < styles; ++i) {
+    const std::string token = "style_s" + std::to_string(i);
+    out += token;
+    out += ": ";
+    if (i % (size_t)style_depth == 0) {
+      out += "--mass: ";
+      out += std::to_string(1 + i % 5);
+      out += "; --friction: 0.5; padding: 1rem; color: ";
+      append_color(out, rng);
+      out += ';';
+    } else {
+      out += "color: ";
+      append_color(out, rng);
+      out += "; border: 1px solid %0; @style_s";
+      out += std::to_string(i - 1);
+      out += ';';
+    }
+    out += '\n';
+    cat.styles.push_back(token);
+  }
+
+  for (size_t i = 0; i < templates; ++i) {
+    const std::string token = "tpl_t" + std::to_string(i);
+    out += token;
+    out += ": <section>";
+    for (int s = 0; s < options.template_styles; ++s) {
+      out += "<div class=\"@style_s";
+      out += std::to_string(splitmix64(rng) % styles);
+      out += "\">";
+      append_words(out, rng, 3);
+      out += s == 0 ? " %0" : "";
+      out += "</div>";
+    }
+    out += "</section>\n";
+    cat.templates.push_back(token);
+  }
+
+  // Texte in Ketten der Länge ref_depth: jedes Glied außer dem ersten verweist auf seinen Vorgänger.
+  uint32_t next_index = 0;
+  for (size_t i = 0; i < texts; ++i) {
+    const std::string token = hex_token(next_index++);
+    const int link = (int)(i % (size_t)ref_depth);
+    out += token;
+    if (i % 7 == 0) {
+      out += "(Label";
+      out += std::to_string(i);
+      out += ')';
+    }
+    out += ": ";
+    append_words(out, rng, 2 + (int)(splitmix64(rng) % 6));
+    if (i % 3 == 0) out += " %0";
+    if (link > 0) {
+      out += " @";
+      out += hex_token(next_index - 2);
+    }
+    out += '\n';
+    if (link == ref_depth - 1) cat.chain_tails.push_back(token);
+  }
+
+  for (size_t i = 0; i < families; ++i) {
+    const std::string token = hex_token(next_index++);
+    out += token;
+    out += ": %0 ";
+    append_words(out, rng, 2);
+    out += '\n';
+    out += token;
+    out += "{one}: one ";
+    append_words(out, rng, 1);
+    out += '\n';
+    out += token;
+    out += "{other}: %0 ";
+    append_words(out, rng, 2);
+    out += '\n';
+    cat.plural_bases.push_back(token);
+  }
+  return cat;
+}
@@ -95,6 +95,14 @@ PAGE_DEFINITIONS = [
 ]
 
 
+class RenderJob(ctypes.Structure):
+    _fields_ = [
+        ("token", ctypes.c_char_p),
+        ("args", ctypes.POINTER(ctypes.c_char_p)),
+        ("args_len", ctypes.c_int),
+    ]
+
+
 class NativeEngine:
     def __init__(self, dll_path: str):
         self.lib = ctypes.CDLL(dll_path)
@@ -122,8 +130,40 @@ class NativeEngine:
         )
         self.lib.i18n_get_physics_json.restype = ctypes.c_int
         self.lib.i18n_render_to_html.restype = ctypes.c_int
+        self.lib.i18n_render_to_html_linked.argtypes = (
+            ctypes.c_void_p,
+            ctypes.c_char_p,
+            ctypes.POINTER(ctypes.c_char_p),
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_char_p,
+            ctypes.c_char_p,
+            ctypes.c_int,
+        )
+        self.lib.i18n_render_to_html_linked.restype = ctypes.c_int
+        self.lib.i18n_export_stylesheet.argtypes = (
+            ctypes.c_void_p,
+            ctypes.c_char_p,
+            ctypes.POINTER(ctypes.c_char_p),
+            ctypes.c_int,
+            ctypes.c_char_p,
+            ctypes.c_int,
+        )
+        self.lib.i18n_export_stylesheet.restype = ctypes.c_int
         self.lib.i18n_last_error_copy.argtypes = (ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int)
         self.lib.i18n_last_error_copy.restype = ctypes.c_int
+        self.lib.i18n_render_batch.argtypes = (
+            ctypes.c_void_p,
+            ctypes.POINTER(RenderJob),
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_char_p,
+            ctypes.c_int,
+        )
+        self.lib.i18n_render_batch.restype = ctypes.c_void_p
+        self.lib.i18n_batch_result.argtypes = (ctypes.c_void_p, ctypes.c_int, ctypes.POINTER(ctypes.c_int))
+        self.lib.i18n_batch_result.restype = ctypes.POINTER(ctypes.c_char)
+        self.lib.i18n_batch_free.argtypes = (ctypes.c_void_p,)
 
         self.handle = self.lib.i18n_new()
         if not self.handle:
@@ -148,6 +188,31 @@ class NativeEngine:
             if self.lib.i18n_load_txt(self.handle, raw, 1) != 0:
                 raise RuntimeError(f"Could not load catalog: {self._last_error()}")
 
+    def render_batch(self, jobs: list[tuple[str, list[str]]], stylesheet_href: str | None = None) -> list[str]:
+        # Alle Jobs in einem Aufruf: die DLL rendert sie parallel gegen denselben Snapshot.
+        native_jobs = (RenderJob * len(jobs))()
+        keep_alive = []
+        for i, (token, args) in enumerate(jobs):
+            arr = (ctypes.c_char_p * len(args))(*[value.encode("utf-8") for value in args])
+            keep_alive.append(arr)
+            native_jobs[i].token = token.encode("utf-8")
+            native_jobs[i].args = arr if args else None
+            native_jobs[i].args_len = len(args)
+
+        href_bytes = stylesheet_href.encode("utf-8") if stylesheet_href else None
+        batch = self.lib.i18n_render_batch(self.handle, native_jobs, len(jobs), 0, href_bytes, 0)
+        if not batch:
+            raise RuntimeError(f"Batch render failed: {self._last_error()}")
+        try:
+            results = []
+            for i in range(len(jobs)):
+                length = ctypes.c_int()
+                data = self.lib.i18n_batch_result(batch, i, ctypes.byref(length))
+                results.append(ctypes.string_at(data, length.value).decode("utf-8"))
+            return results
+        finally:
+            self.lib.i18n_batch_free(batch)
+
     def render_to_html(self, token: str, args: list[str]) -> str:
         arr = (ctypes.c_char_p * len(args))()
         for i, value in enumerate(args):
@@ -166,6 +231,33 @@ class NativeEngine:
 
         return buf.value.decode("utf-8")
 
+    def render_linked(self, token: str, args: list[str], stylesheet_href: str) -> str:
+        arr = (ctypes.c_char_p * len(args))()
+        for i, value in enumerate(args):
+            arr[i] = value.encode("utf-8")
+
+        token_bytes = token.encode("utf-8")
+        href_bytes = stylesheet_href.encode("utf-8")
+        length = self.lib.i18n_render_to_html_linked(
+            self.handle, token_bytes, arr if args else None, len(args), 0, href_bytes, None, 0
+        )
+        if length < 0:
+            raise RuntimeError(f"Render failed: {self._last_error()}")
+
+        buf = ctypes.create_string_buffer(length + 1)
+        if self.lib.i18n_render_to_html_linked(
+            self.handle, token_bytes, arr if args else None, len(args), 0, href_bytes, buf, length + 1
+        ) < 0:
+            raise RuntimeError(f"Render failed: {self._last_error()}")
+
+        return buf.value.decode("utf-8")
+
+    def export_stylesheet(self, out_dir: Path) -> str:
+        buf = ctypes.create_string_buffer(256)
+        if self.lib.i18n_export_stylesheet(self.handle, str(out_dir).encode("utf-8"), None, 0, buf, len(buf)) < 0:
+            raise RuntimeError(f"Stylesheet export failed: {self._last_error()}")
+        return buf.value.decode("utf-8")
+
     def get_physics_json(self, token: str, args: list[str]) -> str:
         arr = (ctypes.c_char_p * len(args))()
         for i, value in enumerate(args):
@@ -200,6 +292,10 @@ def split_style(rendered: str) -> tuple[str, str]:
 def extract_style_blocks(rendered: str) -> tuple[list[str], str]:
     styles = []
     remaining = rendered.strip()
+    # Linked-Render: der <link> auf das gemeinsame Stylesheet kommt in den <head>
+    if remaining.startswith("<link "):
+        end = remaining.find(">") + 1
+        remaining = remaining[end:].strip()
     while remaining.startswith("<style>"):
         end = remaining.find("</style>")
         if end == -1:
@@ -210,11 +306,10 @@ def extract_style_blocks(rendered: str) -> tuple[list[str], str]:
     return styles, remaining
 
 
-def render_card_set(engine: NativeEngine, card_defs: list[tuple[str, list[str]]]) -> tuple[list[str], str]:
-    styles = []
-    bodies = []
-    for template, args in card_defs:
-        rendered_card = engine.render_to_html(template, args)
+def render_card_set(engine: NativeEngine, card_defs: list[tuple[str, list[str]]], stylesheet: str) -> tuple[list[str], str]:
+    styles: list[str] = []
+    bodies: list[str] = []
+    for rendered_card in engine.render_batch(card_defs, stylesheet):
         card_styles, card_markup = extract_style_blocks(rendered_card)
         styles.extend(card_styles)
         bodies.append(card_markup)
@@ -268,11 +363,13 @@ def build_document_with_physics(style_block: str, body: str, animation_script: s
     )
 
 
-def build_page(engine: NativeEngine, hero_title: str, card_defs: list[tuple[str, list[str]]], output_path: Path) -> None:
-    card_styles, grid_content = render_card_set(engine, card_defs)
-    html_payload = engine.render_to_html("tpl_full-page", [hero_title, grid_content])
+def build_page(engine: NativeEngine, hero_title: str, card_defs: list[tuple[str, list[str]]], output_path: Path,
+               stylesheet: str) -> None:
+    card_styles, grid_content = render_card_set(engine, card_defs, stylesheet)
+    html_payload = engine.render_linked("tpl_full-page", [hero_title, grid_content], stylesheet)
     template_styles, body_markup = extract_style_blocks(html_payload)
-    style_block = "\n".join(template_styles + card_styles) + EXTRA_STYLE
+    link_tag = f'<link rel="stylesheet" href="{stylesheet}">'
+    style_block = "\n".join([link_tag] + template_styles + card_styles) + EXTRA_STYLE
     physics_json = engine.get_physics_json("tpl_full-page", [hero_title, grid_content])
     animation_script = build_animation_script(physics_json)
     document = build_document_with_physics(style_block, body_markup, animation_script)
@@ -284,10 +381,12 @@ def main():
 
     engine = NativeEngine(os.path.join(os.getcwd(), DLL_NAME))
     engine.load_catalog(CATALOG_PATH)
+    stylesheet = engine.export_stylesheet(OUTPUT_PATH.parent)
+    print(f"Generated {OUTPUT_PATH.parent / stylesheet}")
 
     for filename, hero_title, cards in PAGE_DEFINITIONS:
         target_path = OUTPUT_PATH.parent / filename
-        build_page(engine, hero_title, cards, target_path)
+        build_page(engine, hero_title, cards, target_path, stylesheet)
         print(f"Generated {target_path}")
 
 
@@ -256,6 +256,14 @@ PAGE_DEFINITIONS = [
     ("insights.html", "SUBQG INSIGHTS", INSIGHTS_CARDS),
 ]
 
+class RenderJob(ctypes.Structure):
+    _fields_ = [
+        ("token", ctypes.c_char_p),
+        ("args", ctypes.POINTER(ctypes.c_char_p)),
+        ("args_len", ctypes.c_int),
+    ]
+
+
 class NativeEngine:
     def __init__(self, dll_path: str):
         self.lib = ctypes.CDLL(dll_path)
@@ -285,6 +293,18 @@ class NativeEngine:
         self.lib.i18n_get_physics_json.restype = ctypes.c_int
         self.lib.i18n_last_error_copy.argtypes = (ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int)
         self.lib.i18n_last_error_copy.restype = ctypes.c_int
+        self.lib.i18n_render_batch.argtypes = (
+            ctypes.c_void_p,
+            ctypes.POINTER(RenderJob),
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_char_p,
+            ctypes.c_int,
+        )
+        self.lib.i18n_render_batch.restype = ctypes.c_void_p
+        self.lib.i18n_batch_result.argtypes = (ctypes.c_void_p, ctypes.c_int, ctypes.POINTER(ctypes.c_int))
+        self.lib.i18n_batch_result.restype = ctypes.POINTER(ctypes.c_char)
+        self.lib.i18n_batch_free.argtypes = (ctypes.c_void_p,)
 
         self.handle = self.lib.i18n_new()
         if not self.handle:
@@ -309,6 +329,31 @@ class NativeEngine:
                 raw = fh.read()
             if self.lib.i18n_load_txt(self.handle, raw, 1) != 0:
                 raise RuntimeError(f"Could not load catalog: {self._last_error()}")
+
+    def render_batch(self, jobs: list[tuple[str, list[str]]], stylesheet_href: str | None = None) -> list[str]:
+        # Alle Jobs in einem Aufruf: die DLL rendert sie parallel gegen denselben Snapshot.
+        native_jobs = (RenderJob * len(jobs))()
+        keep_alive = []
+        for i, (token, args) in enumerate(jobs):
+            arr = (ctypes.c_char_p * len(args))(*[value.encode("utf-8") for value in args])
+            keep_alive.append(arr)
+            native_jobs[i].token = token.encode("utf-8")
+            native_jobs[i].args = arr if args else None
+            native_jobs[i].args_len = len(args)
+
+        href_bytes = stylesheet_href.encode("utf-8") if stylesheet_href else None
+        batch = self.lib.i18n_render_batch(self.handle, native_jobs, len(jobs), 0, href_bytes, 0)
+        if not batch:
+            raise RuntimeError(f"Batch render failed: {self._last_error()}")
+        try:
+            results = []
+            for i in range(len(jobs)):
+                length = ctypes.c_int()
+                data = self.lib.i18n_batch_result(batch, i, ctypes.byref(length))
+                results.append(ctypes.string_at(data, length.value).decode("utf-8"))
+            return results
+        finally:
+            self.lib.i18n_batch_free(batch)
 
     def render_to_html(self, token: str, args: list[str]) -> str:
         arr = (ctypes.c_char_p * len(args))()
@@ -360,8 +405,7 @@ def extract_style_blocks(rendered: str) -> tuple[list[str], str]:
 def render_card_set(engine: NativeEngine, card_defs: list[tuple[str, list[str]]]) -> tuple[list[str], str]:
     styles: list[str] = []
     bodies: list[str] = []
-    for template, args in card_defs:
-        rendered_card = engine.render_to_html(template, args)
+    for rendered_card in engine.render_batch(card_defs):
         card_styles, card_markup = extract_style_blocks(rendered_card)
         styles.extend(card_styles)
         bodies.append(card_markup)
@@ -3,10 +3,13 @@
 #include "i18n_engine.h"
 
 #include <cstring>
+#include <deque>
 #include <string>
+#include <memory>
 #include <vector>
 #include <cstdint>
 #include <limits>
+#include <algorithm>
 
 namespace {
 constexpr uint32_t ABI_VERSION = 1;
@@ -30,6 +33,100 @@ static std::vector<std::string> build_vec_args(const char** args, int args_len)
   for (int i = 0; i < args_len; ++i) vec_args.emplace_back(args[i] ? args[i] : "");
   return vec_args;
 }
+
+// Args als string_views für Aufrufe, die sie nicht über den Aufruf hinaus halten: keine Kopie der
+// Inhalte, bis zu 16 Args ohne Heap. NULL-Args werden zu leeren Strings.
+class ArgViews {
+public:
+  ArgViews(const char** args, int args_len) {
+    std::string_view* views = reserve(args ? args_len : 0);
+    for (size_t i = 0; i < size_; ++i) views[i] = args[i] ? std::string_view(args[i]) : std::string_view();
+  }
+  ArgViews(const I18nArg* args, int args_len) {
+    std::string_view* views = reserve(args ? args_len : 0);
+    for (size_t i = 0; i < size_; ++i) {
+      const bool empty = !args[i].data || args[i].len <= 0;
+      views[i] = empty ? std::string_view() : std::string_view(args[i].data, (size_t)args[i].len);
+    }
+  }
+  ArgViews(const ArgViews&) = delete;
+  ArgViews& operator=(const ArgViews&) = delete;
+  operator I18nEngine::ArgList() const noexcept { return { data_, size_ }; }
+
+private:
+  static constexpr size_t INLINE_ARGS = 16;
+  std::string_view* reserve(int count) {
+    size_ = count > 0 ? (size_t)count : 0;
+    if (size_ > INLINE_ARGS) {
+      overflow_.resize(size_);
+      data_ = overflow_.data();
+    }
+    return data_;
+  }
+  std::string_view inline_[INLINE_ARGS];
+  std::vector<std::string_view> overflow_;
+  std::string_view* data_ = inline_;
+  size_t size_ = 0;
+};
+
+void fill_native_style(const I18nEngine::NativeStyle& native, I18nNativeStyle* out_style) {
+  out_style->mass = native.mass;
+  out_style->friction = native.friction;
+  out_style->restitution = native.restitution;
+  out_style->drag = native.drag;
+  out_style->gravity_scale = native.gravity_scale;
+  out_style->spacing = native.spacing;
+  out_style->has_values = native.has_physical ? 1 : 0;
+}
+
+std::string join_lines(const std::vector<std::string>& items) {
+  std::string joined;
+  for (const auto& item : items) {
+    joined += item;
+    joined += '\n';
+  }
+  return joined;
+}
+
+struct SinkTarget {
+  i18n_sink_fn fn;
+  void* user;
+};
+
+bool forward_to_sink(void* user, const char* data, size_t len) {
+  auto* target = static_cast<SinkTarget*>(user);
+  // Blöcke sind <= CHUNK_SIZE, außer bei großen Referenzen; die werden int-gerecht geteilt.
+  while (len > 0) {
+    const int step = (int)std::min<size_t>(len, (size_t)std::numeric_limits<int>::max());
+    if (target->fn(target->user, data, step) != 0) return false;
+    data += step;
+    len -= (size_t)step;
+  }
+  return true;
+}
+
+struct RenderBatch {
+  std::vector<std::string> results;
+};
+
+struct SearchPage {
+  size_t total = 0;
+  std::vector<I18nEngine::SearchHit> hits;
+};
+
+struct CheckRun {
+  I18nEngine::CheckResult result;
+};
+
+struct LoadHandle {
+  std::shared_ptr<I18nEngine::LoadTicket> ticket;
+};
+
+int finish_stream(I18nEngine* eng, bool ok, bool is_sink) {
+  if (ok) return 0;
+  set_engine_error(eng, is_sink ? "SINK_ABORTED" : "WRITE_FAILED");
+  return -1;
+}
 }
 
 extern "C" {
@@ -63,11 +160,8 @@ I18N_API int i18n_last_error_copy(void* ptr, char* out_buf, int buf_size) {
 
 static int copy_to_buffer(I18nEngine* engine, const std::string& src, char* out_buf, int buf_size) {
   const size_t full_len = src.size();
-  if (full_len >= RESULT_TOO_LARGE_LIMIT) {
-    set_engine_error(engine, "RESULT_TOO_LARGE");
-    return -1;
-  }
-  if (full_len > (size_t)std::numeric_limits<int>::max()) {
+  if (full_len >= RESULT_TOO_LARGE_LIMIT || full_len > (size_t)std::numeric_limits<int>::max()) {
+    count_result_too_large(engine);
     set_engine_error(engine, "RESULT_TOO_LARGE");
     return -1;
   }
@@ -81,6 +175,42 @@ static int copy_to_buffer(I18nEngine* engine, const std::string& src, char* out_
   return result_len;
 }
 
+// Ergebnispuffer der Lookup-Aufrufe, als Stapel je Thread wie der ScratchFrame der Engine. Puffer
+// behalten ihre Kapazität, damit ein warmer Aufruf bis zum memcpy in out_buf nichts auf dem Heap anlegt;
+// Ausreißer geben sie danach wieder frei. Ein Trace-Hook, der aus einem Aufruf heraus wieder in die
+// Bibliothek ruft, bekommt den nächsten Puffer und überschreibt nicht das Ergebnis des äußeren.
+class CallResult {
+public:
+  CallResult() : stack_(thread_stack()) {
+    if (stack_.used == stack_.buffers.size()) stack_.buffers.emplace_back();
+    result_ = &stack_.buffers[stack_.used++];
+    result_->clear();
+  }
+  ~CallResult() {
+    if (result_->capacity() > 64 * 1024) std::string().swap(*result_);
+    --stack_.used;
+  }
+  CallResult(const CallResult&) = delete;
+  CallResult& operator=(const CallResult&) = delete;
+
+  std::string& str() noexcept { return *result_; }
+  int copy_to(I18nEngine* engine, char* out_buf, int buf_size) const {
+    return copy_to_buffer(engine, *result_, out_buf, buf_size);
+  }
+
+private:
+  struct Stack {
+    std::deque<std::string> buffers; // deque: Referenzen bleiben beim Anhängen gültig
+    size_t used = 0;
+  };
+  static Stack& thread_stack() {
+    thread_local Stack stack;
+    return stack;
+  }
+  Stack& stack_;
+  std::string* result_ = nullptr;
+};
+
 I18N_API int i18n_get_meta_locale_copy(void* ptr, char* out_buf, int buf_size) {
   if (!ptr) return -1;
   auto* e = as_engine(ptr);
@@ -113,18 +243,82 @@ I18N_API int i18n_get_native_style(void* ptr, const char* token, const char** ar
   if (!ptr || !token || !out_style) return -1;
   auto* e = as_engine(ptr);
   if (!begin_engine_call(e)) return -1;
-  auto vec_args = build_vec_args(args, args_len);
-  const auto native = e->get_native_style(token, vec_args);
-  out_style->mass = native.mass;
-  out_style->friction = native.friction;
-  out_style->restitution = native.restitution;
-  out_style->drag = native.drag;
-  out_style->gravity_scale = native.gravity_scale;
-  out_style->spacing = native.spacing;
-  out_style->has_values = native.has_physical ? 1 : 0;
+  const ArgViews arg_views(args, args_len);
+  fill_native_style(e->get_native_style(token, arg_views), out_style);
   return 0;
 }
 
+I18N_API int i18n_get_native_style_n(void* ptr, const char* token, int token_len, const I18nArg* args, int args_len,
+                                     I18nNativeStyle* out_style) {
+  if (!ptr || !token || token_len < 0 || !out_style) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  const ArgViews arg_views(args, args_len);
+  fill_native_style(e->get_native_style(std::string_view(token, (size_t)token_len), arg_views), out_style);
+  return 0;
+}
+
+I18N_API int i18n_register_property(void* ptr, const char* name) {
+  if (!ptr || !name) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  return e->register_property(name);
+}
+
+I18N_API int i18n_find_property(void* ptr, const char* name) {
+  if (!ptr || !name) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  return e->find_property(name);
+}
+
+I18N_API int i18n_property_count(void* ptr) {
+  if (!ptr) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  return (int)e->property_count();
+}
+
+I18N_API int i18n_property_name_copy(void* ptr, int property_id, char* out_buf, int buf_size) {
+  if (!ptr || property_id < 0) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  if ((size_t)property_id >= e->property_count()) return -1;
+  return copy_to_buffer(e, e->property_name((I18nEngine::PropertyId)property_id), out_buf, buf_size);
+}
+
+I18N_API int i18n_get_native_property(void* ptr, const char* token, const char** args, int args_len,
+                                      int property_id, float* out_value) {
+  if (!ptr || !token || !out_value || property_id < 0) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  if ((size_t)property_id >= e->property_count()) return -1;
+  const ArgViews arg_views(args, args_len);
+  const auto native = e->get_native_style(token, arg_views);
+  float value = 0.0f;
+  const bool is_set = I18nEngine::read_physical_property(native, (I18nEngine::PropertyId)property_id, value);
+  *out_value = value;
+  return is_set ? 1 : 0;
+}
+
+I18N_API int i18n_get_native_properties(void* ptr, const char* token, const char** args, int args_len,
+                                        float* out_values, int values_len, uint32_t* out_set_mask) {
+  if (!ptr || !token) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  const ArgViews arg_views(args, args_len);
+  const auto native = e->get_native_style(token, arg_views);
+  const int count = (int)e->property_count();
+  if (out_values && values_len > 0) {
+    const int n = (values_len < count) ? values_len : count;
+    for (int i = 0; i < n; ++i) {
+      I18nEngine::read_physical_property(native, (I18nEngine::PropertyId)i, out_values[i]);
+    }
+  }
+  if (out_set_mask) *out_set_mask = native.set_mask;
+  return count;
+}
+
 I18N_API int i18n_load_txt(void* ptr, const char* txt_str, int strict) {
   if (!ptr || !txt_str) return -1;
   auto* e = as_engine(ptr);
@@ -146,6 +340,204 @@ I18N_API int i18n_reload(void* ptr) {
   return e->reload() ? 0 : -1;
 }
 
+I18N_API int i18n_add_locale_file(void* ptr, const char* name, const char* path, int strict) {
+  if (!ptr || !path) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  return e->add_locale_file(name ? name : "", path, strict != 0) ? 0 : -1;
+}
+
+I18N_API int i18n_add_locale_txt(void* ptr, const char* name, const char* txt_str, int strict) {
+  if (!ptr || !txt_str) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  return e->add_locale_txt(name ? name : "", txt_str, strict != 0) ? 0 : -1;
+}
+
+I18N_API int i18n_set_locale(void* ptr, const char* name) {
+  if (!ptr || !name) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  return e->set_locale(name) ? 0 : -1;
+}
+
+I18N_API int i18n_share_catalog(void* ptr, void* source) {
+  if (!ptr || !source) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  return e->share_catalog(*as_engine(source)) ? 0 : -1;
+}
+
+I18N_API int i18n_push_overlay_txt(void* ptr, const char* txt_str, int strict) {
+  if (!ptr || !txt_str) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  return e->push_overlay_txt(txt_str, strict != 0) ? 0 : -1;
+}
+
+I18N_API int i18n_push_overlay_file(void* ptr, const char* path, int strict) {
+  if (!ptr || !path) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  return e->push_overlay_file(path, strict != 0) ? 0 : -1;
+}
+
+I18N_API int i18n_pop_overlay(void* ptr) {
+  if (!ptr) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  return e->pop_overlay() ? 0 : -1;
+}
+
+I18N_API int i18n_overlay_depth(void* ptr) {
+  if (!ptr) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  return (int)e->overlay_depth();
+}
+
+I18N_API int i18n_memory_stats(void* ptr, I18nMemoryStats* out_stats) {
+  if (!ptr || !out_stats) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  const I18nEngine::MemoryStats stats = e->memory_stats();
+  *out_stats = I18nMemoryStats{};
+  if (stats.entries == 0) {
+    set_engine_error(e, "Kein Katalog geladen.");
+    return -1;
+  }
+  out_stats->entries = stats.entries;
+  out_stats->arena = stats.arena;
+  out_stats->table = stats.table;
+  out_stats->ref_index = stats.ref_index;
+  out_stats->entry_refs = stats.entry_refs;
+  out_stats->search = stats.search;
+  out_stats->style_registry = stats.style_registry;
+  out_stats->style_info = stats.style_info;
+  out_stats->templates = stats.templates;
+  out_stats->shared_base = stats.shared_base;
+  out_stats->total = stats.total;
+  return 0;
+}
+
+I18N_API int i18n_stats_json(void* ptr, char* out_buf, int buf_size) {
+  if (!ptr) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  return copy_to_buffer(e, e->stats_json(), out_buf, buf_size);
+}
+
+I18N_API int i18n_stats_prometheus(void* ptr, char* out_buf, int buf_size) {
+  if (!ptr) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  return copy_to_buffer(e, e->stats_prometheus(), out_buf, buf_size);
+}
+
+I18N_API int i18n_stats_reset(void* ptr) {
+  if (!ptr) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  e->reset_stats();
+  return 0;
+}
+
+I18N_API int i18n_set_trace(void* ptr, i18n_trace_fn on_span, void* user, uint64_t threshold_ns, double sample_rate) {
+  if (!ptr) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  if (!on_span) {
+    e->set_trace_hook(nullptr, 0, 0.0);
+    return 0;
+  }
+  e->set_trace_hook([on_span, user](const I18nEngine::TraceEvent& event) {
+    I18nTraceSpan span;
+    span.name = event.name;
+    span.token = event.token;
+    span.start_ns = event.start_ns;
+    span.duration_ns = event.duration_ns;
+    span.output_bytes = event.output_bytes;
+    span.generation = event.generation;
+    span.arg_count = event.arg_count;
+    span.depth = event.depth;
+    span.index = event.index;
+    span.parent = event.parent;
+    on_span(user, &span);
+  }, threshold_ns, sample_rate);
+  return 0;
+}
+
+I18N_API int i18n_get_locale_chain(void* ptr, char* out_buf, int buf_size) {
+  if (!ptr) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  return copy_to_buffer(e, join_lines(e->locale_chain()), out_buf, buf_size);
+}
+
+I18N_API int i18n_watch_start(void* ptr, const char* path, int strict, int debounce_ms,
+                              i18n_reload_fn on_reload, void* user) {
+  if (!ptr) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  return e->watch_start(path ? path : "", strict != 0, debounce_ms, on_reload, user) ? 0 : -1;
+}
+
+I18N_API int i18n_watch_stop(void* ptr) {
+  if (!ptr) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  e->watch_stop();
+  return 0;
+}
+
+I18N_API void* i18n_load_async(void* ptr, const char* path, int strict, i18n_reload_fn on_done, void* user) {
+  if (!ptr) return nullptr;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return nullptr;
+  if (!path) { set_engine_error(e, "path == nullptr"); return nullptr; }
+  return new LoadHandle{ e->load_async(path, strict != 0, on_done, user) };
+}
+
+I18N_API void* i18n_reload_async(void* ptr, i18n_reload_fn on_done, void* user) {
+  if (!ptr) return nullptr;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return nullptr;
+  return new LoadHandle{ e->reload_async(on_done, user) };
+}
+
+I18N_API int i18n_load_status(void* load) {
+  if (!load) return -1;
+  return (int)static_cast<LoadHandle*>(load)->ticket->state();
+}
+
+I18N_API int i18n_load_wait(void* load, int timeout_ms) {
+  if (!load) return -1;
+  return (int)static_cast<LoadHandle*>(load)->ticket->wait(timeout_ms);
+}
+
+I18N_API int i18n_load_error_copy(void* load, char* out_buf, int buf_size) {
+  if (!load) return -1;
+  const std::string s = static_cast<LoadHandle*>(load)->ticket->error();
+  const int len = (int)s.size();
+
+  if (out_buf && buf_size > 0) {
+    const int n = (len < (buf_size - 1)) ? len : (buf_size - 1);
+    if (n > 0) std::memcpy(out_buf, s.data(), (size_t)n);
+    out_buf[n] = '\0';
+  }
+  return len;
+}
+
+I18N_API int i18n_load_cancel(void* load) {
+  if (!load) return -1;
+  static_cast<LoadHandle*>(load)->ticket->cancel();
+  return 0;
+}
+
+I18N_API void i18n_load_free(void* load) {
+  delete static_cast<LoadHandle*>(load);
+}
+
 I18N_API uint32_t i18n_abi_version(void) {
   return ABI_VERSION;
 }
@@ -161,11 +553,13 @@ I18N_API int i18n_translate(void* ptr,
                             char* out_buf,
                             int buf_size) {
   if (!ptr || !token) return -1;
-  auto vec_args = build_vec_args(args, args_len);
+  const ArgViews arg_views(args, args_len);
   auto* e = as_engine(ptr);
   if (!begin_engine_call(e)) return -1;
-  const std::string res = e->translate(token, vec_args);
-  return copy_to_buffer(e, res, out_buf, buf_size);
+  CallResult res;
+  I18nEngine::ChunkWriter writer = I18nEngine::ChunkWriter::to_string(res.str());
+  e->translate_to(token, arg_views, writer);
+  return res.copy_to(e, out_buf, buf_size);
 }
 
 I18N_API int i18n_render_to_html(void* ptr,
@@ -175,13 +569,178 @@ I18N_API int i18n_render_to_html(void* ptr,
                                  char* out_buf,
                                  int buf_size) {
   if (!ptr || !token) return -1;
-  auto vec_args = build_vec_args(args, args_len);
+  const ArgViews arg_views(args, args_len);
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  CallResult res;
+  I18nEngine::ChunkWriter writer = I18nEngine::ChunkWriter::to_string(res.str());
+  e->render_to(token, arg_views, I18nEngine::RenderOptions{}, writer);
+  return res.copy_to(e, out_buf, buf_size);
+}
+
+I18N_API int i18n_render_to_html_ex(void* ptr,
+                                    const char* token,
+                                    const char** args,
+                                    int args_len,
+                                    int flags,
+                                    char* out_buf,
+                                    int buf_size) {
+  if (!ptr || !token) return -1;
+  const ArgViews arg_views(args, args_len);
   auto* e = as_engine(ptr);
   if (!begin_engine_call(e)) return -1;
-  const std::string res = e->render_to_html(token, vec_args);
+  I18nEngine::RenderOptions options;
+  options.minify = (flags & I18N_RENDER_MINIFY) != 0;
+  const std::string res = e->render_to_html(token, arg_views, options);
   return copy_to_buffer(e, res, out_buf, buf_size);
 }
 
+I18N_API int i18n_render_to_html_linked(void* ptr,
+                                        const char* token,
+                                        const char** args,
+                                        int args_len,
+                                        int flags,
+                                        const char* stylesheet_href,
+                                        char* out_buf,
+                                        int buf_size) {
+  if (!ptr || !token || !stylesheet_href || !*stylesheet_href) return -1;
+  const ArgViews arg_views(args, args_len);
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  I18nEngine::RenderOptions options;
+  options.minify = (flags & I18N_RENDER_MINIFY) != 0;
+  options.stylesheet_href = stylesheet_href;
+  const std::string res = e->render_to_html(token, arg_views, options);
+  return copy_to_buffer(e, res, out_buf, buf_size);
+}
+
+I18N_API int i18n_export_stylesheet(void* ptr,
+                                    const char* out_dir,
+                                    const char** templates,
+                                    int templates_len,
+                                    char* out_name,
+                                    int name_size) {
+  if (!ptr) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  auto tpl_tokens = build_vec_args(templates, templates_len);
+  std::string file_name;
+  if (!e->export_stylesheet(out_dir, tpl_tokens, file_name)) return -1;
+  return copy_to_buffer(e, file_name, out_name, name_size);
+}
+
+I18N_API int i18n_build_stylesheet(void* ptr,
+                                   const char** templates,
+                                   int templates_len,
+                                   char* out_buf,
+                                   int buf_size) {
+  if (!ptr) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  auto tpl_tokens = build_vec_args(templates, templates_len);
+  std::string css;
+  std::string file_name;
+  if (!e->build_stylesheet(tpl_tokens, css, file_name)) return -1;
+  return copy_to_buffer(e, css, out_buf, buf_size);
+}
+
+I18N_API void* i18n_render_batch(void* ptr, const I18nRenderJob* jobs, int job_count, int flags,
+                                 const char* stylesheet_href, int threads) {
+  if (!ptr || (!jobs && job_count > 0) || job_count < 0) return nullptr;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return nullptr;
+  std::vector<I18nEngine::RenderJob> native_jobs((size_t)job_count);
+  for (int i = 0; i < job_count; ++i) {
+    if (!jobs[i].token) {
+      set_engine_error(e, "Job ohne Token: " + std::to_string(i));
+      return nullptr;
+    }
+    native_jobs[(size_t)i].template_token = jobs[i].token;
+    native_jobs[(size_t)i].args = build_vec_args(jobs[i].args, jobs[i].args_len);
+  }
+  I18nEngine::RenderOptions options;
+  options.minify = (flags & I18N_RENDER_MINIFY) != 0;
+  if (stylesheet_href) options.stylesheet_href = stylesheet_href;
+  auto* batch = new RenderBatch();
+  batch->results = e->render_batch(native_jobs, options, threads > 0 ? (unsigned)threads : 0u);
+  return batch;
+}
+
+I18N_API int i18n_batch_count(void* batch) {
+  if (!batch) return -1;
+  return (int)static_cast<RenderBatch*>(batch)->results.size();
+}
+
+I18N_API const char* i18n_batch_result(void* batch, int index, int* out_len) {
+  if (!batch) return nullptr;
+  auto& results = static_cast<RenderBatch*>(batch)->results;
+  if (index < 0 || (size_t)index >= results.size()) return nullptr;
+  if (out_len) *out_len = (int)std::min<size_t>(results[(size_t)index].size(), (size_t)std::numeric_limits<int>::max());
+  return results[(size_t)index].c_str();
+}
+
+I18N_API void i18n_batch_free(void* batch) {
+  delete static_cast<RenderBatch*>(batch);
+}
+
+I18N_API int i18n_site_build(void* ptr, const char* out_dir, const I18nSitePage* pages, int page_count,
+                             int flags, const char* stylesheet_href, int force) {
+  if (!ptr || !out_dir || (!pages && page_count > 0) || page_count < 0) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  std::vector<I18nEngine::SitePage> site((size_t)page_count);
+  for (int i = 0; i < page_count; ++i) {
+    if (!pages[i].output_path || !*pages[i].output_path || !pages[i].token) {
+      set_engine_error(e, "Seite ohne Pfad oder Token: " + std::to_string(i));
+      return -1;
+    }
+    site[(size_t)i].output_path = pages[i].output_path;
+    site[(size_t)i].template_token = pages[i].token;
+    site[(size_t)i].args = build_vec_args(pages[i].args, pages[i].args_len);
+  }
+  I18nEngine::RenderOptions options;
+  options.minify = (flags & I18N_RENDER_MINIFY) != 0;
+  if (stylesheet_href) options.stylesheet_href = stylesheet_href;
+  I18nEngine::SiteBuildReport report;
+  if (!e->build_site(out_dir, site, options, force != 0, report)) return -1;
+  return (int)report.rendered;
+}
+
+I18N_API int i18n_site_written_copy(void* ptr, char* out_buf, int buf_size) {
+  if (!ptr) return -1;
+  auto* e = as_engine(ptr);
+  return copy_to_buffer(e, join_lines(e->get_last_site_report().written), out_buf, buf_size);
+}
+
+I18N_API void i18n_site_reset(void* ptr) {
+  if (!ptr) return;
+  as_engine(ptr)->reset_site();
+}
+
+I18N_API int i18n_get_references(void* ptr, const char* token, char* out_buf, int buf_size) {
+  if (!ptr || !token) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  std::vector<std::string> refs;
+  if (!e->get_references(token, refs)) {
+    set_engine_error(e, std::string("Token nicht gefunden: ") + token);
+    return -1;
+  }
+  return copy_to_buffer(e, join_lines(refs), out_buf, buf_size);
+}
+
+I18N_API int i18n_get_dependents(void* ptr, const char* token, int transitive, char* out_buf, int buf_size) {
+  if (!ptr || !token) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  std::vector<std::string> dependents;
+  if (!e->get_dependents(token, transitive != 0, dependents)) {
+    set_engine_error(e, std::string("Token nicht gefunden: ") + token);
+    return -1;
+  }
+  return copy_to_buffer(e, join_lines(dependents), out_buf, buf_size);
+}
+
 I18N_API int i18n_get_physics_json(void* ptr,
                                    const char* token,
                                    const char** args,
@@ -189,10 +748,28 @@ I18N_API int i18n_get_physics_json(void* ptr,
                                    char* out_buf,
                                    int buf_size) {
   if (!ptr || !token) return -1;
-  auto vec_args = build_vec_args(args, args_len);
+  const ArgViews arg_views(args, args_len);
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  const std::string res = e->get_physics_json_for_template(token, arg_views);
+  return copy_to_buffer(e, res, out_buf, buf_size);
+}
+
+I18N_API int i18n_get_physics(void* ptr,
+                              const char* token,
+                              const char** args,
+                              int args_len,
+                              int format,
+                              char* out_buf,
+                              int buf_size) {
+  if (!ptr || !token) return -1;
+  if (format != I18N_PHYSICS_JSON && format != I18N_PHYSICS_MSGPACK) return -1;
+  const ArgViews arg_views(args, args_len);
   auto* e = as_engine(ptr);
   if (!begin_engine_call(e)) return -1;
-  const std::string res = e->get_physics_json_for_template(token, vec_args);
+  const auto fmt = (format == I18N_PHYSICS_MSGPACK) ? I18nEngine::PhysicsFormat::MessagePack
+                                                     : I18nEngine::PhysicsFormat::Json;
+  const std::string res = e->get_physics_for_template(token, arg_views, fmt);
   return copy_to_buffer(e, res, out_buf, buf_size);
 }
 
@@ -204,13 +781,66 @@ I18N_API int i18n_translate_plural(void* ptr,
                                    char* out_buf,
                                    int buf_size) {
   if (!ptr || !token) return -1;
-  auto vec_args = build_vec_args(args, args_len);
+  const ArgViews arg_views(args, args_len);
   auto* e = as_engine(ptr);
   if (!begin_engine_call(e)) return -1;
-  const std::string res = e->translate_plural(token, count, vec_args);
+  const std::string res = e->translate_plural(token, count, arg_views);
   return copy_to_buffer(e, res, out_buf, buf_size);
 }
 
+I18N_API int i18n_translate_n(void* ptr,
+                              const char* token,
+                              int token_len,
+                              const I18nArg* args,
+                              int args_len,
+                              char* out_buf,
+                              int buf_size) {
+  if (!ptr || !token || token_len < 0) return -1;
+  const ArgViews arg_views(args, args_len);
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  CallResult res;
+  I18nEngine::ChunkWriter writer = I18nEngine::ChunkWriter::to_string(res.str());
+  e->translate_to(std::string_view(token, (size_t)token_len), arg_views, writer);
+  return res.copy_to(e, out_buf, buf_size);
+}
+
+I18N_API int i18n_translate_plural_n(void* ptr,
+                                     const char* token,
+                                     int token_len,
+                                     int count,
+                                     const I18nArg* args,
+                                     int args_len,
+                                     char* out_buf,
+                                     int buf_size) {
+  if (!ptr || !token || token_len < 0) return -1;
+  const ArgViews arg_views(args, args_len);
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  const std::string res = e->translate_plural(std::string_view(token, (size_t)token_len), count, arg_views);
+  return copy_to_buffer(e, res, out_buf, buf_size);
+}
+
+I18N_API int i18n_render_to_html_n(void* ptr,
+                                   const char* token,
+                                   int token_len,
+                                   const I18nArg* args,
+                                   int args_len,
+                                   int flags,
+                                   char* out_buf,
+                                   int buf_size) {
+  if (!ptr || !token || token_len < 0) return -1;
+  const ArgViews arg_views(args, args_len);
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  I18nEngine::RenderOptions options;
+  options.minify = (flags & I18N_RENDER_MINIFY) != 0;
+  CallResult res;
+  I18nEngine::ChunkWriter writer = I18nEngine::ChunkWriter::to_string(res.str());
+  e->render_to(std::string_view(token, (size_t)token_len), arg_views, options, writer);
+  return res.copy_to(e, out_buf, buf_size);
+}
+
 I18N_API int i18n_print(void* ptr, char* out_buf, int buf_size) {
   if (!ptr) return -1;
   auto* e = as_engine(ptr);
@@ -219,6 +849,32 @@ I18N_API int i18n_print(void* ptr, char* out_buf, int buf_size) {
   return copy_to_buffer(e, res, out_buf, buf_size);
 }
 
+I18N_API void* i18n_iter_begin(void* ptr, const char* prefix) {
+  if (!ptr) return nullptr;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return nullptr;
+  return new I18nEngine::EntryCursor(e->iterate_entries(prefix ? prefix : ""));
+}
+
+I18N_API int i18n_iter_next(void* iter, I18nEntryView* out_entry) {
+  if (!iter || !out_entry) return -1;
+  I18nEngine::EntryView entry;
+  if (!static_cast<I18nEngine::EntryCursor*>(iter)->next(entry)) return 0;
+  // Views zeigen in die Arena des Snapshots, wo Token, Text und Label ohne Trenner aufeinander folgen:
+  // nicht NUL-terminiert, nur die Längen gelten. Fehlendes Label wird "".
+  out_entry->token = entry.token.data();
+  out_entry->token_len = (int)entry.token.size();
+  out_entry->label = entry.label.empty() ? "" : entry.label.data();
+  out_entry->label_len = (int)entry.label.size();
+  out_entry->text = entry.text.data();
+  out_entry->text_len = (int)entry.text.size();
+  return 1;
+}
+
+I18N_API void i18n_iter_end(void* iter) {
+  delete static_cast<I18nEngine::EntryCursor*>(iter);
+}
+
 I18N_API int i18n_find(void* ptr, const char* query, char* out_buf, int buf_size) {
   if (!ptr || !query) return -1;
   auto* e = as_engine(ptr);
@@ -227,6 +883,121 @@ I18N_API int i18n_find(void* ptr, const char* query, char* out_buf, int buf_size
   return copy_to_buffer(e, res, out_buf, buf_size);
 }
 
+I18N_API void* i18n_find_page(void* ptr, const char* query, int offset, int limit) {
+  if (!ptr || !query || offset < 0) return nullptr;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return nullptr;
+  auto* page = new SearchPage();
+  page->total = e->find_page(query, (size_t)offset, limit > 0 ? (size_t)limit : 0, page->hits);
+  return page;
+}
+
+I18N_API int i18n_find_page_total(void* page) {
+  if (!page) return -1;
+  return (int)std::min<size_t>(static_cast<SearchPage*>(page)->total, (size_t)std::numeric_limits<int>::max());
+}
+
+I18N_API int i18n_find_page_count(void* page) {
+  if (!page) return -1;
+  return (int)static_cast<SearchPage*>(page)->hits.size();
+}
+
+I18N_API int i18n_find_page_hit(void* page, int index, I18nSearchHit* out_hit) {
+  if (!page || !out_hit) return -1;
+  const auto& hits = static_cast<SearchPage*>(page)->hits;
+  if (index < 0 || (size_t)index >= hits.size()) return -1;
+  const auto& hit = hits[(size_t)index];
+  out_hit->token = hit.token.c_str();
+  out_hit->token_len = (int)hit.token.size();
+  out_hit->label = hit.label.c_str();
+  out_hit->label_len = (int)hit.label.size();
+  out_hit->text = hit.text.c_str();
+  out_hit->text_len = (int)hit.text.size();
+  return 0;
+}
+
+I18N_API void i18n_find_page_free(void* page) {
+  delete static_cast<SearchPage*>(page);
+}
+
+I18N_API int i18n_translate_to_sink(void* ptr, const char* token, const char** args, int args_len,
+                                    i18n_sink_fn sink, void* user) {
+  if (!ptr || !token || !sink) return -1;
+  const ArgViews arg_views(args, args_len);
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  SinkTarget target{ sink, user };
+  auto writer = I18nEngine::ChunkWriter::to_callback(forward_to_sink, &target);
+  return finish_stream(e, e->translate_to(token, arg_views, writer), true);
+}
+
+I18N_API int i18n_render_to_sink(void* ptr, const char* token, const char** args, int args_len,
+                                 int flags, i18n_sink_fn sink, void* user) {
+  if (!ptr || !token || !sink) return -1;
+  const ArgViews arg_views(args, args_len);
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  I18nEngine::RenderOptions options;
+  options.minify = (flags & I18N_RENDER_MINIFY) != 0;
+  SinkTarget target{ sink, user };
+  auto writer = I18nEngine::ChunkWriter::to_callback(forward_to_sink, &target);
+  return finish_stream(e, e->render_to(token, arg_views, options, writer), true);
+}
+
+I18N_API int i18n_print_to_sink(void* ptr, i18n_sink_fn sink, void* user) {
+  if (!ptr || !sink) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  SinkTarget target{ sink, user };
+  auto writer = I18nEngine::ChunkWriter::to_callback(forward_to_sink, &target);
+  return finish_stream(e, e->dump_table_to(writer), true);
+}
+
+I18N_API int i18n_find_to_sink(void* ptr, const char* query, i18n_sink_fn sink, void* user) {
+  if (!ptr || !query || !sink) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  SinkTarget target{ sink, user };
+  auto writer = I18nEngine::ChunkWriter::to_callback(forward_to_sink, &target);
+  return finish_stream(e, e->find_any_to(query, writer), true);
+}
+
+I18N_API int i18n_translate_to_fd(void* ptr, const char* token, const char** args, int args_len, int fd) {
+  if (!ptr || !token || fd < 0) return -1;
+  const ArgViews arg_views(args, args_len);
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  auto writer = I18nEngine::ChunkWriter::to_fd(fd);
+  return finish_stream(e, e->translate_to(token, arg_views, writer), false);
+}
+
+I18N_API int i18n_render_to_fd(void* ptr, const char* token, const char** args, int args_len, int flags, int fd) {
+  if (!ptr || !token || fd < 0) return -1;
+  const ArgViews arg_views(args, args_len);
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  I18nEngine::RenderOptions options;
+  options.minify = (flags & I18N_RENDER_MINIFY) != 0;
+  auto writer = I18nEngine::ChunkWriter::to_fd(fd);
+  return finish_stream(e, e->render_to(token, arg_views, options, writer), false);
+}
+
+I18N_API int i18n_print_to_fd(void* ptr, int fd) {
+  if (!ptr || fd < 0) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  auto writer = I18nEngine::ChunkWriter::to_fd(fd);
+  return finish_stream(e, e->dump_table_to(writer), false);
+}
+
+I18N_API int i18n_find_to_fd(void* ptr, const char* query, int fd) {
+  if (!ptr || !query || fd < 0) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  auto writer = I18nEngine::ChunkWriter::to_fd(fd);
+  return finish_stream(e, e->find_any_to(query, writer), false);
+}
+
 I18N_API int i18n_check(void* ptr, char* report_buf, int report_size) {
   if (!ptr) return -1;
   auto* e = as_engine(ptr);
@@ -237,6 +1008,59 @@ I18N_API int i18n_check(void* ptr, char* report_buf, int report_size) {
   return code;
 }
 
+I18N_API int i18n_check_to_sink(void* ptr, int format, i18n_sink_fn sink, void* user) {
+  if (!ptr || !sink) return -1;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return -1;
+  if (format != I18N_REPORT_TEXT && format != I18N_REPORT_JSON) {
+    set_engine_error(e, "Unbekanntes Report-Format.");
+    return -1;
+  }
+  const auto result = e->check_catalog();
+  SinkTarget target{ sink, user };
+  auto writer = I18nEngine::ChunkWriter::to_callback(forward_to_sink, &target);
+  const bool ok = I18nEngine::write_check_report(result, (I18nEngine::ReportFormat)format, writer);
+  if (finish_stream(e, ok, true) != 0) return -1;
+  return result.code;
+}
+
+I18N_API void* i18n_check_run(void* ptr) {
+  if (!ptr) return nullptr;
+  auto* e = as_engine(ptr);
+  if (!begin_engine_call(e)) return nullptr;
+  auto* run = new CheckRun();
+  run->result = e->check_catalog();
+  return run;
+}
+
+I18N_API int i18n_check_code(void* check) {
+  if (!check) return -1;
+  return static_cast<CheckRun*>(check)->result.code;
+}
+
+I18N_API int i18n_check_issue_count(void* check) {
+  if (!check) return -1;
+  return (int)static_cast<CheckRun*>(check)->result.issues.size();
+}
+
+I18N_API int i18n_check_issue(void* check, int index, I18nCheckIssue* out_issue) {
+  if (!check || !out_issue) return -1;
+  const auto& issues = static_cast<CheckRun*>(check)->result.issues;
+  if (index < 0 || (size_t)index >= issues.size()) return -1;
+  const auto& issue = issues[(size_t)index];
+  out_issue->kind = (int)issue.kind;
+  out_issue->is_error = issue.is_error ? 1 : 0;
+  out_issue->token = issue.token.c_str();
+  out_issue->token_len = (int)issue.token.size();
+  out_issue->detail = issue.detail.c_str();
+  out_issue->detail_len = (int)issue.detail.size();
+  return 0;
+}
+
+I18N_API void i18n_check_free(void* check) {
+  delete static_cast<CheckRun*>(check);
+}
+
 I18N_API int i18n_export_binary(void* ptr, const char* path) {
   if (!ptr || !path) return -1;
   auto* e = as_engine(ptr);
@@ -19,7 +19,8 @@ extern "C" {
 I18N_API void* i18n_new(void);
 I18N_API void  i18n_free(void* ptr);
 
-// Pointer bleibt bis zum nächsten API-Aufruf auf derselben Engine-Instanz gültig (Engine ist nicht threadsafe). Nutzen Sie vorzugsweise die Copy-Variante.
+// Fehler des letzten Aufrufs dieses Threads auf dieser Engine (pro Thread gespeichert, Watcher-Reloads überschreiben ihn nicht).
+// Pointer bleibt bis zum nächsten API-Aufruf des Threads auf derselben Engine-Instanz gültig. Nutzen Sie vorzugsweise die Copy-Variante.
 I18N_API const char* i18n_last_error(void* ptr);
 
 // Sichere Copy-Variante: returns required bytes (ohne NUL), terminates wenn buf_size>0
@@ -28,6 +29,95 @@ I18N_API int i18n_last_error_copy(void* ptr, char* out_buf, int buf_size);
 I18N_API int i18n_load_txt(void* ptr, const char* txt_str, int strict);
 I18N_API int i18n_load_txt_file(void* ptr, const char* path, int strict);
 I18N_API int i18n_reload(void* ptr);
+// Mehrere Locales: name NULL/leer übernimmt @meta locale. Die Fallback-Kette (@meta fallback) wird beim
+// Laden zusammengeführt; ein Fehltreffer kostet eine Abfrage statt einer pro Locale.
+// i18n_set_locale wechselt atomar ("en_US" findet auch "en"); i18n_load_txt*, i18n_load_async
+// und Watcher-Reloads verlassen den Locale-Modus.
+I18N_API int i18n_add_locale_file(void* ptr, const char* name, const char* path, int strict);
+I18N_API int i18n_add_locale_txt(void* ptr, const char* name, const char* txt_str, int strict);
+I18N_API int i18n_set_locale(void* ptr, const char* name);
+// Mandanten-Overlays: i18n_share_catalog übernimmt den aktiven Katalog von source ohne Kopie;
+// i18n_push_overlay_* legt eine Override-Ebene darüber (gleiche Tokens überschreiben, neue ergänzen),
+// i18n_pop_overlay entfernt die oberste. Speicher: eine Basis plus kleine Deltas je Mandant.
+I18N_API int i18n_share_catalog(void* ptr, void* source);
+I18N_API int i18n_push_overlay_txt(void* ptr, const char* txt_str, int strict);
+I18N_API int i18n_push_overlay_file(void* ptr, const char* path, int strict);
+I18N_API int i18n_pop_overlay(void* ptr);
+I18N_API int i18n_overlay_depth(void* ptr);
+
+// Speicherbedarf des aktiven Katalogs in Bytes je Bestandteil. Bei Overlays zählen die Felder nur die
+// eigene Ebene, geteilte Basis-Ebenen stehen in shared_base. Rückgabe: 0, -1 ohne Katalog.
+typedef struct I18nMemoryStats {
+  uint64_t entries;
+  uint64_t arena;          // Token, Text und Label
+  uint64_t table;          // Hash-Tabelle des Katalogs
+  uint64_t ref_index;
+  uint64_t entry_refs;
+  uint64_t search;         // 0, bis zum ersten i18n_find
+  uint64_t style_registry;
+  uint64_t style_info;
+  uint64_t templates;
+  uint64_t shared_base;
+  uint64_t total;          // Summe ohne shared_base
+} I18nMemoryStats;
+I18N_API int i18n_memory_stats(void* ptr, I18nMemoryStats* out_stats);
+// Laufzeitstatistik seit i18n_new bzw. i18n_stats_reset: Aufrufe und Latenz-Histogramme je API (translate,
+// translate_plural, render_to_html, get_native_style, load, reload), Zähler für Template-Cache-Treffer,
+// ⟦MISSING⟧, ⟦CYCLE⟧, ⟦RECURSION_LIMIT⟧ und RESULT_TOO_LARGE sowie die Ladezeit je Phase
+// (read, parse, style_registry, index, install). Als JSON oder im Prometheus-Textformat.
+I18N_API int i18n_stats_json(void* ptr, char* out_buf, int buf_size);
+I18N_API int i18n_stats_prometheus(void* ptr, char* out_buf, int buf_size);
+I18N_API int i18n_stats_reset(void* ptr);
+// Trace-Hook für langsame Aufrufe. Von den öffentlichen Lookups (translate, translate_plural,
+// render_to_html, get_native_style) wird der Anteil sample_rate (0..1) gemessen; dauert ein gemessener
+// Aufruf mindestens threshold_ns, ruft on_span im aufrufenden Thread einmal je Span: zuerst die Wurzel
+// (parent -1), dann die inneren Stufen translate_impl und build_style_definitions in Startreihenfolge
+// (höchstens 1024). start_ns stammt von CLOCK_MONOTONIC. on_span NULL entfernt den Hook; ein bereits
+// laufender Aufruf kann danach noch melden. Ohne Hook kostet die Messung praktisch nichts.
+typedef struct I18nTraceSpan {
+  const char* name;
+  const char* token;       // nur während des Callbacks gültig, leer bei build_style_definitions
+  uint64_t start_ns;
+  uint64_t duration_ns;
+  uint64_t output_bytes;   // 0 bei get_native_style
+  uint64_t generation;     // Snapshot-Generation, steigt mit jedem Laden
+  int32_t arg_count;
+  int32_t depth;           // tiefste erreichte Rekursionstiefe
+  int32_t index;
+  int32_t parent;
+} I18nTraceSpan;
+typedef void (*i18n_trace_fn)(void* user, const I18nTraceSpan* span);
+I18N_API int i18n_set_trace(void* ptr, i18n_trace_fn on_span, void* user, uint64_t threshold_ns, double sample_rate);
+// Aktive Kette, eine Locale pro Zeile (z. B. "de_DE\nen\n"); leer ohne i18n_set_locale.
+I18N_API int i18n_get_locale_chain(void* ptr, char* out_buf, int buf_size);
+// Hot-Reload im Hintergrund: überwacht path (NULL: zuletzt per i18n_load_txt_file geladene Datei) per
+// inotify samt Verzeichnis, fasst Schreibschübe über debounce_ms zusammen und lädt nur bei geändertem
+// Inhalt neu. Der neue Snapshot wird atomar aktiv; laufende Aufrufe sehen weiter den alten.
+// on_reload (optional) läuft im Watcher-Thread: status 0 = neu geladen, -1 = Fehler (error gesetzt),
+// 1 = abgebrochen bzw. durch einen neueren Ladeauftrag ersetzt (der aktive Snapshot bleibt).
+// on_reload darf i18n_watch_stop aufrufen (der Thread endet danach), aber nicht i18n_free.
+typedef void (*i18n_reload_fn)(void* user, int status, const char* error);
+I18N_API int i18n_watch_start(void* ptr, const char* path, int strict, int debounce_ms,
+                              i18n_reload_fn on_reload, void* user);
+I18N_API int i18n_watch_stop(void* ptr);
+
+// Asynchrones Laden im Worker-Thread der Engine; bis zum atomaren Tausch bedient der alte Snapshot.
+// Ein neuerer Ladeauftrag (auch i18n_load_txt*) bricht ältere ab. on_done (optional) läuft im Worker,
+// bevor der Status pollbar wird. Handle mit i18n_load_free freigeben (bricht den Auftrag nicht ab).
+#define I18N_LOAD_PENDING   0
+#define I18N_LOAD_DONE      1
+#define I18N_LOAD_FAILED    2
+#define I18N_LOAD_CANCELLED 3
+I18N_API void* i18n_load_async(void* ptr, const char* path, int strict, i18n_reload_fn on_done, void* user);
+// Wie i18n_reload: zuletzt geladene Datei mit ihrem Strict-Mode.
+I18N_API void* i18n_reload_async(void* ptr, i18n_reload_fn on_done, void* user);
+I18N_API int i18n_load_status(void* load);
+// Wartet höchstens timeout_ms (< 0: unbegrenzt) und liefert den Status danach.
+I18N_API int i18n_load_wait(void* load, int timeout_ms);
+// Fehlertext bei FAILED/CANCELLED; Semantik wie i18n_last_error_copy.
+I18N_API int i18n_load_error_copy(void* load, char* out_buf, int buf_size);
+I18N_API int i18n_load_cancel(void* load);
+I18N_API void i18n_load_free(void* load);
 I18N_API uint32_t i18n_abi_version(void);
 I18N_API uint32_t i18n_binary_version_supported_max(void);
 
@@ -44,12 +134,60 @@ I18N_API int i18n_render_to_html(void* ptr,
                                  int args_len,
                                  char* out_buf,
                                  int buf_size);
+enum I18nRenderFlags {
+  I18N_RENDER_DEFAULT = 0,
+  I18N_RENDER_MINIFY = 1   // Whitespace-Folgen im HTML auf ein Leerzeichen reduzieren
+};
+I18N_API int i18n_render_to_html_ex(void* ptr,
+                                    const char* token,
+                                    const char** args,
+                                    int args_len,
+                                    int flags,
+                                    char* out_buf,
+                                    int buf_size);
+// Rendert wie i18n_render_to_html_ex, setzt aber einen <link> auf das exportierte Stylesheet.
+// Inline bleiben Styles, deren Definition von Args abhängt, und solche, die erst über Args ins HTML kommen.
+I18N_API int i18n_render_to_html_linked(void* ptr,
+                                        const char* token,
+                                        const char** args,
+                                        int args_len,
+                                        int flags,
+                                        const char* stylesheet_href,
+                                        char* out_buf,
+                                        int buf_size);
+// Schreibt alle arg-freien style_-Definitionen (oder nur die der übergebenen Templates) nach
+// out_dir/mycelia.<hash>.css. out_dir == NULL berechnet nur den Namen. Rückgabe: Länge des Dateinamens oder -1.
+I18N_API int i18n_export_stylesheet(void* ptr,
+                                    const char* out_dir,
+                                    const char** templates,
+                                    int templates_len,
+                                    char* out_name,
+                                    int name_size);
+// Liefert den Stylesheet-Inhalt statt ihn zu schreiben. Rückgabe: Länge oder -1.
+I18N_API int i18n_build_stylesheet(void* ptr,
+                                   const char** templates,
+                                   int templates_len,
+                                   char* out_buf,
+                                   int buf_size);
 I18N_API int i18n_get_physics_json(void* ptr,
                                    const char* token,
                                    const char** args,
                                    int args_len,
                                    char* out_buf,
                                    int buf_size);
+enum I18nPhysicsFormat {
+  I18N_PHYSICS_JSON = 0,    // {"style_x":{"mass":2,"friction":0.5,...}}, kürzeste Float-Darstellung
+  I18N_PHYSICS_MSGPACK = 1  // MessagePack {token: {Kanal-ID: float32}}, Namen via i18n_property_name_copy
+};
+// Wie i18n_get_physics_json, aber im gewählten Format. Binärausgabe kann NUL-Bytes enthalten:
+// maßgeblich ist die zurückgegebene Länge.
+I18N_API int i18n_get_physics(void* ptr,
+                              const char* token,
+                              const char** args,
+                              int args_len,
+                              int format,
+                              char* out_buf,
+                              int buf_size);
 // Count steuert, ob {one}, {other} oder {zero} genutzt wird. Rückgabe: Länge oder -1 bei Fehler.
 I18N_API int i18n_translate_plural(void* ptr,
                                    const char* token,
@@ -58,11 +196,143 @@ I18N_API int i18n_translate_plural(void* ptr,
                                    int args_len,
                                    char* out_buf,
                                    int buf_size);
+// Token und Args als (Zeiger, Länge): ohne NUL-Terminierung, NUL-Bytes sind erlaubt. Die Engine liest
+// die Bytes direkt, ohne sie pro Aufruf zu kopieren. Rückgabe wie bei den Varianten ohne _n.
+typedef struct I18nArg {
+  const char* data;
+  int len;
+} I18nArg;
+I18N_API int i18n_translate_n(void* ptr,
+                              const char* token,
+                              int token_len,
+                              const I18nArg* args,
+                              int args_len,
+                              char* out_buf,
+                              int buf_size);
+I18N_API int i18n_translate_plural_n(void* ptr,
+                                     const char* token,
+                                     int token_len,
+                                     int count,
+                                     const I18nArg* args,
+                                     int args_len,
+                                     char* out_buf,
+                                     int buf_size);
+I18N_API int i18n_render_to_html_n(void* ptr,
+                                   const char* token,
+                                   int token_len,
+                                   const I18nArg* args,
+                                   int args_len,
+                                   int flags,
+                                   char* out_buf,
+                                   int buf_size);
+// Batch-Rendering für Site-Generatoren: alle Jobs laufen parallel gegen denselben Snapshot.
+typedef struct I18nRenderJob {
+  const char* token;
+  const char** args;
+  int args_len;
+} I18nRenderJob;
+// stylesheet_href != NULL rendert wie i18n_render_to_html_linked. threads <= 0: alle Kerne. Rückgabe: Batch-Handle (mit i18n_batch_free freigeben) oder NULL.
+I18N_API void* i18n_render_batch(void* ptr, const I18nRenderJob* jobs, int job_count, int flags,
+                                 const char* stylesheet_href, int threads);
+I18N_API int i18n_batch_count(void* batch);
+// Zeiger auf das Ergebnis von Job index (NUL-terminiert, gültig bis i18n_batch_free), Länge in out_len.
+I18N_API const char* i18n_batch_result(void* batch, int index, int* out_len);
+I18N_API void i18n_batch_free(void* batch);
+
+// Inkrementeller Site-Build: schreibt jede Seite nach out_dir/output_path, rendert aber nur Seiten,
+// deren Definition oder Token-Abhängigkeiten sich seit dem letzten Aufruf geändert haben.
+typedef struct I18nSitePage {
+  const char* output_path;
+  const char* token;
+  const char** args;
+  int args_len;
+} I18nSitePage;
+// force != 0 rendert alles neu. Rückgabe: Anzahl neu gerenderter Seiten oder -1.
+I18N_API int i18n_site_build(void* ptr, const char* out_dir, const I18nSitePage* pages, int page_count,
+                             int flags, const char* stylesheet_href, int force);
+// Beim letzten Build geschriebene Pfade, je Zeile einer. Rückgabe wie copy-Funktionen.
+I18N_API int i18n_site_written_copy(void* ptr, char* out_buf, int buf_size);
+I18N_API void i18n_site_reset(void* ptr);
+
+// Referenzgraph des aktiven Snapshots. Ausgabe: Tokens sortiert, je Zeile einer; -1 wenn token fehlt.
+I18N_API int i18n_get_references(void* ptr, const char* token, char* out_buf, int buf_size);
+// Wer verweist (direkt oder mit transitive != 0 über Zwischenstufen) auf token?
+I18N_API int i18n_get_dependents(void* ptr, const char* token, int transitive, char* out_buf, int buf_size);
 I18N_API int i18n_export_binary(void* ptr, const char* path);
 
 I18N_API int i18n_print(void* ptr, char* out_buf, int buf_size);
+// Cursor über alle Einträge in Token-Reihenfolge, ohne Kopien: die Views zeigen in den beim Begin
+// festgehaltenen Snapshot und bleiben bis i18n_iter_end gültig, auch über Reloads hinweg.
+// Die Views sind NICHT NUL-terminiert (Token, Text und Label liegen direkt hintereinander):
+// Konsumenten müssen die _len-Felder verwenden, nie strlen oder %s.
+typedef struct I18nEntryView {
+  const char* token;
+  int token_len;
+  const char* label; // "" wenn kein Label
+  int label_len;
+  const char* text;
+  int text_len;
+} I18nEntryView;
+// prefix NULL oder "": alle Einträge. Rückgabe: Cursor-Handle oder NULL.
+I18N_API void* i18n_iter_begin(void* ptr, const char* prefix);
+// 1 = Eintrag in out_entry, 0 = Ende, -1 bei ungültigen Argumenten.
+I18N_API int i18n_iter_next(void* iter, I18nEntryView* out_entry);
+I18N_API void i18n_iter_end(void* iter);
 I18N_API int i18n_find(void* ptr, const char* query, char* out_buf, int buf_size);
+// Seitenweise Suche mit strukturierten Treffern (Token-Reihenfolge). limit <= 0 liefert alle ab offset.
+// Rückgabe: Handle (mit i18n_find_page_free freigeben) oder NULL; Zeiger in I18nSearchHit gelten bis dahin.
+typedef struct I18nSearchHit {
+  const char* token;
+  int token_len;
+  const char* label;
+  int label_len;
+  const char* text;
+  int text_len;
+} I18nSearchHit;
+I18N_API void* i18n_find_page(void* ptr, const char* query, int offset, int limit);
+// Trefferzahl über alle Seiten.
+I18N_API int i18n_find_page_total(void* page);
+I18N_API int i18n_find_page_count(void* page);
+I18N_API int i18n_find_page_hit(void* page, int index, I18nSearchHit* out_hit);
+I18N_API void i18n_find_page_free(void* page);
 I18N_API int i18n_check(void* ptr, char* report_buf, int report_size);
+
+// Streaming ohne Größenlimit: Ausgabe geht in Blöcken (bis 64 KiB) an einen Sink oder File-Descriptor.
+// Der Sink gibt 0 zurück, um fortzufahren; jeder andere Wert bricht ab (last_error "SINK_ABORTED").
+// Rückgabe: 0 bei Erfolg, -1 bei Fehler oder Abbruch. Bereits gelieferte Blöcke bleiben beim Aufrufer.
+typedef int (*i18n_sink_fn)(void* user, const char* data, int len);
+I18N_API int i18n_translate_to_sink(void* ptr, const char* token, const char** args, int args_len,
+                                    i18n_sink_fn sink, void* user);
+I18N_API int i18n_render_to_sink(void* ptr, const char* token, const char** args, int args_len,
+                                 int flags, i18n_sink_fn sink, void* user);
+I18N_API int i18n_print_to_sink(void* ptr, i18n_sink_fn sink, void* user);
+I18N_API int i18n_find_to_sink(void* ptr, const char* query, i18n_sink_fn sink, void* user);
+// fd-Varianten schreiben per writev (Windows: _write); Teil-Schreibvorgänge und EINTR werden wiederholt.
+I18N_API int i18n_translate_to_fd(void* ptr, const char* token, const char** args, int args_len, int fd);
+I18N_API int i18n_render_to_fd(void* ptr, const char* token, const char** args, int args_len, int flags, int fd);
+I18N_API int i18n_print_to_fd(void* ptr, int fd);
+I18N_API int i18n_find_to_fd(void* ptr, const char* query, int fd);
+
+// Strukturierter Katalog-Check. Rückgabecodes wie i18n_check (0 OK, 2 leer, 3 Fehler).
+enum { I18N_REPORT_TEXT = 0, I18N_REPORT_JSON = 1 };
+enum { I18N_CHECK_PLACEHOLDER_GAP = 0, I18N_CHECK_MISSING_REF = 1, I18N_CHECK_CYCLE = 2 };
+typedef struct I18nCheckIssue {
+  int kind;     // I18N_CHECK_*
+  int is_error; // 0 = Warnung
+  const char* token;
+  int token_len;
+  const char* detail; // Platzhalterliste, fehlender Token bzw. Zykluspfad
+  int detail_len;
+} I18nCheckIssue;
+// Vollständiger Report (ohne Größenlimit) im gewählten Format an den Sink; -1 bei Abbruch.
+I18N_API int i18n_check_to_sink(void* ptr, int format, i18n_sink_fn sink, void* user);
+// Record-API: Handle mit i18n_check_free freigeben; Zeiger in I18nCheckIssue gelten bis dahin.
+I18N_API void* i18n_check_run(void* ptr);
+I18N_API int i18n_check_code(void* check);
+I18N_API int i18n_check_issue_count(void* check);
+I18N_API int i18n_check_issue(void* check, int index, I18nCheckIssue* out_issue);
+I18N_API void i18n_check_free(void* check);
+
 I18N_API int i18n_get_meta_locale_copy(void* ptr, char* out_buf, int buf_size);
 I18N_API int i18n_get_meta_fallback_copy(void* ptr, char* out_buf, int buf_size);
 I18N_API int i18n_get_meta_note_copy(void* ptr, char* out_buf, int buf_size);
@@ -82,6 +352,21 @@ struct I18nNativeStyle {
 };
 
 I18N_API int i18n_get_native_style(void* ptr, const char* token, const char** args, int args_len, I18nNativeStyle* out_style);
+I18N_API int i18n_get_native_style_n(void* ptr, const char* token, int token_len, const I18nArg* args, int args_len,
+                                     I18nNativeStyle* out_style);
+
+// Physikalische Kanäle: IDs 0..5 sind Built-ins (mass, friction, restitution, drag, gravity-scale, spacing),
+// eigene Kanäle (z. B. "--buoyancy") erhalten ab 6 fortlaufende IDs. Rückgabe: Kanal-ID oder -1.
+I18N_API int i18n_register_property(void* ptr, const char* name);
+I18N_API int i18n_find_property(void* ptr, const char* name);
+I18N_API int i18n_property_count(void* ptr);
+I18N_API int i18n_property_name_copy(void* ptr, int property_id, char* out_buf, int buf_size);
+// Rückgabe: 1 wenn der Kanal im Style gesetzt ist, 0 wenn nicht (out_value = Default), -1 bei Fehler.
+I18N_API int i18n_get_native_property(void* ptr, const char* token, const char** args, int args_len,
+                                      int property_id, float* out_value);
+// Schreibt alle Kanäle nach ID in out_values (max. values_len). Rückgabe: Anzahl registrierter Kanäle oder -1.
+I18N_API int i18n_get_native_properties(void* ptr, const char* token, const char** args, int args_len,
+                                        float* out_values, int values_len, uint32_t* out_set_mask);
 
 #ifdef __cplusplus
 }
@@ -10,13 +10,26 @@
 #include <limits>
 #include <cerrno>
 #include <cstdlib>
+#include <charconv>
+#include <thread>
+#include <system_error>
+#include <chrono>
+#include <cmath>
+#include <string_view>
+#include <utility>
 #ifdef _WIN32
 #include <windows.h>
+#include <io.h>
 #else
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
+#include <poll.h>
+#endif
+#ifdef __linux__
+#include <sys/inotify.h>
 #endif
 
 namespace {
@@ -28,6 +41,8 @@ constexpr size_t BINARY_HEADER_SIZE_V1 = 20;
 constexpr size_t BINARY_HEADER_SIZE_V2 = 24;
 constexpr size_t BINARY_HEADER_SIZE = BINARY_HEADER_SIZE_V2;
 constexpr size_t METADATA_HEADER_SIZE = 6; // locale_len, fallback_len, note_len
+constexpr const char* SUPERSEDED_ERROR = "Ladevorgang abgebrochen oder durch neueren ersetzt.";
+constexpr const char* CATALOG_LIMIT_ERROR = "Token über 65535 Bytes oder Katalog über 4 GB.";
 
 uint16_t read_le_u16(const uint8_t* data) {
   return (uint16_t)data[0] | ((uint16_t)data[1] << 8);
@@ -52,6 +67,107 @@ void append_le_u32(std::vector<uint8_t>& dst, uint32_t value) {
   dst.push_back((uint8_t)((value >> 24) & 0xFF));
 }
 
+constexpr uint32_t fnv1a32_const(const char* s) {
+  uint32_t h = 2166136261u;
+  for (; *s; ++s) {
+    h ^= (uint8_t)*s;
+    h *= 16777619u;
+  }
+  return h;
+}
+// Nibble je Byte, 0x10 für Nicht-Hex-Zeichen: ein ODER über alle Werte meldet ungültige Zeichen ohne Verzweigung.
+struct HexDigitTable {
+  uint8_t value[256];
+  constexpr HexDigitTable() : value() {
+    for (int c = 0; c < 256; ++c) value[c] = 0x10;
+    for (int c = 0; c < 10; ++c) value['0' + c] = (uint8_t)c;
+    for (int c = 0; c < 6; ++c) {
+      value['a' + c] = (uint8_t)(10 + c);
+      value['A' + c] = (uint8_t)(10 + c);
+    }
+  }
+};
+constexpr HexDigitTable HEX_DIGITS{};
+
+uint64_t fnv1a64(std::string_view s) noexcept {
+  uint64_t h = 14695981039346656037ull;
+  for (unsigned char c : s) {
+    h ^= c;
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+// Feldnamen der Built-in-Kanäle in PropertyId-Reihenfolge.
+constexpr const char* PHYSICS_FIELD_NAMES[] = { "mass", "friction", "restitution", "drag", "gravity_scale", "spacing" };
+
+void append_json_string(std::string& out, const std::string& s) {
+  static constexpr char HEX[] = "0123456789abcdef";
+  out += '"';
+  for (char c : s) {
+    const unsigned char uc = (unsigned char)c;
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (uc < 0x20) {
+      out += "\\u00";
+      out += HEX[uc >> 4];
+      out += HEX[uc & 0x0F];
+    } else {
+      out += c;
+    }
+  }
+  out += '"';
+}
+
+void append_json_float(std::string& out, float value) {
+  // Kürzeste Darstellung, die exakt zurückgelesen wird; locale-unabhängig.
+  if (!std::isfinite(value)) { out += "null"; return; }
+  char buf[32];
+  const auto res = std::to_chars(buf, buf + sizeof(buf), value);
+  out.append(buf, res.ptr);
+}
+
+void append_be(std::string& out, uint32_t value, int bytes) {
+  for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8) out += (char)((value >> shift) & 0xFF);
+}
+
+void append_msgpack_map(std::string& out, size_t count) {
+  if (count <= 15) {
+    out += (char)(0x80 | count);
+  } else if (count <= 0xFFFF) {
+    out += (char)0xde;
+    append_be(out, (uint32_t)count, 2);
+  } else {
+    out += (char)0xdf;
+    append_be(out, (uint32_t)count, 4);
+  }
+}
+
+void append_msgpack_str(std::string& out, const char* data, size_t len) {
+  if (len <= 31) {
+    out += (char)(0xa0 | len);
+  } else if (len <= 0xFF) {
+    out += (char)0xd9;
+    append_be(out, (uint32_t)len, 1);
+  } else if (len <= 0xFFFF) {
+    out += (char)0xda;
+    append_be(out, (uint32_t)len, 2);
+  } else {
+    out += (char)0xdb;
+    append_be(out, (uint32_t)len, 4);
+  }
+  out.append(data, len);
+}
+
+void append_msgpack_float(std::string& out, float value) {
+  uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  out += (char)0xca;
+  append_be(out, bits, 4);
+}
+
+
 uint32_t fnv1a32_append(uint32_t hash, const uint8_t* data, size_t len) {
   uint32_t h = hash;
   for (size_t i = 0; i < len; ++i) {
@@ -174,6 +290,109 @@ void set_engine_error(I18nEngine* eng, const std::string& msg) {
 void clear_engine_error(I18nEngine* eng) {
   if (eng) eng->clear_last_error();
 }
+
+void count_result_too_large(I18nEngine* eng) {
+  if (eng) eng->count_event(I18nEngine::StatEvent::ResultTooLarge);
+}
+
+I18nEngine::ChunkWriter I18nEngine::ChunkWriter::to_callback(Callback callback, void* user) noexcept {
+  ChunkWriter w;
+  w.callback_ = callback;
+  w.user_ = user;
+  return w;
+}
+
+I18nEngine::ChunkWriter I18nEngine::ChunkWriter::to_fd(int fd) noexcept {
+  ChunkWriter w;
+  w.fd_ = fd;
+  return w;
+}
+
+I18nEngine::ChunkWriter I18nEngine::ChunkWriter::to_string(std::string& target) noexcept {
+  ChunkWriter w;
+  w.target_ = &target;
+  return w;
+}
+
+void I18nEngine::ChunkWriter::reserve(size_t bytes) {
+  std::string& out = buffer();
+  out.reserve(out.size() + (target_ ? bytes : std::min(bytes, CHUNK_SIZE)));
+}
+
+void I18nEngine::ChunkWriter::maybe_flush() {
+  if (target_ || buf_.size() < CHUNK_SIZE) return;
+  if (!failed_ && !emit(buf_.data(), buf_.size(), nullptr, 0)) failed_ = true;
+  buf_.clear();
+}
+
+void I18nEngine::ChunkWriter::write_ref(const char* data, size_t len) {
+  if (target_ || len < REF_THRESHOLD) {
+    buffer().append(data, len);
+    maybe_flush();
+    return;
+  }
+  // Großer Block: Puffer und Block gemeinsam schreiben, ohne den Block umzukopieren.
+  if (!failed_ && !emit(buf_.data(), buf_.size(), data, len)) failed_ = true;
+  buf_.clear();
+}
+
+bool I18nEngine::ChunkWriter::finish() {
+  if (target_) return true;
+  if (!failed_ && !buf_.empty() && !emit(buf_.data(), buf_.size(), nullptr, 0)) failed_ = true;
+  buf_.clear();
+  return !failed_;
+}
+
+bool I18nEngine::ChunkWriter::emit(const char* a, size_t a_len, const char* b, size_t b_len) {
+  flushed_ += a_len + b_len;
+  if (callback_) {
+    if (a_len && !callback_(user_, a, a_len)) return false;
+    if (b_len && !callback_(user_, b, b_len)) return false;
+    return true;
+  }
+  if (fd_ < 0) return false;
+#ifdef _WIN32
+  const char* parts[2] = { a, b };
+  size_t lens[2] = { a_len, b_len };
+  for (int p = 0; p < 2; ++p) {
+    while (lens[p] > 0) {
+      const unsigned int step = (unsigned int)std::min<size_t>(lens[p], 1u << 30);
+      const int n = _write(fd_, parts[p], step);
+      if (n < 0) {
+        if (errno == EINTR) continue;
+        return false;
+      }
+      parts[p] += n;
+      lens[p] -= (size_t)n;
+    }
+  }
+  return true;
+#else
+  struct iovec iov[2];
+  int count = 0;
+  if (a_len) iov[count++] = { const_cast<char*>(a), a_len };
+  if (b_len) iov[count++] = { const_cast<char*>(b), b_len };
+  int first = 0;
+  while (first < count) {
+    const ssize_t n = ::writev(fd_, iov + first, count - first);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    // Teilschreibvorgang: vollständig geschriebene iovecs überspringen, den Rest kürzen.
+    size_t done = (size_t)n;
+    while (first < count && done >= iov[first].iov_len) {
+      done -= iov[first].iov_len;
+      ++first;
+    }
+    if (first < count) {
+      iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + done;
+      iov[first].iov_len -= done;
+    }
+  }
+  return true;
+#endif
+}
 
 bool I18nEngine::is_ws(unsigned char c) noexcept { return std::isspace(c) != 0; }
 bool I18nEngine::is_digit(unsigned char c) noexcept { return std::isdigit(c) != 0; }
@@ -193,9 +412,26 @@ void I18nEngine::trim_inplace(std::string& s) {
   s.assign(it1, it2);
 }
 
-bool I18nEngine::is_hex_token(const std::string& s) {
-  if (s.size() < 6 || s.size() > 32) return false;
-  for (unsigned char c : s) if (!is_xdigit(c)) return false;
+bool I18nEngine::is_hex_token(std::string_view s) {
+  HexKey key;
+  return decode_hex_key(s, key);
+}
+
+bool I18nEngine::decode_hex_key(std::string_view token, HexKey& out) noexcept {
+  if (token.size() < 6 || token.size() > 32) return false;
+  uint64_t hi = 0;
+  uint64_t lo = 0;
+  uint8_t invalid = 0;
+  for (unsigned char c : token) {
+    const uint8_t v = HEX_DIGITS.value[c];
+    invalid |= v;
+    hi = (hi << 4) | (lo >> 60);
+    lo = (lo << 4) | (v & 0x0F);
+  }
+  if (invalid & 0x10) return false;
+  out.hi = hi;
+  out.lo = lo;
+  out.len = (uint32_t)token.size();
   return true;
 }
 
@@ -213,8 +449,18 @@ std::string I18nEngine::to_lower_ascii(std::string s) {
   return s;
 }
 
-std::string I18nEngine::unescape_txt_min(const std::string& s) {
-  std::string out;
+void I18nEngine::append_lower_ascii(std::string& out, std::string_view s) {
+  for (char c : s) out += (char)std::tolower((unsigned char)c);
+}
+
+std::string_view I18nEngine::trim_view(std::string_view s) noexcept {
+  while (!s.empty() && is_ws((unsigned char)s.front())) s.remove_prefix(1);
+  while (!s.empty() && is_ws((unsigned char)s.back())) s.remove_suffix(1);
+  return s;
+}
+
+void I18nEngine::unescape_txt_min(std::string_view s, std::string& out) {
+  out.clear();
   out.reserve(s.size());
   for (size_t i = 0; i < s.size(); ++i) {
     if (s[i] == '\\' && i + 1 < s.size()) {
@@ -232,10 +478,12 @@ std::string I18nEngine::unescape_txt_min(const std::string& s) {
       out += s[i];
     }
   }
-  return out;
 }
 
-bool I18nEngine::parse_line(const std::string& line_in,
+// Arbeitet direkt auf dem Quellpuffer; die Ausgabe-Strings gehören dem Aufrufer
+// und werden über alle Zeilen wiederverwendet, damit das Parsen pro Zeile ohne
+// eigene Allokationen auskommt.
+bool I18nEngine::parse_line(std::string_view line,
                             std::string& out_token,
                             std::string& out_label,
                             std::string& out_text,
@@ -245,64 +493,56 @@ bool I18nEngine::parse_line(const std::string& line_in,
   out_label.clear();
   out_text.clear();
 
-  std::string line = line_in;
-  trim_inplace(line);
+  line = trim_view(line);
   if (line.empty()) return false;
   if (line[0] == '#') return false;
 
   const auto colon = line.find(':');
-  if (colon == std::string::npos) {
+  if (colon == std::string_view::npos) {
     out_err = "Kein ':' gefunden.";
     return false;
   }
 
-  std::string head = line.substr(0, colon);
-  std::string text = line.substr(colon + 1);
-  trim_inplace(head);
-  while (!text.empty() && is_ws((unsigned char)text.front())) text.erase(text.begin());
-
-  std::string token;
-  std::string label;
+  const std::string_view head = trim_view(line.substr(0, colon));
+  std::string_view text = line.substr(colon + 1);
+  while (!text.empty() && is_ws((unsigned char)text.front())) text.remove_prefix(1);
 
   const auto paren_open = head.find('(');
-  if (paren_open == std::string::npos) {
-    token = head;
+  if (paren_open == std::string_view::npos) {
+    out_token.assign(head);
   } else {
-    token = head.substr(0, paren_open);
-    trim_inplace(token);
+    out_token.assign(trim_view(head.substr(0, paren_open)));
 
     const auto paren_close = head.find(')', paren_open + 1);
-    if (paren_close == std::string::npos) {
+    if (paren_close == std::string_view::npos) {
       out_err = "Label '(' ohne schließende ')'.";
       return false;
     }
 
-    label = head.substr(paren_open + 1, paren_close - (paren_open + 1));
-    trim_inplace(label);
+    out_label.assign(trim_view(head.substr(paren_open + 1, paren_close - (paren_open + 1))));
   }
 
-  std::string base_token;
-  std::string variant_token;
-
-  if (token.find('{') != std::string::npos) {
-    if (!parse_variant_suffix(token, base_token, variant_token)) {
+  bool valid = false;
+  if (out_token.find('{') != std::string::npos) {
+    std::string base_token;
+    std::string variant_token;
+    if (!parse_variant_suffix(out_token, base_token, variant_token)) {
       out_err = "Token-Variante ist ungültig.";
       return false;
     }
-    token = base_token + '{' + variant_token + '}';
+    valid = is_hex_token(base_token) || is_style_token(base_token) || is_template_token(base_token);
+    out_token = base_token + '{' + variant_token + '}';
   } else {
-    base_token = to_lower_ascii(token);
-    token = base_token;
+    for (char& c : out_token) c = (char)std::tolower((unsigned char)c);
+    valid = is_hex_token(out_token) || is_style_token(out_token) || is_template_token(out_token);
   }
 
-  if (!is_hex_token(base_token) && !is_style_token(base_token) && !is_template_token(base_token)) {
+  if (!valid) {
     out_err = "Token ist kein gültiger Hex-String (6–32 Zeichen).";
     return false;
   }
 
-  out_token = std::move(token);
-  out_label = std::move(label);
-  out_text  = unescape_txt_min(text);
+  unescape_txt_min(text, out_text);
   return true;
 }
 
@@ -344,7 +584,7 @@ I18nEngine::PluralRule I18nEngine::parse_plural_rule_name(std::string v, bool& o
   return PluralRule::DEFAULT;
 }
 
-bool I18nEngine::try_parse_inline_token(const std::string& s, size_t at_pos,
+bool I18nEngine::try_parse_inline_token(std::string_view s, size_t at_pos,
                                         std::string& out_token, size_t& out_advance) {
   out_token.clear();
   out_advance = 1;
@@ -373,26 +613,26 @@ bool I18nEngine::try_parse_inline_token(const std::string& s, size_t at_pos,
       ++pos;
     }
 
-    std::string token = s.substr(BASE_POS, pos - BASE_POS);
+    // Direkt in out_token bauen (bei den Aufrufern ein Scratch-String): kein Heap pro Referenz.
+    out_token.assign(s.data() + BASE_POS, pos - BASE_POS);
 
     if (pos < s.size() && s[pos] == '{') {
       size_t brace_start = pos + 1;
-      std::string variant;
+      const size_t variant_at = out_token.size() + 1;
+      out_token += '{';
       while (brace_start < s.size() && s[brace_start] != '}') {
-        variant += std::tolower((unsigned char)s[brace_start]);
+        out_token += (char)std::tolower((unsigned char)s[brace_start]);
         ++brace_start;
-        if (variant.size() > 16) return false;
+        if (out_token.size() - variant_at > 16) return false;
       }
+      const std::string_view variant(out_token.data() + variant_at, out_token.size() - variant_at);
       if (brace_start >= s.size() || s[brace_start] != '}' || variant.empty()) return false;
       if (!is_variant_valid(variant)) return false;
-      token += '{';
-      token += variant;
-      token += '}';
+      out_token += '}';
       pos = brace_start + 1;
     }
 
-    if (token.size() <= STYLE_PREFIX_LEN) return false;
-    out_token = token;
+    if (out_token.size() <= STYLE_PREFIX_LEN) return false;
     out_advance = pos - at_pos;
     return true;
   };
@@ -413,17 +653,16 @@ bool I18nEngine::try_parse_inline_token(const std::string& s, size_t at_pos,
   size_t advance = 1 + n;
   if (j < s.size() && s[j] == '{') {
     size_t k = j + 1;
-    std::string variant;
+    const size_t variant_at = out_token.size() + 1;
+    out_token += '{';
     while (k < s.size() && s[k] != '}') {
-      variant += s[k];
+      out_token += (char)std::tolower((unsigned char)s[k]);
       ++k;
-      if (variant.size() > 16) break;
+      if (out_token.size() - variant_at > 16) break;
     }
+    const std::string_view variant(out_token.data() + variant_at, out_token.size() - variant_at);
     if (k >= s.size() || s[k] != '}' || variant.empty()) return false;
-    for (char& c : variant) c = (char)std::tolower((unsigned char)c);
     if (!is_variant_valid(variant)) return false;
-    out_token += '{';
-    out_token += variant;
     out_token += '}';
     advance = (k + 1) - at_pos;
   }
@@ -432,7 +671,7 @@ bool I18nEngine::try_parse_inline_token(const std::string& s, size_t at_pos,
   return true;
 }
 
-void I18nEngine::scan_inline_refs(const std::string& text, std::vector<std::string>& out_refs) {
+void I18nEngine::scan_inline_refs(std::string_view text, std::vector<std::string>& out_refs) {
   out_refs.clear();
   for (size_t i = 0; i < text.size();) {
     if (text[i] != '@') { ++i; continue; }
@@ -455,75 +694,249 @@ void I18nEngine::scan_inline_refs(const std::string& text, std::vector<std::stri
   out_refs.erase(std::unique(out_refs.begin(), out_refs.end()), out_refs.end());
 }
 
-std::string I18nEngine::resolve_arg(const CatalogSnapshot* state,
-                                    const std::string& arg,
-                                    std::unordered_set<std::string>& seen,
-                                    int depth) {
-  if (!arg.empty() && arg[0] == '=') {
-    return arg.substr(1);
+bool I18nEngine::ResolvePath::contains(std::string_view token) const noexcept {
+  for (size_t i = 0; i < size; ++i) {
+    if (tokens[i] == token) return true;
   }
+  return false;
+}
 
-  std::string normalized = to_lower_ascii(arg);
-  std::string base = normalized;
-  std::string variant;
-  std::string lookup = normalized;
-  if (parse_variant_suffix(normalized, base, variant)) {
-    lookup.clear();
-    lookup += base;
-    lookup += '{';
-    lookup += variant;
-    lookup += '}';
+I18nEngine::ScratchFrame::ScratchFrame(I18nEngine& engine) noexcept
+    : engine_(engine), scratch_([]() -> ResolveScratch& {
+        thread_local ResolveScratch scratch;
+        return scratch;
+      }()),
+      mark_(scratch_.used) {}
+
+I18nEngine::ScratchFrame::~ScratchFrame() {
+  scratch_.used = mark_;
+  if (mark_ != 0) return;
+  // Äußerster Frame: Kapazitäten der benutzten Strings abgleichen; nur hier kann Wachstum auffallen.
+  // Ausreißer (riesige Args) geben ihren Speicher wieder ab, statt ihn pro Thread festzuhalten.
+  bool grew = false;
+  for (size_t i = 0; i < scratch_.peak; ++i) {
+    std::string& s = scratch_.strings[i];
+    if (s.capacity() > SCRATCH_KEEP_BYTES) std::string().swap(s);
+    const size_t capacity = s.capacity();
+    if (capacity != scratch_.capacities[i]) {
+      scratch_.capacities[i] = capacity;
+      grew = true;
+    }
+  }
+  scratch_.peak = 0;
+  if (grew) engine_.count_event(StatEvent::ScratchResize);
+}
+
+std::string& I18nEngine::ScratchFrame::take() {
+  if (scratch_.used == scratch_.strings.size()) {
+    scratch_.strings.emplace_back();
+    scratch_.capacities.push_back(0);
+  }
+  std::string& s = scratch_.strings[scratch_.used++];
+  if (scratch_.used > scratch_.peak) scratch_.peak = scratch_.used;
+  s.clear();
+  return s;
+}
+
+I18nEngine::ArgCache::ArgCache(I18nEngine& engine, const CatalogSnapshot* state, ArgList args)
+    : size(std::min(args.size(), ARG_CACHE_SLOTS)) {
+  std::string* key = nullptr;
+  for (size_t i = 0; i < size; ++i) {
+    ArgSlot& slot = slots[i];
+    slot.key = nullptr;
+    slot.value = nullptr;
+    slot.ready = false;
+    const std::string_view arg = args[i];
+    const bool literal = !arg.empty() && arg[0] == '=';
+    slot.text = arg.data() + (literal ? 1 : 0);
+    slot.text_size = arg.size() - (literal ? 1 : 0);
+    if (literal || !state || !is_hex_token(arg.substr(0, arg.find('{')))) continue;
+    if (!frame) frame.emplace(engine);
+    if (!key) key = &frame->take();
+    if (!engine.find_arg_reference(state, arg, *key)) continue;
+    slot.key = key;
+    slot.value = &frame->take();
+    key = nullptr;
+  }
+}
+
+bool I18nEngine::find_arg_reference(const CatalogSnapshot* state, std::string_view arg, std::string& key) {
+  // Nur Hex-Tokens (ggf. mit {variante}) können auf den Katalog zeigen; alles andere bleibt Text,
+  // ohne vorher eine kleingeschriebene Kopie anzulegen.
+  if (!is_hex_token(arg.substr(0, arg.find('{')))) return false;
+
+  ScratchFrame frame(*this);
+  std::string& base = frame.take();
+  std::string& variant = frame.take();
+  key.assign(arg.data(), arg.size());
+  for (char& c : key) c = (char)std::tolower((unsigned char)c);
+  if (parse_variant_suffix(key, base, variant)) {
+    key.assign(base);
+    key += '{';
+    key += variant;
+    key += '}';
   } else {
-    base = normalized;
+    base.assign(key);
+  }
+  return is_hex_token(base) && state->catalog.find(key) != state->catalog.end();
+}
+
+void I18nEngine::resolve_arg(const CatalogSnapshot* state,
+                             std::string_view arg,
+                             ResolvePath& path,
+                             int depth,
+                             std::string& out) {
+  if (!arg.empty() && arg[0] == '=') {
+    out += arg.substr(1);
+    return;
+  }
+  ScratchFrame frame(*this);
+  std::string& key = frame.take();
+  if (!find_arg_reference(state, arg, key)) {
+    out += arg;
+    return;
+  }
+  translate_into(state, key, {}, path, depth + 1, out, nullptr);
+}
+
+void I18nEngine::append_arg(const CatalogSnapshot* state,
+                            ArgList args,
+                            size_t idx,
+                            ResolvePath& path,
+                            int depth,
+                            std::string& out) {
+  ArgCache* cache = path.arg_cache;
+  if (!cache || idx >= cache->size || path.recording) {
+    resolve_arg(state, args[idx], path, depth, out);
+    return;
+  }
+  ArgSlot& slot = cache->slots[idx];
+  if (!slot.key) {
+    out.append(slot.text, slot.text_size);
+    return;
+  }
+  if (slot.ready) {
+    if (arg_reusable(slot, path, depth)) out += *slot.value;
+    else translate_into(state, *slot.key, {}, path, depth + 1, out, nullptr);
+    return;
   }
 
-  if (!is_hex_token(base)) return arg;
+  // Erste Expansion, oder die bisherigen hingen vom Pfad ab: aufzeichnen, welche Tokens sie berührt.
+  slot.value->clear();
+  slot.cacheable = true;
+  slot.base_depth = depth;
+  slot.max_depth = depth;
+  slot.closure_size = 0;
+  path.recording = &slot;
+  translate_into(state, *slot.key, {}, path, depth + 1, *slot.value, nullptr);
+  path.recording = nullptr;
+  slot.ready = slot.cacheable;
+  out += *slot.value;
+}
 
-  auto it = state->catalog.find(lookup);
-  if (it == state->catalog.end()) return arg;
+void I18nEngine::record_expansion(ResolvePath& path, const CatalogSnapshot* state, const std::string* token, int depth) {
+  ArgSlot& slot = *path.recording;
+  slot.max_depth = std::max(slot.max_depth, depth);
+  if (depth > MAX_RESOLVE_DEPTH) slot.cacheable = false;
+  if (!token || !slot.cacheable) return;
+  if (path.contains(*token)) {
+    slot.cacheable = false;
+    return;
+  }
+  // Die Tokens selbst liegen in Scratch-Strings; gemerkt werden die Schlüssel im Snapshot. Fehlende
+  // Tokens expandieren nichts und können daher nie auf einem fremden Pfad liegen.
+  std::string_view key;
+  auto it = state->catalog.find(*token);
+  if (it != state->catalog.end()) {
+    key = it->first;
+  } else if (const auto* style_state = dynamic_cast<const StyleCatalogSnapshot*>(state)) {
+    auto style = style_state->style_registry.find(*token);
+    if (style == style_state->style_registry.end()) return;
+    key = style->first;
+  } else {
+    return;
+  }
+  if (slot.closure_size == ARG_CLOSURE_MAX) {
+    slot.cacheable = false;
+    return;
+  }
+  slot.closure[slot.closure_size++] = { key.data(), key.size() };
+}
 
-  return translate_impl(state, lookup, {}, seen, depth + 1);
+bool I18nEngine::arg_reusable(const ArgSlot& slot, const ResolvePath& path, int depth) noexcept {
+  if (depth + (slot.max_depth - slot.base_depth) > MAX_RESOLVE_DEPTH) return false;
+  for (size_t i = 0; i < slot.closure_size; ++i) {
+    if (path.contains({ slot.closure[i].data, slot.closure[i].size })) return false;
+  }
+  return true;
 }
 
-std::string I18nEngine::translate_impl(const CatalogSnapshot* state,
-                                       const std::string& token,
-                                       const std::vector<std::string>& args,
-                                       std::unordered_set<std::string>& seen,
-                                       int depth) {
-  if (depth > 32) return "⟦RECURSION_LIMIT⟧";
-  if (seen.count(token)) return "⟦CYCLE:" + token + "⟧";
-  seen.insert(token);
+void I18nEngine::translate_into(const CatalogSnapshot* state,
+                                const std::string& token,
+                                ArgList args,
+                                ResolvePath& path,
+                                int depth,
+                                std::string& out,
+                                ChunkWriter* stream) {
+  // Hängt an out an und liest nie zurück; mit stream darf out daher jederzeit geleert werden.
+  TraceScope span(*this, TraceKind::Inner, "translate_impl", token, args.size(), state, depth);
+  span.measure_output(&out, stream);
+  if (path.recording) record_expansion(path, state, &token, depth);
+  if (depth > MAX_RESOLVE_DEPTH) {
+    count_event(StatEvent::RecursionLimit);
+    out += "⟦RECURSION_LIMIT⟧";
+    return;
+  }
+  if (path.contains(token)) {
+    count_event(StatEvent::Cycle);
+    out += "⟦CYCLE:";
+    out += token;
+    out += "⟧";
+    return;
+  }
+  struct PathEntry {
+    ResolvePath& path;
+    ~PathEntry() { --path.size; }
+  };
+  path.tokens[path.size++] = token;
+  PathEntry entry{ path };
 
   if (const auto* style_state = dynamic_cast<const StyleCatalogSnapshot*>(state)) {
-    std::string style_out;
-    if (try_build_style_string(style_state, token, args, seen, depth, style_out)) {
-      seen.erase(token);
-      return style_out;
-    }
+    if (try_build_style_string(style_state, token, args, path, depth, out)) return;
   }
 
   auto it = state->catalog.find(token);
   if (it == state->catalog.end()) {
-    seen.erase(token);
-    return "⟦" + token + "⟧";
+    count_event(StatEvent::Missing);
+    out += "⟦";
+    out += token;
+    out += "⟧";
+    return;
   }
 
-  const std::string& raw = it->second;
-  std::string out;
-  out.reserve(raw.size() + 32);
+  const std::string_view raw = it->second;
+  out.reserve(out.size() + raw.size() + 32);
+  ScratchFrame frame(*this);
+  std::string& ref_tok = frame.take();
 
   for (size_t i = 0; i < raw.size();) {
     // --- Inline Token Reference: @deadbeef / @@ ---
     if (raw[i] == '@') {
-      std::string ref_tok;
       size_t adv = 1;
 
       if (try_parse_inline_token(raw, i, ref_tok, adv)) {
         // harte Token-Ref: muss im Catalog sein, sonst sichtbarer Marker
-        if (state->catalog.find(ref_tok) == state->catalog.end()) out += "⟦MISSING:@" + ref_tok + "⟧";
-        else out += translate_impl(state, ref_tok, args, seen, depth + 1);
+        if (state->catalog.find(ref_tok) == state->catalog.end()) {
+          count_event(StatEvent::Missing);
+          out += "⟦MISSING:@";
+          out += ref_tok;
+          out += "⟧";
+        } else {
+          translate_into(state, ref_tok, args, path, depth + 1, out, stream);
+        }
 
         i += adv;
+        if (stream) stream->maybe_flush();
         continue;
       }
 
@@ -549,37 +962,50 @@ std::string I18nEngine::translate_impl(const CatalogSnapshot* state,
         ++j;
       }
 
-      if (idx >= 0 && (size_t)idx < args.size()) out += resolve_arg(state, args[(size_t)idx], seen, depth);
-      else out += "⟦arg:" + std::to_string(idx) + "⟧";
+      if (idx >= 0 && (size_t)idx < args.size()) append_arg(state, args, (size_t)idx, path, depth, out);
+      else { out += "⟦arg:"; out += std::to_string(idx); out += "⟧"; }
 
       i = j;
+      if (stream) stream->maybe_flush();
       continue;
     }
     out += raw[i];
     ++i;
   }
-
-  seen.erase(token);
-  return out;
 }
 
-std::string I18nEngine::resolve_plain_text(const CatalogSnapshot* state,
-                                           const std::string& raw,
-                                           const std::vector<std::string>& args,
-                                           std::unordered_set<std::string>& seen,
-                                           int depth) {
-  if (depth > 32) return "⟦RECURSION_LIMIT⟧";
-  if (!state) return raw;
-  std::string out;
-  out.reserve(raw.size());
+void I18nEngine::resolve_plain_text(const CatalogSnapshot* state,
+                                    std::string_view raw,
+                                    ArgList args,
+                                    ResolvePath& path,
+                                    int depth,
+                                    std::string& out) {
+  if (path.recording) record_expansion(path, state, nullptr, depth);
+  if (depth > MAX_RESOLVE_DEPTH) {
+    count_event(StatEvent::RecursionLimit);
+    out += "⟦RECURSION_LIMIT⟧";
+    return;
+  }
+  if (!state) {
+    out += raw;
+    return;
+  }
+  out.reserve(out.size() + raw.size());
+  ScratchFrame frame(*this);
+  std::string& ref_tok = frame.take();
 
   for (size_t i = 0; i < raw.size();) {
     if (raw[i] == '@') {
-      std::string ref_tok;
       size_t adv = 1;
       if (try_parse_inline_token(raw, i, ref_tok, adv)) {
-        if (state->catalog.find(ref_tok) == state->catalog.end()) out += "⟦MISSING:@" + ref_tok + "⟧";
-        else out += translate_impl(state, ref_tok, args, seen, depth + 1);
+        if (state->catalog.find(ref_tok) != state->catalog.end()) {
+          translate_into(state, ref_tok, args, path, depth + 1, out, nullptr);
+        } else {
+          count_event(StatEvent::Missing);
+          out += "⟦MISSING:@";
+          out += ref_tok;
+          out += "⟧";
+        }
         i += adv;
         continue;
       }
@@ -600,8 +1026,8 @@ std::string I18nEngine::resolve_plain_text(const CatalogSnapshot* state,
         idx = idx * 10 + (raw[j] - '0');
         ++j;
       }
-      if (idx >= 0 && (size_t)idx < args.size()) out += resolve_arg(state, args[(size_t)idx], seen, depth + 1);
-      else out += "⟦arg:" + std::to_string(idx) + "⟧";
+      if (idx >= 0 && (size_t)idx < args.size()) append_arg(state, args, (size_t)idx, path, depth + 1, out);
+      else { out += "⟦arg:"; out += std::to_string(idx); out += "⟧"; }
       i = j;
       continue;
     }
@@ -609,50 +1035,49 @@ std::string I18nEngine::resolve_plain_text(const CatalogSnapshot* state,
     out += raw[i];
     ++i;
   }
-
-  return out;
 }
 
 bool I18nEngine::try_build_style_string(const StyleCatalogSnapshot* style_state,
                                         const std::string& token,
-                                        const std::vector<std::string>& args,
-                                        std::unordered_set<std::string>& seen,
+                                        ArgList args,
+                                        ResolvePath& path,
                                         int depth,
-                                        std::string& out_style) {
-  if (!style_state) return false;
+                                        std::string& out) {
+  // Registry-Schlüssel beginnen alle mit "style_"; Hex-Tokens sparen sich so den String-Hash.
+  if (!style_state || token.compare(0, 6, "style_") != 0) return false;
   auto it = style_state->style_registry.find(token);
   if (it == style_state->style_registry.end()) return false;
   if (it->second.empty()) return false;
 
-  std::string builder;
-  builder.reserve(it->second.size() * 32);
+  // Direkt in out; start trennt die eigene Ausgabe von dem, was schon darin stand.
+  const size_t start = out.size();
+  out.reserve(start + it->second.size() * 32);
+  auto separate = [&]() {
+    if (out.size() > start && out.back() != ' ') out += ' ';
+  };
 
   for (const auto& prop : it->second) {
     if (prop.prop_name.empty()) {
-      std::string resolved = resolve_plain_text(style_state, prop.value, args, seen, depth + 1);
-      if (!resolved.empty()) {
-        if (!builder.empty() && builder.back() != ' ') builder += ' ';
-        builder += resolved;
-        builder += ' ';
-      }
+      const size_t before = out.size();
+      separate();
+      const size_t value_start = out.size();
+      resolve_plain_text(style_state, prop.value, args, path, depth + 1, out);
+      if (out.size() == value_start) out.resize(before); // leere Referenz: auch kein Trenner
+      else out += ' ';
       continue;
     }
-    std::string resolved = resolve_plain_text(style_state, prop.value, args, seen, depth + 1);
-    if (!builder.empty() && builder.back() != ' ') builder += ' ';
-    builder += prop.prop_name;
-    builder += ": ";
-    builder += resolved;
-    builder += ";";
+    separate();
+    out += prop.prop_name;
+    out += ": ";
+    resolve_plain_text(style_state, prop.value, args, path, depth + 1, out);
+    out += ";";
   }
 
-  while (!builder.empty() && builder.back() == ' ') builder.pop_back();
-
-  if (builder.empty()) return false;
-  out_style = std::move(builder);
-  return true;
+  while (out.size() > start && out.back() == ' ') out.pop_back();
+  return out.size() > start;
 }
 
-std::vector<std::string> I18nEngine::gather_style_tokens(const std::string& text) const {
+std::vector<std::string> I18nEngine::gather_style_tokens(std::string_view text) const {
   std::vector<std::string> refs;
   scan_inline_refs(text, refs);
   std::vector<std::string> tokens;
@@ -664,51 +1089,140 @@ std::vector<std::string> I18nEngine::gather_style_tokens(const std::string& text
   return tokens;
 }
 
-std::string I18nEngine::get_physics_json(const std::vector<std::string>& style_tokens) {
-  std::ostringstream ss;
-  ss << "{";
-  bool first = true;
+std::string I18nEngine::serialize_physics(const StyleCatalogSnapshot* style_state,
+                                          const std::vector<std::string>& style_tokens,
+                                          PhysicsFormat format) {
+  struct Entry {
+    const std::string* token;
+    NativeStyle phys;
+  };
+  std::vector<Entry> entries;
+  entries.reserve(style_tokens.size());
   for (const auto& token : style_tokens) {
-    NativeStyle phys = get_native_style(token, {});
-    if (!phys.has_physical) continue;
-    if (!first) ss << ",";
+    NativeStyle phys = native_style_for(style_state, token, {});
+    if (phys.has_physical) entries.push_back({ &token, phys });
+  }
+
+  static const std::vector<std::string> NO_CUSTOM;
+  const auto& custom_names = style_state->schema ? style_state->schema->custom_names : NO_CUSTOM;
+  std::string out;
+  out.reserve(16 + entries.size() * (format == PhysicsFormat::Json ? 160 : 96));
+
+  if (format == PhysicsFormat::MessagePack) {
+    // {token: {PropertyId: float32}}; Built-ins immer, eigene Kanäle nur wenn gesetzt.
+    // IDs statt Namen halten die Payload klein, Namen liefert property_name().
+    append_msgpack_map(out, entries.size());
+    for (const auto& entry : entries) {
+      append_msgpack_str(out, entry.token->data(), entry.token->size());
+      const size_t channels = PROPERTY_BUILTIN_COUNT + custom_names.size();
+      size_t fields = PROPERTY_BUILTIN_COUNT;
+      for (size_t id = PROPERTY_BUILTIN_COUNT; id < channels; ++id) {
+        if (entry.phys.set_mask & (1u << id)) ++fields;
+      }
+      append_msgpack_map(out, fields);
+      for (size_t id = 0; id < channels; ++id) {
+        float value = 0.0f;
+        if (!read_physical_property(entry.phys, (PropertyId)id, value) && id >= PROPERTY_BUILTIN_COUNT) continue;
+        out += (char)id; // positive fixint, IDs < 128
+        append_msgpack_float(out, value);
+      }
+    }
+    return out;
+  }
+
+  out += '{';
+  bool first = true;
+  for (const auto& entry : entries) {
+    if (!first) out += ',';
     first = false;
-    ss << "\"" << token << "\":";
-    ss << "{\"mass\":" << std::to_string(phys.mass);
-    ss << ",\"friction\":" << std::to_string(phys.friction);
-    ss << ",\"spacing\":" << std::to_string(phys.spacing) << "}";
+    append_json_string(out, *entry.token);
+    out += ":{";
+    for (PropertyId id = 0; id < PROPERTY_BUILTIN_COUNT; ++id) {
+      float value = 0.0f;
+      read_physical_property(entry.phys, id, value);
+      if (id) out += ',';
+      out += '"';
+      out += PHYSICS_FIELD_NAMES[id];
+      out += "\":";
+      append_json_float(out, value);
+    }
+    for (size_t i = 0; i < custom_names.size(); ++i) {
+      float value = 0.0f;
+      if (!read_physical_property(entry.phys, (PropertyId)(PROPERTY_BUILTIN_COUNT + i), value)) continue;
+      out += ',';
+      append_json_string(out, custom_names[i]);
+      out += ':';
+      append_json_float(out, value);
+    }
+    out += '}';
   }
-  ss << "}";
-  return ss.str();
+  out += '}';
+  return out;
 }
 
-std::string I18nEngine::get_physics_json_from_template(const std::string& template_token,
-                                                       const std::vector<std::string>& args) {
+std::string I18nEngine::physics_from_template(const std::string& template_token,
+                                              ArgList args,
+                                              PhysicsFormat format) {
+  const std::string empty = (format == PhysicsFormat::Json) ? "{}" : std::string(1, (char)0x80);
   auto snapshot = acquire_snapshot();
-  if (!snapshot) return "{}";
+  if (!snapshot) return empty;
   auto style_snapshot = std::dynamic_pointer_cast<const StyleCatalogSnapshot>(snapshot);
-  if (!style_snapshot) return "{}";
+  if (!style_snapshot) return empty;
   std::string normalized = to_lower_ascii(template_token);
   auto it = style_snapshot->catalog.find(normalized);
-  if (it == style_snapshot->catalog.end()) return "{}";
+  if (it == style_snapshot->catalog.end()) return empty;
+
+  ArgCache arg_cache(*this, style_snapshot.get(), args);
+  ResolvePath path(arg_cache);
+  auto compiled = style_snapshot->templates.find(normalized);
+  if (compiled != style_snapshot->templates.end() && !compiled->second.split_tokens) {
+    count_event(StatEvent::CacheHit);
+    const CompiledTemplate& tpl = compiled->second;
+    if (tpl.arg_indices.empty()) return (format == PhysicsFormat::Json) ? tpl.physics_json : tpl.physics_msgpack;
+
+    // Nur die Args können weitere Styles einschleusen; das Manifest ist fix.
+    std::vector<std::string> style_tokens;
+    style_tokens.reserve(tpl.style_manifest.size());
+    for (const auto& entry : tpl.style_manifest) style_tokens.push_back(entry.token);
+    std::vector<std::string> refs;
+    std::string resolved;
+    for (uint32_t idx : tpl.arg_indices) {
+      if (idx >= args.size()) continue;
+      resolved.clear();
+      append_arg(style_snapshot.get(), args, idx, path, 1, resolved);
+      scan_inline_refs(resolved, refs);
+      for (auto& ref : refs) {
+        if (is_style_token(ref)) style_tokens.push_back(std::move(ref));
+      }
+    }
+    std::sort(style_tokens.begin(), style_tokens.end());
+    style_tokens.erase(std::unique(style_tokens.begin(), style_tokens.end()), style_tokens.end());
+    return serialize_physics(style_snapshot.get(), style_tokens, format);
+  }
 
-  std::unordered_set<std::string> seen;
-  std::string resolved =
-      resolve_template_placeholders(style_snapshot.get(), it->second, args, seen, 0);
+  std::string resolved;
+  resolve_template_placeholders(style_snapshot.get(), it->second, args, path, 0, resolved);
 
   auto style_tokens = gather_style_tokens(resolved);
-  return get_physics_json(style_tokens);
+  return serialize_physics(style_snapshot.get(), style_tokens, format);
 }
 
-std::string I18nEngine::resolve_template_placeholders(const CatalogSnapshot* state,
-                                                      const std::string& raw,
-                                                      const std::vector<std::string>& args,
-                                                      std::unordered_set<std::string>& seen,
-                                                      int depth) {
-  if (depth > 32) return "⟦RECURSION_LIMIT⟧";
-  if (!state) return raw;
-  std::string out;
-  out.reserve(raw.size());
+void I18nEngine::resolve_template_placeholders(const CatalogSnapshot* state,
+                                               std::string_view raw,
+                                               ArgList args,
+                                               ResolvePath& path,
+                                               int depth,
+                                               std::string& out) {
+  if (depth > MAX_RESOLVE_DEPTH) {
+    count_event(StatEvent::RecursionLimit);
+    out += "⟦RECURSION_LIMIT⟧";
+    return;
+  }
+  if (!state) {
+    out += raw;
+    return;
+  }
+  out.reserve(out.size() + raw.size());
 
   for (size_t i = 0; i < raw.size();) {
     if (raw[i] == '%' && i + 1 < raw.size() && is_digit((unsigned char)raw[i + 1])) {
@@ -720,9 +1234,11 @@ std::string I18nEngine::resolve_template_placeholders(const CatalogSnapshot* sta
       }
 
       if (idx >= 0 && (size_t)idx < args.size()) {
-        out += resolve_arg(state, args[(size_t)idx], seen, depth + 1);
+        append_arg(state, args, (size_t)idx, path, depth + 1, out);
       } else {
-        out += "⟦arg:" + std::to_string(idx) + "⟧";
+        out += "⟦arg:";
+        out += std::to_string(idx);
+        out += "⟧";
       }
 
       i = j;
@@ -732,31 +1248,241 @@ std::string I18nEngine::resolve_template_placeholders(const CatalogSnapshot* sta
     out += raw[i];
     ++i;
   }
-
-  return out;
 }
 
 bool I18nEngine::build_style_definitions(const StyleCatalogSnapshot* style_state,
                                          const std::vector<std::string>& tokens,
-                                         const std::vector<std::string>& args,
-                                         std::string& out_defs) {
+                                         ArgList args,
+                                         std::string& out_defs,
+                                         const CompiledTemplate* compiled,
+                                         ArgCache* arg_cache) {
   if (!style_state || tokens.empty()) return false;
+  TraceScope span(*this, TraceKind::Inner, "build_style_definitions", std::string_view(), args.size(), style_state);
+  span.measure_output(&out_defs);
+  const size_t start = out_defs.size();
   std::unordered_set<std::string> classes;
-  std::ostringstream ss;
+  std::string style_string;
 
   for (const auto& token : tokens) {
     if (!is_style_token(token)) continue;
-    std::unordered_set<std::string> seen;
-    std::string style_string;
-    if (!try_build_style_string(style_state, token, args, seen, 0, style_string)) continue;
-    if (style_string.empty()) continue;
-    std::string class_name = sanitize_css_class(token);
+    std::string scratch;
+    const std::string& class_name = css_class_for(style_state, token, scratch);
+    const ManifestEntry* entry = compiled ? find_manifest_entry(*compiled, token) : nullptr;
+    if (entry && entry->arg_free) {
+      if (entry->definition.empty()) continue;
+      if (!classes.insert(class_name).second) continue;
+      out_defs += entry->definition;
+      continue;
+    }
+    ResolvePath path;
+    path.arg_cache = arg_cache;
+    style_string.clear();
+    if (!try_build_style_string(style_state, token, args, path, 0, style_string)) continue;
     if (!classes.insert(class_name).second) continue;
-    ss << "." << class_name << "{" << style_string << "}\n";
+    out_defs += '.';
+    out_defs += class_name;
+    out_defs += '{';
+    out_defs += style_string;
+    out_defs += "}\n";
+  }
+
+  return out_defs.size() > start;
+}
+
+const I18nEngine::ManifestEntry* I18nEngine::find_manifest_entry(const CompiledTemplate& compiled,
+                                                                 const std::string& token) {
+  auto it = std::lower_bound(compiled.style_manifest.begin(), compiled.style_manifest.end(), token,
+                             [](const ManifestEntry& e, const std::string& t) { return e.token < t; });
+  if (it == compiled.style_manifest.end() || it->token != token) return nullptr;
+  return &*it;
+}
+
+bool I18nEngine::style_uses_args(const CatalogSnapshot* state, const std::string& token,
+                                 std::unordered_map<std::string, int8_t>& memo) {
+  auto m = memo.find(token);
+  if (m != memo.end()) return m->second > 0; // -1 (in Arbeit) zählt als arg-frei
+  auto it = state->catalog.find(token);
+  if (it == state->catalog.end()) return false;
+  memo[token] = -1;
+
+  const std::string_view text = it->second;
+  bool uses = false;
+  for (size_t i = 0; i + 1 < text.size(); ++i) {
+    if (text[i] == '%' && is_digit((unsigned char)text[i + 1])) { uses = true; break; }
+  }
+  if (!uses) {
+    std::vector<std::string> refs;
+    scan_inline_refs(text, refs);
+    for (const auto& ref : refs) {
+      if (style_uses_args(state, ref, memo)) { uses = true; break; }
+    }
+  }
+
+  memo[token] = uses ? 1 : 0;
+  return uses;
+}
+
+void I18nEngine::index_styles(StyleCatalogSnapshot* snapshot, const std::vector<std::string>* only) {
+  if (!snapshot) return;
+  snapshot->style_info.clear();
+  std::unordered_map<std::string, int8_t> arg_memo;
+  for_each_entry(snapshot, only, [&](std::string_view token_view, std::string_view) {
+    if (!is_style_token(token_view)) return;
+    const std::string token(token_view);
+    StyleInfo info;
+    info.css_class = sanitize_css_class(token);
+    info.uses_args = style_uses_args(snapshot, token, arg_memo);
+    snapshot->style_info.emplace(token, std::move(info));
+  });
+}
+
+void I18nEngine::compile_templates(StyleCatalogSnapshot* snapshot, const std::vector<std::string>* only) {
+  if (!snapshot) return;
+  index_styles(snapshot, only);
+  snapshot->templates.clear();
+  std::unordered_map<std::string, int8_t> arg_memo;
+
+  for_each_entry(snapshot, only, [&](std::string_view token_view, std::string_view raw) {
+    if (!is_template_token(token_view)) return;
+    const std::string token(token_view);
+    CompiledTemplate tpl;
+
+    if (has_split_inline_token(raw)) {
+      tpl.split_tokens = true;
+      snapshot->templates.emplace(token, std::move(tpl));
+      return;
+    }
+
+    std::string literal;
+    auto flush_literal = [&]() {
+      if (literal.empty()) return;
+      TemplateSegment seg;
+      seg.kind = TemplateSegment::Kind::Literal;
+      seg.text = std::move(literal);
+      tpl.segments.push_back(std::move(seg));
+      literal.clear();
+    };
+
+    std::vector<std::string> manifest_tokens;
+    for (size_t i = 0; i < raw.size();) {
+      if (raw[i] == '%' && i + 1 < raw.size() && is_digit((unsigned char)raw[i + 1])) {
+        size_t j = i + 1;
+        uint32_t idx = 0;
+        while (j < raw.size() && is_digit((unsigned char)raw[j])) {
+          idx = idx * 10 + (uint32_t)(raw[j] - '0');
+          ++j;
+        }
+        flush_literal();
+        TemplateSegment seg;
+        seg.kind = TemplateSegment::Kind::Arg;
+        seg.arg_index = idx;
+        tpl.segments.push_back(std::move(seg));
+        tpl.arg_indices.push_back(idx);
+        i = j;
+        continue;
+      }
+
+      if (raw[i] == '@') {
+        std::string tok;
+        size_t adv = 1;
+        if (try_parse_inline_token(raw, i, tok, adv) && is_style_token(tok)) {
+          flush_literal();
+          TemplateSegment seg;
+          seg.kind = TemplateSegment::Kind::StyleClass;
+          std::string scratch;
+          seg.text = css_class_for(snapshot, tok, scratch);
+          tpl.segments.push_back(std::move(seg));
+          manifest_tokens.push_back(std::move(tok));
+        } else {
+          literal.append(raw, i, adv);
+        }
+        i += adv;
+        continue;
+      }
+
+      literal += raw[i];
+      ++i;
+    }
+    flush_literal();
+
+    std::sort(tpl.arg_indices.begin(), tpl.arg_indices.end());
+    tpl.arg_indices.erase(std::unique(tpl.arg_indices.begin(), tpl.arg_indices.end()), tpl.arg_indices.end());
+    std::sort(manifest_tokens.begin(), manifest_tokens.end());
+    manifest_tokens.erase(std::unique(manifest_tokens.begin(), manifest_tokens.end()), manifest_tokens.end());
+
+    for (auto& token : manifest_tokens) {
+      ManifestEntry entry;
+      entry.arg_free = !style_uses_args(snapshot, token, arg_memo);
+      if (entry.arg_free) {
+        ResolvePath path;
+        std::string style_string;
+        std::string scratch;
+        if (try_build_style_string(snapshot, token, {}, path, 0, style_string)) {
+          entry.definition = "." + css_class_for(snapshot, token, scratch) + "{" + style_string + "}\n";
+        }
+      }
+      entry.token = std::move(token);
+      tpl.style_manifest.push_back(std::move(entry));
+    }
+
+    if (tpl.arg_indices.empty()) {
+      std::vector<std::string> style_tokens;
+      style_tokens.reserve(tpl.style_manifest.size());
+      for (const auto& entry : tpl.style_manifest) style_tokens.push_back(entry.token);
+      tpl.physics_json = serialize_physics(snapshot, style_tokens, PhysicsFormat::Json);
+      tpl.physics_msgpack = serialize_physics(snapshot, style_tokens, PhysicsFormat::MessagePack);
+    }
+
+    snapshot->templates.emplace(token, std::move(tpl));
+  });
+}
+
+void I18nEngine::render_compiled_body(const StyleCatalogSnapshot* style_state,
+                                      const CompiledTemplate& compiled,
+                                      const std::vector<std::string>& arg_values,
+                                      size_t arg_count,
+                                      HtmlEmitState& emit,
+                                      ChunkWriter& out) {
+  for (const auto& seg : compiled.segments) {
+    switch (seg.kind) {
+      case TemplateSegment::Kind::Literal:
+        if (!emit.minify) {
+          out.write_ref(seg.text.data(), seg.text.size());
+        } else {
+          for (size_t k = 0; k < seg.text.size();) emit_html_unit(style_state, seg.text, k, emit, out.buffer(), nullptr);
+        }
+        break;
+      case TemplateSegment::Kind::StyleClass:
+        if (emit.pending_space) { out.buffer() += ' '; emit.pending_space = false; }
+        emit.wrote_text = true;
+        out.buffer() += seg.text;
+        break;
+      case TemplateSegment::Kind::Arg: {
+        if (seg.arg_index < arg_count) {
+          const std::string& value = arg_values[seg.arg_index];
+          for (size_t k = 0; k < value.size();) emit_html_unit(style_state, value, k, emit, out.buffer(), nullptr);
+        } else {
+          const std::string marker = "⟦arg:" + std::to_string(seg.arg_index) + "⟧";
+          for (size_t k = 0; k < marker.size();) emit_html_unit(style_state, marker, k, emit, out.buffer(), nullptr);
+        }
+        break;
+      }
+    }
+    out.maybe_flush();
   }
+}
 
-  out_defs = ss.str();
-  return !out_defs.empty();
+void I18nEngine::collect_html_styles(std::string_view src, StyleCollector& styles) {
+  // Gleiche Erkennung wie emit_html_unit, nur ohne Ausgabe.
+  for (size_t pos = 0; pos < src.size();) {
+    if (src[pos] != '@') { ++pos; continue; }
+    std::string tok;
+    size_t adv = 1;
+    if (try_parse_inline_token(src, pos, tok, adv) && is_style_token(tok)) {
+      if (styles.seen.insert(tok).second) styles.tokens.push_back(std::move(tok));
+    }
+    pos += adv;
+  }
 }
 
 std::string I18nEngine::sanitize_css_class(const std::string& token) {
@@ -774,12 +1500,123 @@ std::string I18nEngine::sanitize_css_class(const std::string& token) {
   return out;
 }
 
-void I18nEngine::replace_all(std::string& subject, const std::string& search, const std::string& replacement) {
-  if (search.empty()) return;
-  size_t pos = 0;
-  while ((pos = subject.find(search, pos)) != std::string::npos) {
-    subject.replace(pos, search.size(), replacement);
-    pos += replacement.size();
+const std::string& I18nEngine::css_class_for(const StyleCatalogSnapshot* style_state,
+                                             const std::string& token,
+                                             std::string& scratch) {
+  if (style_state) {
+    auto it = style_state->style_info.find(token);
+    if (it != style_state->style_info.end()) return it->second.css_class;
+  }
+  scratch = sanitize_css_class(token);
+  return scratch;
+}
+
+std::string I18nEngine::escape_html_attr(const std::string& value) {
+  std::string out;
+  out.reserve(value.size());
+  for (char c : value) {
+    switch (c) {
+      case '&': out += "&amp;"; break;
+      case '"': out += "&quot;"; break;
+      case '<': out += "&lt;"; break;
+      case '>': out += "&gt;"; break;
+      default: out += c; break;
+    }
+  }
+  return out;
+}
+
+void I18nEngine::emit_html_unit(const StyleCatalogSnapshot* style_state,
+                                std::string_view src, size_t& pos, HtmlEmitState& emit,
+                                std::string& out, StyleCollector* styles) {
+  const char c = src[pos];
+  if (emit.minify && is_ws((unsigned char)c)) {
+    // Erst vor dem nächsten Text schreiben: so fällt Whitespace am Ende ohne Rücklesen weg.
+    if (emit.wrote_text) emit.pending_space = true;
+    ++pos;
+    return;
+  }
+  if (emit.pending_space) {
+    out += ' ';
+    emit.pending_space = false;
+  }
+  emit.wrote_text = true;
+
+  if (c == '@') {
+    std::string tok;
+    size_t adv = 1;
+    if (try_parse_inline_token(src, pos, tok, adv) && is_style_token(tok)) {
+      std::string scratch;
+      out += css_class_for(style_state, tok, scratch);
+      if (styles && styles->seen.insert(tok).second) styles->tokens.push_back(std::move(tok));
+    } else {
+      // Hex-Refs und @@ bleiben im HTML unverändert stehen
+      out.append(src, pos, adv);
+    }
+    pos += adv;
+    return;
+  }
+
+  out += c;
+  ++pos;
+}
+
+bool I18nEngine::has_split_inline_token(std::string_view raw) noexcept {
+  // Erkennt "@style_%0"-Konstrukte, bei denen erst der Arg-Wert den Token vervollständigt.
+  for (size_t i = 0; i < raw.size(); ++i) {
+    if (raw[i] != '@') continue;
+    if (i + 1 < raw.size() && raw[i + 1] == '@') { ++i; continue; }
+    size_t j = i + 1;
+    while (j < raw.size() && (std::isalnum((unsigned char)raw[j]) || raw[j] == '_' || raw[j] == '-' ||
+                              raw[j] == '{' || raw[j] == '}')) {
+      ++j;
+    }
+    if (j + 1 < raw.size() && raw[j] == '%' && is_digit((unsigned char)raw[j + 1])) return true;
+  }
+  return false;
+}
+
+void I18nEngine::render_template_body(const StyleCatalogSnapshot* style_state,
+                                      std::string_view raw,
+                                      ArgList args,
+                                      HtmlEmitState& emit,
+                                      std::string& out,
+                                      StyleCollector& styles,
+                                      ArgCache& arg_cache) {
+  ResolvePath path(arg_cache);
+  ScratchFrame frame(*this);
+  std::string& value = frame.take();
+
+  if (has_split_inline_token(raw)) {
+    resolve_template_placeholders(style_state, raw, args, path, 0, value);
+    for (size_t i = 0; i < value.size();) emit_html_unit(style_state, value, i, emit, out, &styles);
+    return;
+  }
+
+  for (size_t i = 0; i < raw.size();) {
+    if (raw[i] == '%' && i + 1 < raw.size() && is_digit((unsigned char)raw[i + 1])) {
+      size_t j = i + 1;
+      int idx = 0;
+      while (j < raw.size() && is_digit((unsigned char)raw[j])) {
+        idx = idx * 10 + (raw[j] - '0');
+        ++j;
+      }
+
+      value.clear();
+      if (idx >= 0 && (size_t)idx < args.size()) {
+        append_arg(style_state, args, (size_t)idx, path, 1, value);
+      } else {
+        value += "⟦arg:";
+        value += std::to_string(idx);
+        value += "⟧";
+      }
+      for (size_t k = 0; k < value.size();) emit_html_unit(style_state, value, k, emit, out, &styles);
+
+      i = j;
+      continue;
+    }
+
+    emit_html_unit(style_state, raw, i, emit, out, &styles);
   }
 }
 
@@ -793,35 +1630,137 @@ std::string I18nEngine::read_file_utf8(const char* path, std::string& err) {
   return ss.str();
 }
 
-const char* I18nEngine::get_last_error() const noexcept { return last_error.c_str(); }
+namespace {
+// last_error gilt pro Thread und Engine: Watcher-Thread und parallele Leser überschreiben sich nicht
+// gegenseitig die Meldung. Knoten sind stabil, c_str() bleibt bis zum nächsten Aufruf dieses Threads gültig.
+struct LastErrors {
+  std::unordered_map<uint64_t, std::string> by_engine;
+  uint64_t swept_frees = 0; // Stand von LiveEngines::frees beim letzten Aufräumen
+};
+thread_local LastErrors t_last_errors;
+
+// Eine freigegebene Engine erreicht die Maps fremder Threads nicht. Jeder Thread räumt daher beim
+// nächsten set_last_error selbst auf, wenn seitdem Engines freigegeben wurden: keine Map hält mehr
+// Einträge, als Engines leben.
+struct LiveEngines {
+  std::mutex mutex;
+  std::unordered_set<uint64_t> ids;
+  std::atomic<uint64_t> frees{ 0 };
+};
 
-const std::string& I18nEngine::get_meta_note() const noexcept { return meta_note; }
+LiveEngines& live_engines() {
+  static LiveEngines* live = new LiveEngines(); // nie zerstört: Engines können in statischen Destruktoren sterben
+  return *live;
+}
 
-void I18nEngine::set_last_error(std::string msg) { last_error = msg; }
+void sweep_last_errors() {
+  LiveEngines& live = live_engines();
+  const uint64_t frees = live.frees.load(std::memory_order_acquire);
+  if (frees == t_last_errors.swept_frees) return;
+  t_last_errors.swept_frees = frees;
+  auto& by_engine = t_last_errors.by_engine;
+  std::lock_guard<std::mutex> lock(live.mutex);
+  for (auto it = by_engine.begin(); it != by_engine.end();) {
+    it = live.ids.count(it->first) ? std::next(it) : by_engine.erase(it);
+  }
+}
+}
+
+uint64_t I18nEngine::next_instance_id() noexcept {
+  static std::atomic<uint64_t> next{ 1 };
+  const uint64_t id = next.fetch_add(1, std::memory_order_relaxed);
+  LiveEngines& live = live_engines();
+  std::lock_guard<std::mutex> lock(live.mutex);
+  live.ids.insert(id);
+  return id;
+}
+
+uint64_t I18nEngine::next_snapshot_generation() noexcept {
+  static std::atomic<uint64_t> next{ 1 };
+  return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+const char* I18nEngine::get_last_error() const noexcept {
+  auto it = t_last_errors.by_engine.find(instance_id);
+  return it != t_last_errors.by_engine.end() ? it->second.c_str() : "";
+}
+
+std::string I18nEngine::get_meta_note() const {
+  auto snapshot = acquire_snapshot();
+  return snapshot ? snapshot->meta_note : std::string();
+}
+
+void I18nEngine::set_last_error(std::string msg) {
+  sweep_last_errors();
+  t_last_errors.by_engine[instance_id] = std::move(msg);
+}
+
+void I18nEngine::clear_last_error() {
+  auto it = t_last_errors.by_engine.find(instance_id);
+  if (it != t_last_errors.by_engine.end()) it->second.clear();
+}
 
-void I18nEngine::clear_last_error() { last_error.clear(); }
+// Metadaten kommen aus dem aktiven Snapshot, damit ein Reload im Hintergrund sie nicht unter dem Leser austauscht.
+std::string I18nEngine::get_meta_locale() const {
+  auto snapshot = acquire_snapshot();
+  return snapshot ? snapshot->meta_locale : std::string();
+}
+
+std::string I18nEngine::get_meta_fallback() const {
+  auto snapshot = acquire_snapshot();
+  return snapshot ? snapshot->meta_fallback : std::string();
+}
 
-const std::string& I18nEngine::get_meta_locale() const noexcept { return meta_locale; }
-const std::string& I18nEngine::get_meta_fallback() const noexcept { return meta_fallback; }
-I18nEngine::PublicPluralRule I18nEngine::get_meta_plural_rule() const noexcept { return static_cast<PublicPluralRule>(meta_plural); }
+I18nEngine::PublicPluralRule I18nEngine::get_meta_plural_rule() const noexcept {
+  auto snapshot = acquire_snapshot();
+  return static_cast<PublicPluralRule>(snapshot ? snapshot->meta_plural : PluralRule::DEFAULT);
+}
 
-I18nEngine::NativeStyle I18nEngine::get_native_style(const std::string& style_token, const std::vector<std::string>& args) {
+I18nEngine::NativeStyle I18nEngine::get_native_style(std::string_view style_token, ArgList args) {
+  ScopedStat stat(*this, StatCall::NativeStyle);
   auto snapshot = acquire_snapshot();
   if (!snapshot) return {};
   auto style_snapshot = std::dynamic_pointer_cast<const StyleCatalogSnapshot>(snapshot);
   if (!style_snapshot) return {};
-  std::string normalized = to_lower_ascii(style_token);
-  auto it = style_snapshot->style_registry.find(normalized);
-  if (it == style_snapshot->style_registry.end()) return {};
-  return evaluate_native_style(it->second, style_snapshot.get(), args);
+  TraceScope span(*this, TraceKind::Call, "get_native_style", style_token, args.size(), style_snapshot.get());
+  ScratchFrame frame(*this);
+  std::string& token = frame.take();
+  append_lower_ascii(token, style_token);
+  return native_style_for(style_snapshot.get(), token, args);
+}
+
+I18nEngine::NativeStyle I18nEngine::native_style_for(const StyleCatalogSnapshot* style_state,
+                                                      const std::string& token,
+                                                      ArgList args) {
+  if (!style_state) return {};
+  auto it = style_state->style_registry.find(token);
+  if (it == style_state->style_registry.end()) return {};
+  return evaluate_native_style(it->second, style_state, args);
 }
 
 bool I18nEngine::load_txt_catalog(std::string src, bool strict) {
+  ScopedStat stat(*this, StatCall::Load);
   clear_last_error();
   if (src.empty()) { set_last_error("src is empty"); return false; }
+  const uint64_t sequence = begin_load(); // laufende asynchrone Ladevorgänge sind überholt
 
-  std::shared_ptr<CatalogSnapshot> snapshot;
   std::string err;
+  auto snapshot = build_snapshot_from_source(std::move(src), strict, err);
+  if (!snapshot) {
+    set_last_error(err);
+    return false;
+  }
+
+  if (!install_snapshot(snapshot, sequence)) {
+    set_last_error(SUPERSEDED_ERROR);
+    return false;
+  }
+  leave_locale_mode();
+  return true;
+}
+
+std::shared_ptr<I18nEngine::CatalogSnapshot> I18nEngine::build_snapshot_from_source(std::string src, bool strict, std::string& err) {
+  std::shared_ptr<CatalogSnapshot> snapshot;
   if (looks_like_binary_catalog(src)) {
     const uint8_t* data = reinterpret_cast<const uint8_t*>(src.data());
     snapshot = build_snapshot_from_binary(data, src.size(), strict, err);
@@ -829,47 +1768,46 @@ bool I18nEngine::load_txt_catalog(std::string src, bool strict) {
     strip_utf8_bom(src);
     snapshot = build_snapshot_from_text(std::move(src), strict, err);
   }
-
-  if (!snapshot) {
-    if (err.empty()) err = "Katalog konnte nicht geladen werden.";
-    set_last_error(err);
-    return false;
-  }
-
-  install_snapshot(snapshot);
-  return true;
+  if (!snapshot && err.empty()) err = "Katalog konnte nicht geladen werden.";
+  return snapshot;
 }
 
 std::shared_ptr<I18nEngine::CatalogSnapshot> I18nEngine::build_snapshot_from_text(std::string&& src, bool strict, std::string& err) {
+  ScopedStat parse_stat(*this, LoadPhase::Parse);
   err.clear();
   auto snapshot = std::make_shared<StyleCatalogSnapshot>();
+  snapshot->schema = std::atomic_load(&property_schema);
   size_t start = 0;
   size_t loaded = 0;
   int line_no = 0;
   bool meta_phase = true;
   bool seen_any_entry = false;
 
-  auto next_line = [&](std::string& out_line) -> bool {
+  auto next_line = [&](std::string_view& out_line) -> bool {
     if (start >= src.size()) return false;
     size_t end = src.find('\n', start);
     if (end == std::string::npos) end = src.size();
-    out_line = src.substr(start, end - start);
-    if (!out_line.empty() && out_line.back() == '\r') out_line.pop_back();
+    out_line = std::string_view(src).substr(start, end - start);
+    if (!out_line.empty() && out_line.back() == '\r') out_line.remove_suffix(1);
     start = (end < src.size()) ? end + 1 : src.size();
     return true;
   };
 
-  std::string line;
+  // Zeilen- und Byteanzahl sind obere Schranken für Einträge und Arena; einmal
+  // vorab reservieren statt beim Laden mehrfach umzukopieren.
+  snapshot->catalog.reserve((size_t)std::count(src.begin(), src.end(), '\n') + 1, src.size());
+
+  std::string token, label, text, parse_err;
+  std::string_view line;
   while (next_line(line)) {
     ++line_no;
-    std::string raw = line;
-    trim_inplace(raw);
+    const std::string_view raw = trim_view(line);
     if (raw.empty()) continue;
     if (raw[0] == '#') continue;
 
     if (meta_phase) {
       std::string key, value;
-      if (parse_meta_line(raw, key, value)) {
+      if (parse_meta_line(std::string(raw), key, value)) {
         if (seen_any_entry) {
           if (strict) {
             err = "Meta-Zeile nach Einträgen in Zeile " + std::to_string(line_no);
@@ -908,7 +1846,6 @@ std::shared_ptr<I18nEngine::CatalogSnapshot> I18nEngine::build_snapshot_from_tex
       meta_phase = false;
     }
 
-    std::string token, label, text, parse_err;
     const bool ok = parse_line(line, token, label, text, parse_err);
     if (!ok) {
       if (strict && !parse_err.empty()) {
@@ -918,19 +1855,15 @@ std::shared_ptr<I18nEngine::CatalogSnapshot> I18nEngine::build_snapshot_from_tex
       continue;
     }
 
-    std::string base_token = token;
-    std::string variant_token;
-    if (parse_variant_suffix(token, base_token, variant_token)) {
-      if (!variant_token.empty()) snapshot->plural_variants[base_token].insert(variant_token);
-    }
-
-    if (snapshot->catalog.find(token) != snapshot->catalog.end()) {
+    const FlatCatalog::Emplaced inserted = snapshot->catalog.emplace(token, text, label);
+    if (inserted == FlatCatalog::Emplaced::Duplicate) {
       err = "Doppelter Token in Zeile " + std::to_string(line_no) + ": " + token;
       return {};
     }
-
-    snapshot->catalog.emplace(token, std::move(text));
-    if (!label.empty()) snapshot->labels.emplace(token, std::move(label));
+    if (inserted == FlatCatalog::Emplaced::TooLarge) {
+      err = "Eintrag zu groß in Zeile " + std::to_string(line_no) + ": " + CATALOG_LIMIT_ERROR;
+      return {};
+    }
     ++loaded;
     seen_any_entry = true;
   }
@@ -940,11 +1873,24 @@ std::shared_ptr<I18nEngine::CatalogSnapshot> I18nEngine::build_snapshot_from_tex
     return {};
   }
 
-  populate_style_registry(snapshot.get());
+  parse_stat.stop();
+  finish_snapshot(snapshot.get());
   return snapshot;
 }
 
+void I18nEngine::finish_snapshot(StyleCatalogSnapshot* snapshot) {
+  {
+    ScopedStat stat(*this, LoadPhase::StyleRegistry);
+    populate_style_registry(snapshot);
+    compile_templates(snapshot);
+  }
+  ScopedStat stat(*this, LoadPhase::Index);
+  snapshot->refs = build_ref_index(snapshot->catalog);
+  bind_entries(snapshot);
+}
+
 std::shared_ptr<I18nEngine::CatalogSnapshot> I18nEngine::build_snapshot_from_binary(const uint8_t* data, size_t size, bool strict, std::string& err) {
+  ScopedStat parse_stat(*this, LoadPhase::Parse);
   err.clear();
   if (size < BINARY_HEADER_SIZE_V1) {
     err = "Binär-Format: Header zu kurz.";
@@ -979,6 +1925,7 @@ std::shared_ptr<I18nEngine::CatalogSnapshot> I18nEngine::build_snapshot_from_bin
   }
 
   auto snapshot = std::make_shared<StyleCatalogSnapshot>();
+  snapshot->schema = std::atomic_load(&property_schema);
   snapshot->meta_plural = PluralRule::DEFAULT;
   if (plural_rule <= static_cast<uint8_t>(PluralRule::ARABIC)) {
     snapshot->meta_plural = static_cast<PluralRule>(plural_rule);
@@ -1109,22 +2056,23 @@ struct EntryInfo {
     }
 
     const char* text_ptr = reinterpret_cast<const char*>(data + strings_base + entry.text_offset);
-    std::string value(text_ptr, entry.text_length);
 
     std::string key = entry.base;
     if (!entry.variant.empty()) {
       key += '{';
       key += entry.variant;
       key += '}';
-      snapshot->plural_variants[entry.base].insert(entry.variant);
     }
 
-    if (snapshot->catalog.find(key) != snapshot->catalog.end()) {
+    const FlatCatalog::Emplaced inserted = snapshot->catalog.emplace(key, std::string_view(text_ptr, entry.text_length));
+    if (inserted == FlatCatalog::Emplaced::Duplicate) {
       err = "Binär-Format: Doppelte Einträge.";
       return {};
     }
-
-    snapshot->catalog.emplace(std::move(key), std::move(value));
+    if (inserted == FlatCatalog::Emplaced::TooLarge) {
+      err = std::string("Binär-Format: ") + CATALOG_LIMIT_ERROR;
+      return {};
+    }
   }
 
   if (snapshot->catalog.empty()) {
@@ -1132,19 +2080,27 @@ struct EntryInfo {
     return {};
   }
 
-  populate_style_registry(snapshot.get());
+  parse_stat.stop();
+  finish_snapshot(snapshot.get());
   return snapshot;
 }
 
-void I18nEngine::install_snapshot(std::shared_ptr<CatalogSnapshot> snapshot) {
-  if (!snapshot) return;
-  meta_locale = snapshot->meta_locale;
-  meta_fallback = snapshot->meta_fallback;
-  meta_note = snapshot->meta_note;
-  meta_plural = snapshot->meta_plural;
-  std::atomic_store_explicit(&active_snapshot,
-                             std::static_pointer_cast<const CatalogSnapshot>(snapshot),
-                             std::memory_order_release);
+bool I18nEngine::install_snapshot(std::shared_ptr<const CatalogSnapshot> snapshot, uint64_t sequence,
+                                  const LoadSource* source) {
+  if (!snapshot) return false;
+  ScopedStat stat(*this, LoadPhase::Install); // inklusive Sperre und Freigabe des abgelösten Snapshots
+  std::lock_guard<std::mutex> lock(install_mutex);
+  // Prüfen und Tauschen unter derselben Sperre: ein überholter Auftrag kann nicht mehr dazwischenfunken.
+  if (sequence != load_sequence.load(std::memory_order_acquire)) return false;
+  snapshot = with_current_schema(std::move(snapshot));
+  if (source) current_source = *source;
+  std::atomic_store_explicit(&active_snapshot, std::move(snapshot), std::memory_order_release);
+  return true;
+}
+
+I18nEngine::LoadSource I18nEngine::loaded_source() {
+  std::lock_guard<std::mutex> lock(install_mutex);
+  return current_source;
 }
 
 std::shared_ptr<const I18nEngine::CatalogSnapshot> I18nEngine::acquire_snapshot() const noexcept {
@@ -1159,365 +2115,2007 @@ bool I18nEngine::is_binary_catalog_path(const std::string& path) noexcept {
   return ext == ".i18n" || ext == ".bin";
 }
 
+std::shared_ptr<I18nEngine::CatalogSnapshot> I18nEngine::build_snapshot_from_file(const std::string& path, bool strict,
+                                                                               std::string& err) {
+  err.clear();
+  ScopedStat read_stat(*this, LoadPhase::Read);
+  if (is_binary_catalog_path(path)) {
+    FileMapping mapping;
+    if (!mapping.map(std::filesystem::path(path), err)) return nullptr;
+    read_stat.stop();
+    return build_snapshot_from_binary(reinterpret_cast<const uint8_t*>(mapping.data), mapping.size, strict, err);
+  }
+  std::string data = read_file_utf8(path.c_str(), err);
+  if (!err.empty()) return nullptr;
+  strip_utf8_bom(data);
+  read_stat.stop();
+  return build_snapshot_from_text(std::move(data), strict, err);
+}
+
 bool I18nEngine::load_txt_file(const char* path, bool strict) {
+  ScopedStat stat(*this, StatCall::Load);
+  return load_file(path, strict);
+}
+
+bool I18nEngine::load_file(const char* path, bool strict) {
   clear_last_error();
   if (!path) { set_last_error("path == nullptr"); return false; }
+  const uint64_t sequence = begin_load(); // laufende asynchrone Ladevorgänge sind überholt
 
   std::string err;
-  std::shared_ptr<CatalogSnapshot> snapshot;
-  const std::string path_str = path;
-
-  if (is_binary_catalog_path(path_str)) {
-    FileMapping mapping;
-    if (!mapping.map(std::filesystem::path(path_str), err)) {
-      set_last_error(err);
-      return false;
-    }
-    snapshot = build_snapshot_from_binary(reinterpret_cast<const uint8_t*>(mapping.data), mapping.size, strict, err);
-    if (!snapshot) {
-      set_last_error(err);
-      return false;
-    }
-  } else {
-    std::string data = read_file_utf8(path, err);
-    if (!err.empty()) { set_last_error(err); return false; }
-    strip_utf8_bom(data);
-    snapshot = build_snapshot_from_text(std::move(data), strict, err);
-    if (!snapshot) {
-      set_last_error(err);
-      return false;
-    }
+  auto snapshot = build_snapshot_from_file(path, strict, err);
+  if (!snapshot) {
+    set_last_error(err);
+    return false;
   }
 
-  current_path = path;
-  current_strict = strict;
-  install_snapshot(snapshot);
+  const LoadSource source{ path, strict };
+  if (!install_snapshot(snapshot, sequence, &source)) {
+    set_last_error(SUPERSEDED_ERROR);
+    return false;
+  }
+  leave_locale_mode();
   return true;
 }
 
 bool I18nEngine::reload() {
-  if (current_path.empty()) { set_last_error("No file loaded yet"); return false; }
+  ScopedStat stat(*this, StatCall::Reload);
   // Nutzt den gespeicherten Pfad und Strict-Mode
-  return load_txt_file(current_path.c_str(), current_strict);
+  const LoadSource source = loaded_source();
+  if (source.path.empty()) { set_last_error("No file loaded yet"); return false; }
+  return load_file(source.path.c_str(), source.strict);
 }
-
-std::string I18nEngine::translate(const std::string& token_in, const std::vector<std::string>& args) {
-  auto snapshot = acquire_snapshot();
-  if (!snapshot) return "⟦NO_CATALOG⟧";
-  std::string token = to_lower_ascii(token_in);
-  std::unordered_set<std::string> seen;
-  return translate_impl(snapshot.get(), token, args, seen, 0);
+
+bool I18nEngine::add_locale_file(const std::string& name, const std::string& path, bool strict) {
+  clear_last_error();
+  std::string err;
+  auto snapshot = build_snapshot_from_file(path, strict, err);
+  if (!snapshot) {
+    set_last_error(err);
+    return false;
+  }
+  return add_locale(name, std::move(snapshot));
 }
 
-std::string I18nEngine::render_to_html(const std::string& template_token, const std::vector<std::string>& args) {
-  auto snapshot = acquire_snapshot();
-  if (!snapshot) return {};
-  auto style_snapshot = std::dynamic_pointer_cast<const StyleCatalogSnapshot>(snapshot);
-  if (!style_snapshot) return {};
-  std::string normalized = to_lower_ascii(template_token);
-  auto it = style_snapshot->catalog.find(normalized);
-  if (it == style_snapshot->catalog.end()) return {};
+bool I18nEngine::add_locale_txt(const std::string& name, std::string src, bool strict) {
+  clear_last_error();
+  if (src.empty()) { set_last_error("src is empty"); return false; }
+  std::string err;
+  auto snapshot = build_snapshot_from_source(std::move(src), strict, err);
+  if (!snapshot) {
+    set_last_error(err);
+    return false;
+  }
+  return add_locale(name, std::move(snapshot));
+}
 
-  std::unordered_set<std::string> seen;
-  std::string resolved = resolve_template_placeholders(style_snapshot.get(), it->second, args, seen, 0);
+bool I18nEngine::add_locale(std::string name, std::shared_ptr<CatalogSnapshot> snapshot) {
+  if (name.empty()) name = snapshot->meta_locale;
+  if (name.empty()) { set_last_error("Locale ohne Namen und ohne @meta locale."); return false; }
+
+  std::lock_guard<std::mutex> lock(locale_mutex);
+  std::shared_ptr<const CatalogSnapshot> previous = std::exchange(locales[name].own, std::move(snapshot));
+  if (!rebuild_locale_views(name)) {
+    // Eine zusammengeführte Sicht sprengt die Arena: vorherigen Stand wiederherstellen.
+    if (previous) locales[name].own = std::move(previous);
+    else locales.erase(name);
+    rebuild_locale_views(name);
+    set_last_error(std::string("Locale-Sicht zu groß: ") + CATALOG_LIMIT_ERROR);
+    return false;
+  }
+  // Ersetzte Locale in der aktiven Kette: neue Sicht sofort aktivieren.
+  const auto active = locales.find(current_locale);
+  if (active != locales.end() &&
+      std::find(active->second.chain.begin(), active->second.chain.end(), name) != active->second.chain.end()) {
+    // Nur ein Ladeauftrag, der inzwischen begonnen hat, kann hier verdrängen; der gewinnt dann.
+    install_snapshot(active->second.merged, begin_load());
+  }
+  return true;
+}
 
-  auto style_tokens = gather_style_tokens(resolved);
+bool I18nEngine::set_locale(const std::string& name) {
+  clear_last_error();
+  std::lock_guard<std::mutex> lock(locale_mutex);
+  const std::string resolved = resolve_locale_name(name);
+  if (resolved.empty()) {
+    set_last_error("Unbekannte Locale: " + name);
+    return false;
+  }
+  // laufende asynchrone Ladevorgänge sind überholt
+  if (!install_snapshot(locales.at(resolved).merged, begin_load())) {
+    set_last_error(SUPERSEDED_ERROR);
+    return false;
+  }
+  current_locale = resolved;
+  return true;
+}
 
-  std::string style_defs;
-  build_style_definitions(style_snapshot.get(), style_tokens, args, style_defs);
+std::vector<std::string> I18nEngine::locale_chain() const {
+  std::lock_guard<std::mutex> lock(locale_mutex);
+  if (current_locale.empty()) return {};
+  return locales.at(current_locale).chain;
+}
 
-  for (const auto& token : style_tokens) {
-    std::string placeholder = "@" + token;
-    replace_all(resolved, placeholder, sanitize_css_class(token));
-  }
+// Ein einzeln geladener Katalog ersetzt die Locale-Sicht; spätere add_locale-Aufrufe installieren nichts mehr.
+void I18nEngine::leave_locale_mode() {
+  std::lock_guard<std::mutex> lock(locale_mutex);
+  current_locale.clear();
+}
 
-  if (!style_defs.empty()) {
-    return "<style>\n" + style_defs + "</style>\n" + resolved;
+// Erwartet locale_mutex. Exakter Name, sonst erste Locale derselben Sprache.
+std::string I18nEngine::resolve_locale_name(const std::string& requested) const {
+  if (requested.empty()) return {};
+  if (locales.count(requested)) return requested;
+  auto language = [](const std::string& name) {
+    return to_lower_ascii(name.substr(0, name.find_first_of("_-")));
+  };
+  const std::string wanted = language(requested);
+  for (const auto& kv : locales) {
+    if (language(kv.first) == wanted) return kv.first;
   }
-  return resolved;
+  return {};
 }
 
-std::string I18nEngine::get_physics_json_for_template(const std::string& template_token,
-                                                      const std::vector<std::string>& args) {
-  return get_physics_json_from_template(template_token, args);
+// Erwartet locale_mutex. Baut jede Sicht neu, deren Kette sich geändert hat oder changed enthält;
+// false, wenn eine Sicht die Grenzen von FlatCatalog sprengt.
+bool I18nEngine::rebuild_locale_views(const std::string& changed) {
+  for (auto& kv : locales) {
+    std::vector<std::string> chain{ kv.first };
+    const CatalogSnapshot* current = kv.second.own.get();
+    while (true) {
+      const std::string next = resolve_locale_name(current->meta_fallback);
+      if (next.empty() || std::find(chain.begin(), chain.end(), next) != chain.end()) break;
+      chain.push_back(next);
+      current = locales.at(next).own.get();
+    }
+    const bool affected = std::find(chain.begin(), chain.end(), changed) != chain.end();
+    if (kv.second.merged && !affected && chain == kv.second.chain) continue;
+    auto merged = merge_locale_chain(chain);
+    if (!merged) return false;
+    kv.second.merged = std::move(merged);
+    kv.second.chain = std::move(chain);
+  }
+  return true;
 }
 
-std::string I18nEngine::translate_plural(const std::string& token_in,
-                                         int count,
-                                         const std::vector<std::string>& args) {
-  auto snapshot = acquire_snapshot();
-  if (!snapshot) return "⟦NO_CATALOG⟧";
-  std::string normalized = to_lower_ascii(token_in);
-  std::string base;
-  std::string variant;
-  std::string lookup;
-  if (parse_variant_suffix(normalized, base, variant) && !variant.empty()) {
-    lookup = base + "{" + variant + "}";
-  } else {
-    base = normalized;
-    const std::string desired = base + "{" + pick_variant_name(meta_plural, count) + "}";
-    if (snapshot->catalog.find(desired) != snapshot->catalog.end()) {
-      lookup = desired;
-    } else if (snapshot->catalog.find(base + "{other}") != snapshot->catalog.end()) {
-      lookup = base + "{other}";
-    } else {
-      const auto it = snapshot->plural_variants.find(base);
-      if (it != snapshot->plural_variants.end() && !it->second.empty()) {
-        lookup = base + '{' + *it->second.begin() + '}';
-      } else {
-        lookup = base;
+// Erwartet locale_mutex. Frühere Locales gewinnen; Pluralfamilien werden nie über Locales gemischt.
+std::shared_ptr<I18nEngine::CatalogSnapshot> I18nEngine::merge_locale_chain(const std::vector<std::string>& chain) {
+  auto merged = std::make_shared<StyleCatalogSnapshot>();
+  merged->schema = std::atomic_load(&property_schema);
+  const CatalogSnapshot& primary = *locales.at(chain.front()).own;
+  merged->meta_locale = primary.meta_locale.empty() ? chain.front() : primary.meta_locale;
+  merged->meta_fallback = primary.meta_fallback;
+  merged->meta_note = primary.meta_note;
+  merged->meta_plural = primary.meta_plural;
+
+  size_t entries = 0, bytes = 0;
+  for (const auto& name : chain) {
+    entries += locales.at(name).own->catalog.size();
+    bytes += locales.at(name).own->catalog.arena_bytes();
+  }
+  merged->catalog.reserve(entries, bytes);
+
+  std::unordered_set<std::string> owned_families;
+  std::string base, variant;
+  for (const auto& name : chain) {
+    const CatalogSnapshot& layer = *locales.at(name).own;
+    std::vector<std::string> layer_families;
+    for (auto it = layer.catalog.begin(); it != layer.catalog.end(); ++it) {
+      if (merged->catalog.count(it->first)) continue;
+      if (parse_variant_suffix(it->first, base, variant)) {
+        if (owned_families.count(base)) continue;
+        layer_families.push_back(base);
       }
+      if (merged->catalog.emplace(it->first, it->second, it.label()) == FlatCatalog::Emplaced::TooLarge) return nullptr;
     }
+    owned_families.insert(layer_families.begin(), layer_families.end());
   }
 
-  std::unordered_set<std::string> seen;
-  return translate_impl(snapshot.get(), lookup, args, seen, 0);
+  finish_snapshot(merged.get());
+  return merged;
 }
-
-std::string I18nEngine::dump_table() const {
-  auto snapshot = acquire_snapshot();
-  if (!snapshot) return "Catalog not loaded\n";
-  const auto& catalog = snapshot->catalog;
-  const auto& labels = snapshot->labels;
-
-  std::string out;
-  out.reserve(catalog.size() * 64);
-  out += "Token        | Label                  | Inhalt\n";
-  out += "------------------------------------------------------------\n";
 
-  std::vector<std::string> keys;
-  keys.reserve(catalog.size());
-  for (const auto& kv : catalog) keys.push_back(kv.first);
-  std::sort(keys.begin(), keys.end());
+bool I18nEngine::share_catalog(const I18nEngine& source) {
+  clear_last_error();
+  auto snapshot = source.acquire_snapshot();
+  if (!snapshot) { set_last_error("Quell-Engine hat keinen Katalog geladen."); return false; }
+  // Schema mitnehmen, damit die Property-IDs der geteilten Style-Registry hier gleich bedeuten.
+  auto style = std::dynamic_pointer_cast<const StyleCatalogSnapshot>(snapshot);
+  if (style && style->schema) std::atomic_store(&property_schema, style->schema);
+  // laufende asynchrone Ladevorgänge sind überholt
+  if (!install_snapshot(std::move(snapshot), begin_load())) {
+    set_last_error(SUPERSEDED_ERROR);
+    return false;
+  }
+  leave_locale_mode();
+  return true;
+}
 
-  for (const auto& token : keys) {
-    const std::string& text = catalog.at(token);
-    auto itL = labels.find(token);
-    const std::string label = (itL != labels.end()) ? itL->second : "";
+bool I18nEngine::push_overlay_txt(std::string src, bool strict) {
+  clear_last_error();
+  if (src.empty()) { set_last_error("src is empty"); return false; }
+  std::string err;
+  auto delta = build_snapshot_from_source(std::move(src), strict, err);
+  if (!delta) {
+    set_last_error(err);
+    return false;
+  }
+  return push_overlay(std::move(delta));
+}
 
-    out += token;
-    if (token.size() < 12) out.append(12 - token.size(), ' ');
-    out += " | ";
+bool I18nEngine::push_overlay_file(const std::string& path, bool strict) {
+  clear_last_error();
+  std::string err;
+  auto delta = build_snapshot_from_file(path, strict, err);
+  if (!delta) {
+    set_last_error(err);
+    return false;
+  }
+  return push_overlay(std::move(delta));
+}
 
-    out += label;
-    if (label.size() < 22) out.append(22 - label.size(), ' ');
-    out += " | ";
+bool I18nEngine::push_overlay(std::shared_ptr<CatalogSnapshot> delta) {
+  const uint64_t sequence = begin_load();
+  auto base = std::dynamic_pointer_cast<const StyleCatalogSnapshot>(acquire_snapshot());
+  if (!base) { set_last_error("Kein Basis-Katalog geladen."); return false; }
+  auto snapshot = build_overlay_snapshot(std::move(base), *delta);
+  if (!snapshot) { set_last_error(std::string("Overlay zu groß: ") + CATALOG_LIMIT_ERROR); return false; }
+  if (!install_snapshot(std::move(snapshot), sequence)) {
+    set_last_error("Katalog wurde währenddessen neu geladen.");
+    return false;
+  }
+  return true;
+}
 
-    out += text;
-    out += "\n";
+bool I18nEngine::pop_overlay() {
+  clear_last_error();
+  const uint64_t sequence = begin_load();
+  auto snapshot = acquire_snapshot();
+  if (!snapshot || !snapshot->base) { set_last_error("Kein Overlay aktiv."); return false; }
+  if (!install_snapshot(snapshot->base, sequence)) {
+    set_last_error("Katalog wurde währenddessen neu geladen.");
+    return false;
   }
+  return true;
+}
 
-  return out;
+size_t I18nEngine::overlay_depth() const {
+  size_t depth = 0;
+  auto snapshot = acquire_snapshot();
+  for (const CatalogSnapshot* layer = snapshot.get(); layer && layer->base; layer = layer->base.get()) ++depth;
+  return depth;
 }
-
-std::string I18nEngine::find_any(const std::string& query) const {
-  std::string q = query;
-  for (char& c : q) c = (char)std::tolower((unsigned char)c);
 
-  std::string out;
+namespace {
 
-  // Determinismus: Sortiere Keys
-  auto snapshot = acquire_snapshot();
-  if (!snapshot) return "(no catalog loaded)\n";
-  const auto& catalog = snapshot->catalog;
-  const auto& labels = snapshot->labels;
-
-  std::vector<std::string> keys;
-  keys.reserve(catalog.size());
-  for (const auto& kv : catalog) keys.push_back(kv.first);
-  std::sort(keys.begin(), keys.end());
-
-  for (const auto& token : keys) {
-    const std::string& text = catalog.at(token);
-
-    std::string t = text;
-    for (char& c : t) c = (char)std::tolower((unsigned char)c);
-
-    std::string lbl;
-    auto itL = labels.find(token);
-    if (itL != labels.end()) lbl = itL->second;
-    std::string l = lbl;
-    for (char& c : l) c = (char)std::tolower((unsigned char)c);
-
-    if (t.find(q) != std::string::npos || (!l.empty() && l.find(q) != std::string::npos)) {
-      out += token;
-      out += "(";
-      out += lbl;
-      out += "): ";
-      out += text;
-      out += "\n";
-    }
-  }
-
-  if (out.empty()) out = "(keine Treffer)\n";
-  return out;
-}
-
-std::string I18nEngine::check_catalog_report(int& out_code) const {
-  out_code = 0;
+// Heap-Anteil eines Strings; kurze Strings liegen im Objekt selbst (SSO).
+size_t heap_bytes(const std::string& s) noexcept {
+  const char* self = reinterpret_cast<const char*>(&s);
+  const bool inline_buffer = s.data() >= self && s.data() < self + sizeof(s);
+  return inline_buffer ? 0 : s.capacity() + 1;
+}
 
-  auto snapshot = acquire_snapshot();
-  if (!snapshot) {
-    out_code = 2;
-    return "CHECK: FAIL\nGrund: Katalog ist leer oder nicht geladen.\n";
-  }
+template <typename T>
+size_t heap_bytes(const std::vector<T>& v) noexcept { return v.capacity() * sizeof(T); }
 
-  const auto& catalog = snapshot->catalog;
+constexpr size_t heap_bytes(uint32_t) noexcept { return 0; } // Entry-IDs als Map-Schlüssel
 
-  if (catalog.empty()) {
-    out_code = 2;
-    return "CHECK: FAIL\nGrund: Katalog ist leer oder nicht geladen.\n";
+// Bucket-Array plus je Knoten Wert, next-Zeiger und gecachter Hash; value_bytes liefert den Heap des Werts.
+template <typename Map, typename Fn>
+size_t map_bytes(const Map& map, Fn&& value_bytes) {
+  size_t bytes = map.bucket_count() * sizeof(void*);
+  for (const auto& kv : map) {
+    bytes += sizeof(typename Map::value_type) + 2 * sizeof(void*) + heap_bytes(kv.first) + value_bytes(kv.second);
   }
+  return bytes;
+}
 
-  size_t warnings = 0;
-  size_t errors = 0;
+} // namespace
 
-  std::string report;
-  report.reserve(catalog.size() * 96);
-  report += "CHECK: REPORT\n";
-  report += "------------------------------\n";
-
-  auto scan_placeholders = [](const std::string& s, std::vector<int>& idxs) -> bool {
-    idxs.clear();
-    for (size_t i = 0; i < s.size();) {
-      if (s[i] == '%' && i + 1 < s.size() && std::isdigit((unsigned char)s[i + 1])) {
-        size_t j = i + 1;
-        int idx = 0;
-        while (j < s.size() && std::isdigit((unsigned char)s[j])) {
-          if (idx > 1000000) idx = 1000000;
-          else idx = idx * 10 + (s[j] - '0');
-          ++j;
-        }
-        idxs.push_back(idx);
-        i = j;
-        continue;
-      }
-      ++i;
-    }
-    if (idxs.empty()) return false;
-    std::sort(idxs.begin(), idxs.end());
-    idxs.erase(std::unique(idxs.begin(), idxs.end()), idxs.end());
-    return true;
-  };
-
-  std::vector<int> idxs;
-  std::vector<std::string> refs;
-  std::unordered_map<std::string, std::vector<std::string>> edges;
-  edges.reserve(catalog.size());
-
-  for (const auto& kv : catalog) {
-    const std::string& token = kv.first;
-    const std::string& text  = kv.second;
-
-    if (scan_placeholders(text, idxs)) {
-      bool gap = false;
-      int expect = 0;
-      for (int got : idxs) { if (got != expect) { gap = true; break; } ++expect; }
-      if (gap) {
-        ++warnings;
-        report += "WARN "; report += token;
-        report += ": Placeholder-Lücke. Gefunden: ";
-        for (size_t i = 0; i < idxs.size(); ++i) {
-          report += "%"; report += std::to_string(idxs[i]);
-          if (i + 1 < idxs.size()) report += ", ";
-        }
-        report += "\n";
-      }
-    }
-
-    scan_inline_refs(text, refs);
-    if (!refs.empty()) edges.emplace(token, refs);
-
-    for (const auto& r : refs) {
-      if (catalog.find(r) == catalog.end()) {
-        ++errors;
-        report += "ERROR "; report += token;
-        report += ": Missing inline ref @"; report += r;
-        report += "\n";
-      }
-    }
-  }
-
-  enum class Color : unsigned char { White, Gray, Black };
-  std::unordered_map<std::string, Color> color;
-  color.reserve(catalog.size());
-  for (const auto& kv : catalog) color.emplace(kv.first, Color::White);
-
-  std::vector<std::string> stack;
-  stack.reserve(64);
-
-  auto dump_cycle = [&](const std::string& start) {
-    auto it = std::find(stack.begin(), stack.end(), start);
-    report += "ERROR CYCLE: ";
-    if (it == stack.end()) { report += start; report += "\n"; return; }
-    for (; it != stack.end(); ++it) {
-      report += *it;
-      report += " -> ";
-    }
-    report += start;
-    report += "\n";
-  };
-
-  std::function<void(const std::string&)> dfs = [&](const std::string& u) {
-    color[u] = Color::Gray;
-    stack.push_back(u);
-
-    auto itE = edges.find(u);
-    if (itE != edges.end()) {
-      for (const auto& v : itE->second) {
-        if (catalog.find(v) == catalog.end()) continue;
-        auto cv = color[v];
-        if (cv == Color::White) dfs(v);
-        else if (cv == Color::Gray) { ++errors; dump_cycle(v); }
-      }
-    }
-
-    stack.pop_back();
-    color[u] = Color::Black;
-  };
-
-  for (const auto& kv : catalog) {
-    const auto& tok = kv.first;
-    if (color[tok] == Color::White) dfs(tok);
+void I18nEngine::account_snapshot(const CatalogSnapshot* snapshot, MemoryStats& out) {
+  out.entries = snapshot->catalog.size();
+  out.arena = snapshot->catalog.arena_bytes();
+  out.table = snapshot->catalog.table_bytes();
+  // Ein vom Overlay unverändert übernommener RefIndex gehört der Basis, ebenso der volle Index unter einer Ebene.
+  if (snapshot->refs && !(snapshot->base && snapshot->refs == snapshot->base->refs)) {
+    const RefIndex& refs = *snapshot->refs;
+    out.ref_index = heap_bytes(refs.tokens) + heap_bytes(refs.fwd_offsets) + heap_bytes(refs.fwd_edges) +
+                    heap_bytes(refs.rev_offsets) + heap_bytes(refs.rev_edges) + heap_bytes(refs.missing_offsets) +
+                    heap_bytes(refs.missing_tokens) + heap_bytes(refs.missing_order) + heap_bytes(refs.added_order);
+    for (const auto& token : refs.missing_tokens) out.ref_index += heap_bytes(token);
+    out.ref_index += map_bytes(refs.rows, [](const RefIndex::Row& row) {
+      size_t bytes = heap_bytes(row.refs) + heap_bytes(row.missing);
+      for (const auto& token : row.missing) bytes += heap_bytes(token);
+      return bytes;
+    });
+    out.ref_index += map_bytes(refs.rev_rows, [](const std::vector<uint32_t>& srcs) { return heap_bytes(srcs); });
   }
-
-  report += "------------------------------\n";
-  report += "Tokens: "; report += std::to_string(catalog.size()); report += "\n";
-  report += "Warnings: "; report += std::to_string(warnings); report += "\n";
-  report += "Errors: "; report += std::to_string(errors); report += "\n";
-
-  if (errors > 0) {
-    report += "CHECK: FAIL\n";
-    out_code = 3;
-  } else if (warnings > 0) {
-    report += "CHECK: OK (mit Warnungen)\n";
-    out_code = 0;
-  } else {
-    report += "CHECK: OK\n";
-    out_code = 0;
-  }
-
-  return report;
+  if (snapshot->entries && !(snapshot->base && snapshot->entries == snapshot->base->entries)) {
+    out.entry_refs = heap_bytes(*snapshot->entries);
+  }
+  out.entry_refs += map_bytes(snapshot->entry_overrides, [](const EntryRef&) { return size_t(0); });
+  if (snapshot->search && snapshot->search->built.load(std::memory_order_acquire)) {
+    const SearchIndex& search = *snapshot->search->index;
+    out.search = heap_bytes(search.folded) + heap_bytes(search.folded_offsets) + heap_bytes(search.label_offsets) +
+                 heap_bytes(search.trigram_keys) + heap_bytes(search.posting_offsets) + heap_bytes(search.postings);
+  }
+  if (const auto* style = dynamic_cast<const StyleCatalogSnapshot*>(snapshot)) {
+    out.style_registry = map_bytes(style->style_registry.own(), [](const std::vector<StyleProperty>& props) {
+      size_t bytes = heap_bytes(props);
+      for (const auto& prop : props) bytes += heap_bytes(prop.prop_name) + heap_bytes(prop.value);
+      return bytes;
+    });
+    out.style_info = map_bytes(style->style_info.own(), [](const StyleInfo& info) { return heap_bytes(info.css_class); });
+    out.templates = map_bytes(style->templates.own(), [](const CompiledTemplate& tpl) {
+      size_t bytes = heap_bytes(tpl.segments) + heap_bytes(tpl.style_manifest) + heap_bytes(tpl.arg_indices) +
+                     heap_bytes(tpl.physics_json) + heap_bytes(tpl.physics_msgpack);
+      for (const auto& seg : tpl.segments) bytes += heap_bytes(seg.text);
+      for (const auto& entry : tpl.style_manifest) bytes += heap_bytes(entry.token) + heap_bytes(entry.definition);
+      return bytes;
+    });
+  }
+  out.total = out.arena + out.table + out.ref_index + out.entry_refs + out.search +
+              out.style_registry + out.style_info + out.templates;
 }
 
-bool I18nEngine::looks_like_binary_catalog(const std::string& data) noexcept {
-  if (data.size() < BINARY_HEADER_SIZE_V1) return false;
-  if (std::memcmp(data.data(), BINARY_MAGIC, 4) != 0) return false;
-  const uint8_t version = static_cast<uint8_t>(data[4]);
-  return version == BINARY_VERSION_V1 || version == BINARY_VERSION;
+I18nEngine::MemoryStats I18nEngine::memory_stats() const {
+  MemoryStats stats;
+  auto snapshot = acquire_snapshot();
+  if (!snapshot) return stats;
+  account_snapshot(snapshot.get(), stats);
+  for (const CatalogSnapshot* layer = snapshot->base.get(); layer; layer = layer->base.get()) {
+    MemoryStats base;
+    account_snapshot(layer, base);
+    stats.shared_base += base.total;
+  }
+  return stats;
+}
+
+namespace {
+
+constexpr const char* STAT_CALL_NAMES[] = { "translate", "translate_plural", "render_to_html", "get_native_style",
+                                            "load", "reload" };
+constexpr const char* STAT_EVENT_NAMES[] = { "cache_hit", "cache_miss", "missing", "cycle", "recursion_limit",
+                                             "result_too_large", "scratch_resize" };
+constexpr const char* LOAD_PHASE_NAMES[] = { "read", "parse", "style_registry", "index", "install" };
+
+// Obergrenze von Latenz-Bucket k; der letzte Bucket sammelt alles darüber.
+constexpr uint64_t latency_bound_ns(size_t bucket) noexcept { return uint64_t(256) << bucket; }
+
+void append_uint(std::string& out, uint64_t value) {
+  char buf[24];
+  const auto res = std::to_chars(buf, buf + sizeof(buf), value);
+  out.append(buf, res.ptr);
+}
+
+// Nanosekunden als Sekunden mit neun Nachkommastellen, exakt und locale-unabhängig.
+void append_seconds(std::string& out, uint64_t ns) {
+  append_uint(out, ns / 1000000000u);
+  char frac[10];
+  uint64_t rest = ns % 1000000000u;
+  for (int i = 8; i >= 0; --i, rest /= 10) frac[i] = (char)('0' + rest % 10);
+  frac[9] = '\0';
+  out += '.';
+  out += frac;
+}
+
+} // namespace
+
+I18nEngine::StatsShard& I18nEngine::stats_shard() const noexcept {
+  static std::atomic<size_t> next_shard{ 0 };
+  thread_local const size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % STATS_SHARDS;
+  return stats_shards[shard];
+}
+
+void I18nEngine::count_event(StatEvent event) noexcept {
+  stats_shard().events[(size_t)event].fetch_add(1, std::memory_order_relaxed);
+}
+
+I18nEngine::ScopedStat::ScopedStat(I18nEngine& engine, StatCall call) noexcept
+    : engine_(engine), phase_(false), slot_((uint8_t)call) {
+  thread_local uint32_t tick = 0;
+  timed_ = call == StatCall::Load || call == StatCall::Reload || tick++ % LATENCY_SAMPLE_EVERY == 0;
+  if (timed_) start_ = std::chrono::steady_clock::now();
+}
+
+I18nEngine::ScopedStat::ScopedStat(I18nEngine& engine, LoadPhase phase) noexcept
+    : engine_(engine), phase_(true), slot_((uint8_t)phase), start_(std::chrono::steady_clock::now()) {}
+
+void I18nEngine::ScopedStat::stop() noexcept {
+  if (!running_) return;
+  running_ = false;
+  StatsShard& shard = engine_.stats_shard();
+  if (!phase_) shard.calls[slot_].fetch_add(1, std::memory_order_relaxed);
+  if (!timed_) return;
+  const uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start_).count();
+  if (phase_) {
+    shard.phase_runs[slot_].fetch_add(1, std::memory_order_relaxed);
+    shard.phase_ns[slot_].fetch_add(ns, std::memory_order_relaxed);
+    engine_.last_phase_ns[slot_].store(ns, std::memory_order_relaxed);
+    return;
+  }
+  size_t bucket = 0;
+  while (bucket + 1 < LATENCY_BUCKETS && ns > latency_bound_ns(bucket)) ++bucket;
+  shard.timed[slot_].fetch_add(1, std::memory_order_relaxed);
+  shard.call_ns[slot_].fetch_add(ns, std::memory_order_relaxed);
+  shard.latency[slot_][bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+I18nEngine::StatsTotals I18nEngine::collect_stats() const {
+  StatsTotals totals;
+  auto add = [](uint64_t& total, const std::atomic<uint64_t>& v) { total += v.load(std::memory_order_relaxed); };
+  for (const auto& shard : stats_shards) {
+    for (size_t call = 0; call < STAT_CALLS; ++call) {
+      add(totals.calls[call], shard.calls[call]);
+      add(totals.timed[call], shard.timed[call]);
+      add(totals.call_ns[call], shard.call_ns[call]);
+      for (size_t bucket = 0; bucket < LATENCY_BUCKETS; ++bucket) {
+        add(totals.latency[call][bucket], shard.latency[call][bucket]);
+      }
+    }
+    for (size_t event = 0; event < STAT_EVENTS; ++event) add(totals.events[event], shard.events[event]);
+    for (size_t phase = 0; phase < LOAD_PHASES; ++phase) {
+      add(totals.phase_runs[phase], shard.phase_runs[phase]);
+      add(totals.phase_ns[phase], shard.phase_ns[phase]);
+    }
+  }
+  for (size_t phase = 0; phase < LOAD_PHASES; ++phase) add(totals.last_phase_ns[phase], last_phase_ns[phase]);
+  return totals;
+}
+
+std::string I18nEngine::stats_json() const {
+  // Buckets sind hier nicht kumuliert (anders als im Prometheus-Export); sie und total_ns zählen nur
+  // die gemessenen Aufrufe (timed).
+  const StatsTotals totals = collect_stats();
+  std::string out = "{\"calls\":{";
+  for (size_t call = 0; call < STAT_CALLS; ++call) {
+    if (call) out += ',';
+    out += '"';
+    out += STAT_CALL_NAMES[call];
+    out += "\":{\"count\":";
+    append_uint(out, totals.calls[call]);
+    out += ",\"timed\":";
+    append_uint(out, totals.timed[call]);
+    out += ",\"total_ns\":";
+    append_uint(out, totals.call_ns[call]);
+    out += ",\"buckets\":[";
+    for (size_t bucket = 0; bucket < LATENCY_BUCKETS; ++bucket) {
+      if (bucket) out += ',';
+      append_uint(out, totals.latency[call][bucket]);
+    }
+    out += "]}";
+  }
+  out += "},\"bucket_bounds_ns\":[";
+  for (size_t bucket = 0; bucket + 1 < LATENCY_BUCKETS; ++bucket) {
+    if (bucket) out += ',';
+    append_uint(out, latency_bound_ns(bucket));
+  }
+  out += "],\"events\":{";
+  for (size_t event = 0; event < STAT_EVENTS; ++event) {
+    if (event) out += ',';
+    out += '"';
+    out += STAT_EVENT_NAMES[event];
+    out += "\":";
+    append_uint(out, totals.events[event]);
+  }
+  out += "},\"load_phases\":{";
+  for (size_t phase = 0; phase < LOAD_PHASES; ++phase) {
+    if (phase) out += ',';
+    out += '"';
+    out += LOAD_PHASE_NAMES[phase];
+    out += "\":{\"runs\":";
+    append_uint(out, totals.phase_runs[phase]);
+    out += ",\"total_ns\":";
+    append_uint(out, totals.phase_ns[phase]);
+    out += ",\"last_ns\":";
+    append_uint(out, totals.last_phase_ns[phase]);
+    out += '}';
+  }
+  out += "}}";
+  return out;
+}
+
+std::string I18nEngine::stats_prometheus() const {
+  // Text-Exposition-Format 0.0.4: Histogramme kumuliert, Zeiten in Sekunden.
+  const StatsTotals totals = collect_stats();
+  std::string out;
+  auto series = [&](const char* metric, const char* label, const char* value) {
+    out += metric;
+    out += '{';
+    out += label;
+    out += "=\"";
+    out += value;
+    out += "\"} ";
+  };
+  out += "# HELP i18n_calls_total Aufrufe der öffentlichen APIs.\n";
+  out += "# TYPE i18n_calls_total counter\n";
+  for (size_t call = 0; call < STAT_CALLS; ++call) {
+    series("i18n_calls_total", "api", STAT_CALL_NAMES[call]);
+    append_uint(out, totals.calls[call]);
+    out += '\n';
+  }
+  out += "# HELP i18n_call_duration_seconds Dauer der gemessenen API-Aufrufe (Stichprobe bei Lookups).\n";
+  out += "# TYPE i18n_call_duration_seconds histogram\n";
+  for (size_t call = 0; call < STAT_CALLS; ++call) {
+    uint64_t cumulative = 0;
+    for (size_t bucket = 0; bucket < LATENCY_BUCKETS; ++bucket) {
+      cumulative += totals.latency[call][bucket];
+      out += "i18n_call_duration_seconds_bucket{api=\"";
+      out += STAT_CALL_NAMES[call];
+      out += "\",le=\"";
+      if (bucket + 1 < LATENCY_BUCKETS) append_seconds(out, latency_bound_ns(bucket));
+      else out += "+Inf";
+      out += "\"} ";
+      append_uint(out, cumulative);
+      out += '\n';
+    }
+    series("i18n_call_duration_seconds_sum", "api", STAT_CALL_NAMES[call]);
+    append_seconds(out, totals.call_ns[call]);
+    out += '\n';
+    series("i18n_call_duration_seconds_count", "api", STAT_CALL_NAMES[call]);
+    append_uint(out, totals.timed[call]);
+    out += '\n';
+  }
+  out += "# HELP i18n_events_total Template-Cache-Treffer, Marker im Ergebnis und RESULT_TOO_LARGE.\n";
+  out += "# TYPE i18n_events_total counter\n";
+  for (size_t event = 0; event < STAT_EVENTS; ++event) {
+    series("i18n_events_total", "event", STAT_EVENT_NAMES[event]);
+    append_uint(out, totals.events[event]);
+    out += '\n';
+  }
+  out += "# HELP i18n_load_phase_seconds_total Ladezeit je Phase.\n";
+  out += "# TYPE i18n_load_phase_seconds_total counter\n";
+  for (size_t phase = 0; phase < LOAD_PHASES; ++phase) {
+    series("i18n_load_phase_seconds_total", "phase", LOAD_PHASE_NAMES[phase]);
+    append_seconds(out, totals.phase_ns[phase]);
+    out += '\n';
+  }
+  out += "# HELP i18n_load_phase_runs_total Durchläufe je Ladephase.\n";
+  out += "# TYPE i18n_load_phase_runs_total counter\n";
+  for (size_t phase = 0; phase < LOAD_PHASES; ++phase) {
+    series("i18n_load_phase_runs_total", "phase", LOAD_PHASE_NAMES[phase]);
+    append_uint(out, totals.phase_runs[phase]);
+    out += '\n';
+  }
+  out += "# HELP i18n_load_phase_last_seconds Dauer je Phase beim jüngsten Lauf.\n";
+  out += "# TYPE i18n_load_phase_last_seconds gauge\n";
+  for (size_t phase = 0; phase < LOAD_PHASES; ++phase) {
+    series("i18n_load_phase_last_seconds", "phase", LOAD_PHASE_NAMES[phase]);
+    append_seconds(out, totals.last_phase_ns[phase]);
+    out += '\n';
+  }
+  return out;
+}
+
+void I18nEngine::reset_stats() noexcept {
+  // Nicht atomar über alle Zähler: ein gleichzeitig laufender Aufruf landet ganz oder teilweise im neuen Stand.
+  auto clear = [](std::atomic<uint64_t>& v) { v.store(0, std::memory_order_relaxed); };
+  for (auto& shard : stats_shards) {
+    for (auto& v : shard.calls) clear(v);
+    for (auto& v : shard.timed) clear(v);
+    for (auto& v : shard.call_ns) clear(v);
+    for (auto& row : shard.latency) for (auto& v : row) clear(v);
+    for (auto& v : shard.events) clear(v);
+    for (auto& v : shard.phase_runs) clear(v);
+    for (auto& v : shard.phase_ns) clear(v);
+  }
+  for (auto& v : last_phase_ns) clear(v);
+}
+
+namespace {
+
+struct TraceRecord {
+  const char* name;
+  std::string token;
+  std::chrono::steady_clock::time_point start;
+  uint64_t duration_ns;
+  uint64_t output_bytes;
+  uint64_t generation;
+  int32_t arg_count;
+  int32_t depth;
+  int32_t parent;
+};
+
+// Laufender Wurzel-Aufruf des Threads; engine == nullptr: keiner.
+struct TraceContext {
+  const void* engine = nullptr;
+  std::shared_ptr<const void> hook; // hält den Hook der Wurzel am Leben, auch wenn er ersetzt wird
+  std::vector<TraceRecord> spans;
+  int32_t current = -1;
+};
+
+thread_local TraceContext t_trace;
+
+// Gleichmäßige Stichprobe ohne Zufall: jeder Aufruf bringt sample_rate Guthaben, ab 1 wird gemessen.
+bool take_trace_sample(double rate) noexcept {
+  thread_local double credit = 0.0;
+  credit += rate;
+  if (credit < 1.0) return false;
+  credit -= 1.0;
+  if (credit >= 1.0) credit = 0.0; // Raten über 1 nicht ansparen
+  return true;
+}
+
+} // namespace
+
+void I18nEngine::set_trace_hook(TraceCallback callback, uint64_t threshold_ns, double sample_rate) {
+  std::lock_guard<std::mutex> lock(trace_mutex);
+  if (!callback || !(sample_rate > 0.0)) {
+    tracing.store(false, std::memory_order_relaxed);
+    std::atomic_store(&trace_hook, std::shared_ptr<const TraceHook>());
+    return;
+  }
+  auto hook = std::make_shared<TraceHook>();
+  hook->callback = std::move(callback);
+  hook->threshold_ns = threshold_ns;
+  hook->sample_rate = std::min(sample_rate, 1.0);
+  std::atomic_store(&trace_hook, std::shared_ptr<const TraceHook>(std::move(hook)));
+  tracing.store(true, std::memory_order_relaxed);
+}
+
+void I18nEngine::TraceScope::begin(I18nEngine& engine, TraceKind kind, const char* name, std::string_view token,
+                                   size_t arg_count, const CatalogSnapshot* snapshot, int depth) {
+  TraceContext& ctx = t_trace;
+  if (!ctx.engine) {
+    if (kind != TraceKind::Call) return;
+    std::shared_ptr<const TraceHook> hook = std::atomic_load(&engine.trace_hook);
+    if (!hook || !take_trace_sample(hook->sample_rate)) return;
+    ctx.engine = &engine;
+    ctx.hook = std::move(hook);
+  } else if (ctx.engine != &engine || ctx.spans.size() >= MAX_TRACE_SPANS) {
+    return;
+  }
+  ctx.spans.push_back(TraceRecord{ name, std::string(token), std::chrono::steady_clock::now(), 0, 0,
+                                   snapshot ? snapshot->generation : 0, (int32_t)arg_count, depth, ctx.current });
+  index_ = (int32_t)ctx.spans.size() - 1;
+  ctx.current = index_;
+}
+
+void I18nEngine::TraceScope::end() {
+  TraceContext& ctx = t_trace;
+  TraceRecord& span = ctx.spans[(size_t)index_];
+  span.duration_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - span.start).count();
+  if (out_ || stream_) output_ = (stream_ ? stream_->bytes_written() : out_->size()) - output_start_;
+  span.output_bytes = output_;
+  ctx.current = span.parent;
+  if (span.parent >= 0) {
+    TraceRecord& parent = ctx.spans[(size_t)span.parent];
+    parent.depth = std::max(parent.depth, span.depth);
+    return;
+  }
+
+  // Wurzel fertig: Kontext freigeben, bevor der Callback läuft; er darf die Engine erneut aufrufen.
+  const auto hook = std::static_pointer_cast<const TraceHook>(std::move(ctx.hook));
+  std::vector<TraceRecord> spans;
+  spans.swap(ctx.spans);
+  ctx.engine = nullptr;
+  ctx.hook.reset();
+  if (spans.front().duration_ns >= hook->threshold_ns) {
+    for (size_t i = 0; i < spans.size(); ++i) {
+      const TraceRecord& rec = spans[i];
+      TraceEvent event;
+      event.name = rec.name;
+      event.token = rec.token.c_str();
+      event.start_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+          rec.start.time_since_epoch()).count();
+      event.duration_ns = rec.duration_ns;
+      event.output_bytes = rec.output_bytes;
+      event.generation = rec.generation;
+      event.arg_count = rec.arg_count;
+      event.depth = rec.depth;
+      event.index = (int32_t)i;
+      event.parent = rec.parent;
+      hook->callback(event);
+    }
+  }
+  spans.clear();
+  if (ctx.spans.capacity() == 0) ctx.spans.swap(spans); // Puffer für den nächsten Aufruf behalten
+}
+
+std::shared_ptr<I18nEngine::CatalogSnapshot> I18nEngine::build_overlay_snapshot(std::shared_ptr<const StyleCatalogSnapshot> base,
+                                                                                const CatalogSnapshot& delta) {
+  auto snapshot = std::make_shared<StyleCatalogSnapshot>();
+  snapshot->schema = std::atomic_load(&property_schema);
+  snapshot->meta_locale = delta.meta_locale.empty() ? base->meta_locale : delta.meta_locale;
+  snapshot->meta_fallback = delta.meta_fallback.empty() ? base->meta_fallback : delta.meta_fallback;
+  snapshot->meta_note = delta.meta_note.empty() ? base->meta_note : delta.meta_note;
+  snapshot->meta_plural = delta.meta_plural != PluralRule::DEFAULT ? delta.meta_plural : base->meta_plural;
+  snapshot->catalog.layer_on(base->catalog);
+  snapshot->style_registry.layer_on(base->style_registry);
+  snapshot->style_info.layer_on(base->style_info);
+  snapshot->templates.layer_on(base->templates);
+
+  std::vector<std::string> changed;
+  snapshot->catalog.reserve(delta.catalog.size(), delta.catalog.arena_bytes());
+  for (auto it = delta.catalog.begin(); it != delta.catalog.end(); ++it) {
+    std::string_view label = it.label();
+    if (label.empty()) {
+      auto inherited = base->catalog.find(it->first);
+      if (inherited != base->catalog.end()) label = inherited.label();
+    }
+    if (snapshot->catalog.emplace(it->first, it->second, label) == FlatCatalog::Emplaced::TooLarge) return nullptr;
+    changed.emplace_back(it->first);
+  }
+
+  // Betroffen sind die geänderten Tokens und alles, was sie in der Basis transitiv referenziert,
+  // inklusive Einträge, die bisher auf ein jetzt hinzugefügtes Token ins Leere zeigten.
+  std::vector<std::string> affected;
+  const bool same_schema = snapshot->schema == base->schema;
+  if (base->refs && same_schema) {
+    const RefIndex& refs = *base->refs;
+    std::unordered_set<uint32_t> seen;
+    std::vector<uint32_t> pending;
+    auto visit = [&](uint32_t id) {
+      if (seen.insert(id).second) pending.push_back(id);
+    };
+    for (const auto& token : changed) {
+      const uint32_t id = refs.find(token);
+      if (id != NO_ENTRY) {
+        visit(id);
+        continue;
+      }
+      affected.push_back(token);
+      refs.for_each_missing_source(token, visit);
+    }
+    while (!pending.empty()) {
+      const uint32_t id = pending.back();
+      pending.pop_back();
+      refs.for_each_dependent(id, visit);
+    }
+    std::vector<uint32_t> ids(seen.begin(), seen.end());
+    std::sort(ids.begin(), ids.end());
+    for (uint32_t id : ids) affected.emplace_back(refs.token_at(id));
+    for (const auto& token : affected) {
+      snapshot->style_registry.mask(token);
+      snapshot->style_info.mask(token);
+      snapshot->templates.mask(token);
+    }
+    populate_style_registry(snapshot.get(), &affected);
+    compile_templates(snapshot.get(), &affected);
+  } else {
+    // Anderes Schema (eigene Kanäle registriert): alles neu auflösen, die Einträge bleiben geteilt.
+    populate_style_registry(snapshot.get());
+    compile_templates(snapshot.get());
+  }
+
+  if (base->refs) {
+    layer_ref_index(snapshot.get(), *base, changed);
+  } else {
+    snapshot->refs = build_ref_index(snapshot->catalog);
+    bind_entries(snapshot.get());
+  }
+  snapshot->base = std::move(base);
+  return snapshot;
+}
+
+I18nEngine::LoadState I18nEngine::LoadTicket::state() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return state_;
+}
+
+I18nEngine::LoadState I18nEngine::LoadTicket::wait(int timeout_ms) const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto done = [&]() { return state_ != LoadState::Pending; };
+  if (timeout_ms < 0) finished_.wait(lock, done);
+  else finished_.wait_for(lock, std::chrono::milliseconds(timeout_ms), done);
+  return state_;
+}
+
+std::string I18nEngine::LoadTicket::error() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return error_;
+}
+
+std::shared_ptr<I18nEngine::LoadTicket> I18nEngine::load_async(const std::string& path, bool strict,
+                                                               ReloadCallback callback, void* user) {
+  return enqueue_load(path, strict, false, callback, user);
+}
+
+std::shared_ptr<I18nEngine::LoadTicket> I18nEngine::reload_async(ReloadCallback callback, void* user) {
+  const LoadSource source = loaded_source();
+  return enqueue_load(source.path, source.strict, true, callback, user);
+}
+
+std::shared_ptr<I18nEngine::LoadTicket> I18nEngine::enqueue_load(const std::string& path, bool strict, bool reload,
+                                                                 ReloadCallback callback, void* user) {
+  auto ticket = std::make_shared<LoadTicket>();
+  ticket->path_ = path;
+  ticket->strict_ = strict;
+  ticket->reload_ = reload;
+  ticket->callback_ = callback;
+  ticket->user_ = user;
+  {
+    std::lock_guard<std::mutex> lock(load_mutex);
+    ticket->sequence_ = begin_load();
+    load_queue.push_back(ticket);
+    if (!load_worker.joinable()) load_worker = std::thread([this]() { run_load_worker(); });
+  }
+  load_wakeup.notify_one();
+  return ticket;
+}
+
+void I18nEngine::run_load_worker() {
+  std::unique_lock<std::mutex> lock(load_mutex);
+  while (true) {
+    load_wakeup.wait(lock, [&]() { return load_shutdown || !load_queue.empty(); });
+    if (load_queue.empty()) return; // Shutdown, alles abgearbeitet
+    auto ticket = std::move(load_queue.front());
+    load_queue.pop_front();
+    lock.unlock();
+    process_load(*ticket);
+    lock.lock();
+  }
+}
+
+void I18nEngine::process_load(LoadTicket& ticket) {
+  ScopedStat stat(*this, ticket.reload_ ? StatCall::Reload : StatCall::Load);
+  auto superseded = [&]() {
+    return ticket.cancelled_.load(std::memory_order_acquire) ||
+           ticket.sequence_ != load_sequence.load(std::memory_order_acquire);
+  };
+  if (superseded()) return finish_load(ticket, LoadState::Cancelled, SUPERSEDED_ERROR);
+  if (ticket.path_.empty()) return finish_load(ticket, LoadState::Failed, "No file loaded yet");
+
+  std::string err;
+  auto snapshot = build_snapshot_from_file(ticket.path_, ticket.strict_, err);
+  if (superseded()) return finish_load(ticket, LoadState::Cancelled, SUPERSEDED_ERROR);
+  if (!snapshot) {
+    if (err.empty()) err = "Katalog konnte nicht geladen werden.";
+    return finish_load(ticket, LoadState::Failed, std::move(err));
+  }
+  const LoadSource source{ ticket.path_, ticket.strict_ };
+  if (!install_snapshot(snapshot, ticket.sequence_, &source)) {
+    return finish_load(ticket, LoadState::Cancelled, SUPERSEDED_ERROR);
+  }
+  leave_locale_mode(); // wie load_file: die Locale-Sicht ist abgelöst
+  finish_load(ticket, LoadState::Done, std::string());
+}
+
+void I18nEngine::finish_load(LoadTicket& ticket, LoadState state, std::string error) {
+  // Callback zuerst: wer den Endzustand per Polling sieht, kann sich darauf verlassen, dass er gelaufen ist.
+  if (ticket.callback_) {
+    const int status = state == LoadState::Done ? 0 : (state == LoadState::Failed ? -1 : 1);
+    ticket.callback_(ticket.user_, status, state == LoadState::Done ? nullptr : error.c_str());
+  }
+  {
+    std::lock_guard<std::mutex> lock(ticket.mutex_);
+    ticket.state_ = state;
+    ticket.error_ = std::move(error);
+  }
+  ticket.finished_.notify_all();
+}
+
+I18nEngine::~I18nEngine() {
+  watch_stop();
+  {
+    std::lock_guard<std::mutex> lock(load_mutex);
+    load_shutdown = true;
+    load_sequence.fetch_add(1, std::memory_order_acq_rel); // wartende Aufträge enden als abgebrochen
+  }
+  load_wakeup.notify_all();
+  if (load_worker.joinable()) load_worker.join();
+  t_last_errors.by_engine.erase(instance_id);
+  LiveEngines& live = live_engines();
+  {
+    std::lock_guard<std::mutex> lock(live.mutex);
+    live.ids.erase(instance_id);
+  }
+  live.frees.fetch_add(1, std::memory_order_release);
+}
+
+bool I18nEngine::watch_start(const std::string& path_in, bool strict, int debounce_ms,
+                             ReloadCallback callback, void* user) {
+  clear_last_error();
+  std::vector<std::unique_ptr<CatalogWatcher>> retired;
+  {
+    std::lock_guard<std::mutex> lock(watch_mutex);
+    retired.swap(retired_watchers);
+  }
+  stop_watchers(std::move(retired));
+  std::lock_guard<std::mutex> lock(watch_mutex);
+  if (watcher) { set_last_error("Watcher läuft bereits."); return false; }
+  const std::string path = path_in.empty() ? loaded_source().path : path_in;
+  if (path.empty()) { set_last_error("No file loaded yet"); return false; }
+
+  auto w = std::make_unique<CatalogWatcher>();
+  w->path = path;
+  w->strict = strict;
+  w->debounce_ms = std::max(0, debounce_ms);
+  w->callback = callback;
+  w->user = user;
+  std::string err;
+  const std::string data = read_file_utf8(path.c_str(), err);
+  if (!err.empty()) { set_last_error(err); return false; }
+  w->content_hash = fnv1a64(data);
+
+#ifdef __linux__
+  std::filesystem::path dir = std::filesystem::path(path).parent_path();
+  if (dir.empty()) dir = ".";
+  w->notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (w->notify_fd < 0 || pipe2(w->wake_fd, O_NONBLOCK | O_CLOEXEC) != 0) {
+    if (w->notify_fd >= 0) close(w->notify_fd);
+    set_last_error("inotify konnte nicht initialisiert werden.");
+    return false;
+  }
+  // Verzeichnis: Rename-Saves (IN_MOVED_TO/IN_CREATE). Datei: direkte Schreibzugriffe, auch über Links.
+  w->dir_watch = inotify_add_watch(w->notify_fd, dir.c_str(),
+                                   IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_MODIFY | IN_DELETE);
+  w->file_watch = inotify_add_watch(w->notify_fd, path.c_str(),
+                                    IN_CLOSE_WRITE | IN_MODIFY | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF);
+  if (w->dir_watch < 0) {
+    close(w->notify_fd);
+    close(w->wake_fd[0]);
+    close(w->wake_fd[1]);
+    set_last_error("Verzeichnis kann nicht überwacht werden: " + dir.string());
+    return false;
+  }
+#endif
+
+  CatalogWatcher* raw = w.get();
+  raw->thread = std::thread([this, raw]() { run_watcher(*raw); });
+  watcher = std::move(w);
+  return true;
+}
+
+void I18nEngine::watch_stop() {
+  std::vector<std::unique_ptr<CatalogWatcher>> stopping;
+  {
+    std::lock_guard<std::mutex> lock(watch_mutex);
+    stopping.swap(retired_watchers);
+    if (watcher) stopping.push_back(std::move(watcher));
+  }
+  stop_watchers(std::move(stopping));
+}
+
+// Ohne watch_mutex aufrufen: ein Watcher-Thread, der gerade seinen Callback ausführt, kann ihn brauchen.
+void I18nEngine::stop_watchers(std::vector<std::unique_ptr<CatalogWatcher>> stopping) {
+  for (auto& w : stopping) {
+    w->stop.store(true, std::memory_order_release);
+#ifdef __linux__
+    const char wake = 1;
+    (void)!write(w->wake_fd[1], &wake, 1);
+#endif
+    if (w->thread.get_id() == std::this_thread::get_id()) {
+      // Aufruf aus dem Reload-Callback: der Thread endet nach dessen Rückkehr, gejoint wird später.
+      std::lock_guard<std::mutex> lock(watch_mutex);
+      retired_watchers.push_back(std::move(w));
+      continue;
+    }
+    if (w->thread.joinable()) w->thread.join();
+#ifdef __linux__
+    close(w->notify_fd);
+    close(w->wake_fd[0]);
+    close(w->wake_fd[1]);
+#endif
+  }
+}
+
+bool I18nEngine::is_watching() {
+  std::lock_guard<std::mutex> lock(watch_mutex);
+  return watcher != nullptr;
+}
+
+void I18nEngine::run_watcher(CatalogWatcher& w) {
+  using Clock = std::chrono::steady_clock;
+  bool pending = false;
+  Clock::time_point deadline;
+
+#ifdef __linux__
+  const std::string name = std::filesystem::path(w.path).filename().string();
+  alignas(inotify_event) char events[4096];
+  while (!w.stop.load(std::memory_order_acquire)) {
+    int timeout = -1;
+    if (pending) {
+      const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+      timeout = (int)std::max<long long>(0, left);
+    }
+    pollfd fds[2] = { { w.notify_fd, POLLIN, 0 }, { w.wake_fd[0], POLLIN, 0 } };
+    const int ready = poll(fds, 2, timeout);
+    if (ready < 0 && errno != EINTR) break;
+    if (w.stop.load(std::memory_order_acquire)) break;
+
+    if (ready > 0 && (fds[0].revents & POLLIN)) {
+      bool relevant = false;
+      ssize_t n;
+      while ((n = read(w.notify_fd, events, sizeof(events))) > 0) {
+        for (ssize_t off = 0; off < n;) {
+          const auto* ev = reinterpret_cast<const inotify_event*>(events + off);
+          if (ev->wd == w.file_watch) {
+            relevant = true;
+            if (ev->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF)) w.file_watch = -1;
+          } else if (ev->wd == w.dir_watch && ev->len > 0 && name == ev->name) {
+            relevant = true;
+          }
+          off += (ssize_t)sizeof(inotify_event) + ev->len;
+        }
+      }
+      if (relevant) {
+        // Jeder weitere Schreibzugriff schiebt die Frist hinaus: ein Reload pro Schub.
+        pending = true;
+        deadline = Clock::now() + std::chrono::milliseconds(w.debounce_ms);
+      }
+    }
+
+    if (pending && Clock::now() >= deadline) {
+      pending = false;
+      if (w.file_watch < 0) {
+        // Nach Rename-Save zeigt die alte Überwachung ins Leere; neue Datei erneut beobachten.
+        w.file_watch = inotify_add_watch(w.notify_fd, w.path.c_str(),
+                                         IN_CLOSE_WRITE | IN_MODIFY | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF);
+      }
+      reload_watched(w);
+    }
+  }
+#else
+  // Ohne inotify: Änderungszeit und Größe pollen; geladen wird, sobald sie einen Takt lang stabil sind.
+  const auto interval = std::chrono::milliseconds(std::max(50, w.debounce_ms));
+  auto stamp = [&]() {
+    std::error_code ec;
+    const auto time = std::filesystem::last_write_time(w.path, ec);
+    const auto size = std::filesystem::file_size(w.path, ec);
+    return std::make_pair(time.time_since_epoch().count(), ec ? (uintmax_t)0 : size);
+  };
+  auto last = stamp();
+  while (!w.stop.load(std::memory_order_acquire)) {
+    std::this_thread::sleep_for(interval);
+    const auto now = stamp();
+    if (now != last) {
+      last = now;
+      pending = true;
+    } else if (pending) {
+      pending = false;
+      reload_watched(w);
+    }
+  }
+  (void)deadline;
+#endif
+}
+
+void I18nEngine::reload_watched(CatalogWatcher& w) {
+  std::error_code ec;
+  if (!std::filesystem::exists(w.path, ec)) return; // Zwischenzustand beim Rename-Save, nächstes Event abwarten
+
+  ScopedStat stat(*this, StatCall::Reload);
+  ScopedStat read_stat(*this, LoadPhase::Read);
+  std::string err;
+  std::string data = read_file_utf8(w.path.c_str(), err);
+  read_stat.stop();
+  if (err.empty()) {
+    const uint64_t hash = fnv1a64(data);
+    if (hash == w.content_hash) return; // Speichern ohne inhaltliche Änderung
+    w.content_hash = hash;
+    auto snapshot = build_snapshot_from_source(std::move(data), w.strict, err);
+    if (snapshot) {
+      // Erst jetzt überholen: unveränderte, unlesbare oder fehlerhafte Saves lassen laufende Ladeaufträge in Ruhe.
+      const uint64_t sequence = begin_load();
+      if (!install_snapshot(snapshot, sequence)) {
+        // Ein neuerer Ladeauftrag gewinnt; beim nächsten Event wird wieder verglichen.
+        w.content_hash = 0;
+        if (w.callback) w.callback(w.user, 1, SUPERSEDED_ERROR);
+        return;
+      }
+      leave_locale_mode();
+      if (w.callback) w.callback(w.user, 0, nullptr);
+      return;
+    }
+  }
+  if (w.callback) w.callback(w.user, -1, err.c_str());
+}
+
+std::string I18nEngine::translate(const std::string& token_in, ArgList args) {
+  ScopedStat stat(*this, StatCall::Translate);
+  auto snapshot = acquire_snapshot();
+  if (!snapshot) return "⟦NO_CATALOG⟧";
+  TraceScope span(*this, TraceKind::Call, "translate", token_in, args.size(), snapshot.get());
+  ScratchFrame frame(*this);
+  std::string& token = frame.take();
+  append_lower_ascii(token, token_in);
+  ArgCache arg_cache(*this, snapshot.get(), args);
+  ResolvePath path(arg_cache);
+  std::string out;
+  translate_into(snapshot.get(), token, args, path, 0, out, nullptr);
+  span.set_output(out.size());
+  return out;
+}
+
+bool I18nEngine::translate_to(std::string_view token_in, ArgList args, ChunkWriter& out) {
+  ScopedStat stat(*this, StatCall::Translate);
+  auto snapshot = acquire_snapshot();
+  if (!snapshot) {
+    out.buffer() += "⟦NO_CATALOG⟧";
+    return out.finish();
+  }
+  TraceScope span(*this, TraceKind::Call, "translate", token_in, args.size(), snapshot.get());
+  span.measure_output(nullptr, &out);
+  ScratchFrame frame(*this);
+  std::string& token = frame.take();
+  append_lower_ascii(token, token_in);
+  ArgCache arg_cache(*this, snapshot.get(), args);
+  ResolvePath path(arg_cache);
+  translate_into(snapshot.get(), token, args, path, 0, out.buffer(), &out);
+  return out.finish();
+}
+
+std::string I18nEngine::render_to_html(const std::string& template_token, ArgList args) {
+  return render_to_html(template_token, args, RenderOptions{});
+}
+
+std::string I18nEngine::render_to_html(const std::string& template_token,
+                                       ArgList args,
+                                       const RenderOptions& options) {
+  std::string out;
+  ChunkWriter writer = ChunkWriter::to_string(out);
+  render_to(template_token, args, options, writer);
+  return out;
+}
+
+bool I18nEngine::render_to(std::string_view template_token,
+                           ArgList args,
+                           const RenderOptions& options,
+                           ChunkWriter& out) {
+  ScopedStat stat(*this, StatCall::RenderHtml);
+  auto snapshot = acquire_snapshot();
+  if (!snapshot) return out.finish();
+  auto style_snapshot = std::dynamic_pointer_cast<const StyleCatalogSnapshot>(snapshot);
+  if (!style_snapshot) return out.finish();
+  TraceScope span(*this, TraceKind::Call, "render_to_html", template_token, args.size(), style_snapshot.get());
+  span.measure_output(nullptr, &out);
+  return render_snapshot(style_snapshot.get(), template_token, args, options, out);
+}
+
+std::vector<std::string> I18nEngine::render_batch(const std::vector<RenderJob>& jobs,
+                                                  const RenderOptions& options,
+                                                  unsigned threads) {
+  // Einmal gepinnt: ein Reload während des Batches ändert keine bereits laufende Seite.
+  auto snapshot = acquire_snapshot();
+  auto style_snapshot = std::dynamic_pointer_cast<const StyleCatalogSnapshot>(snapshot);
+  if (!style_snapshot) return std::vector<std::string>(jobs.size());
+  return render_batch_snapshot(style_snapshot.get(), jobs, options, threads);
+}
+
+std::vector<std::string> I18nEngine::render_batch_snapshot(const StyleCatalogSnapshot* style_snapshot,
+                                                           const std::vector<RenderJob>& jobs,
+                                                           const RenderOptions& options,
+                                                           unsigned threads) {
+  std::vector<std::string> results(jobs.size());
+  if (jobs.empty()) return results;
+
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = (unsigned)std::min<size_t>(threads, jobs.size());
+
+  // Jobs werden einzeln gezogen, damit große Seiten die übrigen Worker nicht blockieren.
+  std::atomic<size_t> next{ 0 };
+  auto worker = [&]() {
+    for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < jobs.size();
+         i = next.fetch_add(1, std::memory_order_relaxed)) {
+      ChunkWriter writer = ChunkWriter::to_string(results[i]);
+      render_snapshot(style_snapshot, jobs[i].template_token, jobs[i].args, options, writer);
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (unsigned t = 1; t < threads; ++t) {
+    // Kann das System keinen Thread mehr anlegen, übernehmen die bereits laufenden Worker den Rest.
+    try {
+      pool.emplace_back(worker);
+    } catch (const std::system_error&) {
+      break;
+    }
+  }
+  worker();
+  for (auto& t : pool) t.join();
+  return results;
+}
+
+bool I18nEngine::render_snapshot(const StyleCatalogSnapshot* style_snapshot,
+                                 std::string_view template_token,
+                                 ArgList args,
+                                 const RenderOptions& options,
+                                 ChunkWriter& out) {
+  ScratchFrame frame(*this);
+  std::string& normalized = frame.take();
+  append_lower_ascii(normalized, template_token);
+  auto it = style_snapshot->catalog.find(normalized);
+  if (it == style_snapshot->catalog.end()) return out.finish();
+
+  const std::string_view raw = it->second;
+  size_t args_bytes = 0;
+  for (const auto& a : args) args_bytes += a.size();
+  StyleCollector styles;
+  HtmlEmitState emit;
+  emit.minify = options.minify;
+
+  const CompiledTemplate* compiled = nullptr;
+  auto compiled_it = style_snapshot->templates.find(normalized);
+  if (compiled_it != style_snapshot->templates.end() && !compiled_it->second.split_tokens) {
+    compiled = &compiled_it->second;
+  }
+  count_event(compiled ? StatEvent::CacheHit : StatEvent::CacheMiss);
+
+  // Der <style>-Block steht vor dem Body. Kompilierte Templates lösen ihre Args daher vorab
+  // einmal auf und streamen den Body danach segmentweise; sonst wird der Body zuerst gebaut.
+  ArgCache arg_cache(*this, style_snapshot, args);
+  std::vector<std::string> arg_values;
+  std::string body;
+  if (compiled) {
+    arg_values.resize(args.size());
+    ResolvePath path(arg_cache);
+    for (uint32_t idx : compiled->arg_indices) {
+      if (idx >= args.size()) continue;
+      arg_values[idx].clear();
+      append_arg(style_snapshot, args, idx, path, 1, arg_values[idx]);
+      collect_html_styles(arg_values[idx], styles);
+    }
+    for (const auto& entry : compiled->style_manifest) {
+      if (styles.seen.insert(entry.token).second) styles.tokens.push_back(entry.token);
+    }
+  } else {
+    body.reserve(raw.size() + args_bytes + 64);
+    render_template_body(style_snapshot, raw, args, emit, body, styles, arg_cache);
+  }
+
+  std::sort(styles.tokens.begin(), styles.tokens.end());
+  std::string& head = out.buffer();
+  if (!options.stylesheet_href.empty()) {
+    // Arg-freie Styles, die das Template selbst referenziert, liegen in jedem exportierten Stylesheet, auch
+    // in einem aus einer Template-Liste. Über Args eingeschleuste Styles stehen dort nicht sicher: inline.
+    std::vector<std::string> static_refs;
+    scan_inline_refs(raw, static_refs); // sortiert + eindeutig
+    auto keep_end = std::remove_if(styles.tokens.begin(), styles.tokens.end(), [&](const std::string& token) {
+      auto info = style_snapshot->style_info.find(token);
+      if (info != style_snapshot->style_info.end() && info->second.uses_args) return false;
+      return std::binary_search(static_refs.begin(), static_refs.end(), token);
+    });
+    styles.tokens.erase(keep_end, styles.tokens.end());
+    head += "<link rel=\"stylesheet\" href=\"";
+    head += escape_html_attr(options.stylesheet_href);
+    head += "\">\n";
+  }
+
+  static constexpr char STYLE_OPEN[] = "<style>\n";
+  static constexpr char STYLE_CLOSE[] = "</style>\n";
+  if (!styles.tokens.empty()) {
+    const size_t open_at = head.size();
+    head += STYLE_OPEN;
+    const size_t defs_at = head.size();
+    build_style_definitions(style_snapshot, styles.tokens, args, head, compiled, &arg_cache);
+    if (head.size() == defs_at) head.resize(open_at);
+    else head += STYLE_CLOSE;
+  }
+  out.reserve(raw.size() + args_bytes + 64);
+
+  if (compiled) {
+    render_compiled_body(style_snapshot, *compiled, arg_values, args.size(), emit, out);
+  } else {
+    out.write_ref(body.data(), body.size());
+  }
+  return out.finish();
+}
+
+bool I18nEngine::build_stylesheet(const std::vector<std::string>& template_tokens,
+                                  std::string& out_css,
+                                  std::string& out_file_name) {
+  out_css.clear();
+  out_file_name.clear();
+  auto style_snapshot = std::dynamic_pointer_cast<const StyleCatalogSnapshot>(acquire_snapshot());
+  if (!style_snapshot) {
+    set_last_error("Catalog not loaded");
+    return false;
+  }
+
+  std::vector<std::string> tokens;
+  if (template_tokens.empty()) {
+    tokens.reserve(style_snapshot->style_info.size());
+    for (const auto& kv : style_snapshot->style_info) {
+      if (!kv.second.uses_args) tokens.push_back(kv.first);
+    }
+  } else {
+    for (const auto& tpl_in : template_tokens) {
+      const std::string tpl_token = to_lower_ascii(tpl_in);
+      auto raw = style_snapshot->catalog.find(tpl_token);
+      if (raw == style_snapshot->catalog.end()) {
+        set_last_error("Template nicht gefunden: " + tpl_token);
+        return false;
+      }
+      std::vector<std::string> refs;
+      scan_inline_refs(raw->second, refs);
+      for (auto& ref : refs) {
+        auto info = style_snapshot->style_info.find(ref);
+        if (info == style_snapshot->style_info.end() || info->second.uses_args) continue;
+        tokens.push_back(std::move(ref));
+      }
+    }
+  }
+  std::sort(tokens.begin(), tokens.end());
+  tokens.erase(std::unique(tokens.begin(), tokens.end()), tokens.end());
+
+  build_style_definitions(style_snapshot.get(), tokens, {}, out_css);
+
+  const uint32_t hash = fnv1a32(reinterpret_cast<const uint8_t*>(out_css.data()), out_css.size());
+  static constexpr char HEX[] = "0123456789abcdef";
+  out_file_name = "mycelia.";
+  for (int shift = 28; shift >= 0; shift -= 4) out_file_name += HEX[(hash >> shift) & 0xF];
+  out_file_name += ".css";
+  return true;
+}
+
+bool I18nEngine::export_stylesheet(const char* out_dir,
+                                   const std::vector<std::string>& template_tokens,
+                                   std::string& out_file_name) {
+  std::string css;
+  if (!build_stylesheet(template_tokens, css, out_file_name)) return false;
+  if (!out_dir || !*out_dir) return true;
+
+  std::filesystem::path out_path = std::filesystem::path(out_dir) / out_file_name;
+  std::error_code ec;
+  std::filesystem::create_directories(out_path.parent_path(), ec);
+  // Gleicher Hash => gleicher Inhalt; vorhandene Datei bleibt für Caches unangetastet.
+  if (std::filesystem::exists(out_path, ec)) return true;
+
+  std::ofstream out(out_path, std::ios::binary);
+  if (!out) {
+    set_last_error("Stylesheet konnte nicht geschrieben werden.");
+    return false;
+  }
+  out.write(css.data(), (std::streamsize)css.size());
+  if (!out.good()) {
+    set_last_error("Stylesheet konnte nicht geschrieben werden.");
+    return false;
+  }
+  return true;
+}
+
+uint64_t I18nEngine::dependency_hash(const CatalogSnapshot* state, std::string_view token) {
+  auto it = state->catalog.find(token);
+  if (it == state->catalog.end()) return 0;
+  const uint64_t h = fnv1a64(it->second);
+  return h ? h : 1;
+}
+
+void I18nEngine::collect_dependencies(const StyleCatalogSnapshot* style_state,
+                                      const std::string& template_token,
+                                      ArgList args,
+                                      std::vector<TokenDependency>& out) {
+  // Statische Hülle über @-Referenzen: eher zu viel als zu wenig, aber ohne Eingriff in den Render-Pfad.
+  out.clear();
+  if (!style_state->refs) return;
+  std::vector<std::string> pending;
+  std::vector<std::string> refs;
+  pending.push_back(to_lower_ascii(template_token));
+
+  for (const auto& arg : args) {
+    if (!arg.empty() && arg[0] == '=') continue; // Literal
+    std::string normalized = to_lower_ascii(std::string(arg));
+    std::string base;
+    std::string variant;
+    if (!parse_variant_suffix(normalized, base, variant)) base = normalized;
+    if (is_hex_token(base)) pending.push_back(normalized);
+    // Args können selbst @style_-Klassen oder Token-Refs ins HTML einschleusen.
+    scan_inline_refs(arg, refs);
+    pending.insert(pending.end(), refs.begin(), refs.end());
+  }
+
+  auto tpl = style_state->catalog.find(pending.front());
+  if (tpl != style_state->catalog.end() && has_split_inline_token(tpl->second)) {
+    // "@style_%0": der Style-Token entsteht erst mit den Args.
+    ArgCache arg_cache(*this, style_state, args);
+    ResolvePath path(arg_cache);
+    std::string resolved;
+    resolve_template_placeholders(style_state, tpl->second, args, path, 0, resolved);
+    scan_inline_refs(resolved, refs);
+    pending.insert(pending.end(), refs.begin(), refs.end());
+  }
+
+  // Ab den Einstiegspunkten über die Vorwärtskanten des Snapshot-Index; fehlende Tokens bleiben als Hash 0 drin.
+  const RefIndex& index = *style_state->refs;
+  std::unordered_set<std::string> missing_seen;
+  std::unordered_set<uint32_t> visited;
+  std::vector<uint32_t> frontier;
+  auto record_missing = [&](const std::string& token) {
+    if (missing_seen.insert(token).second) out.push_back({ token, 0 });
+  };
+  for (auto& token : pending) {
+    const uint32_t id = index.find(token);
+    if (id == NO_ENTRY) record_missing(token);
+    else if (visited.insert(id).second) frontier.push_back(id);
+  }
+  while (!frontier.empty()) {
+    const uint32_t id = frontier.back();
+    frontier.pop_back();
+    const std::string_view token = index.token_at(id);
+    out.push_back({ std::string(token), dependency_hash(style_state, token) });
+    index.for_each_ref(id, [&](uint32_t target) {
+      if (visited.insert(target).second) frontier.push_back(target);
+    });
+    index.for_each_missing(id, record_missing);
+  }
+}
+
+bool I18nEngine::build_site(const std::string& out_dir,
+                            const std::vector<SitePage>& pages,
+                            const RenderOptions& options,
+                            bool force,
+                            SiteBuildReport& report) {
+  report = SiteBuildReport{};
+  auto snapshot = acquire_snapshot();
+  auto style_snapshot = std::dynamic_pointer_cast<const StyleCatalogSnapshot>(snapshot);
+  if (!style_snapshot) {
+    set_last_error("Catalog not loaded");
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(site_mutex);
+  const std::filesystem::path root(out_dir);
+  std::error_code ec;
+
+  std::vector<size_t> dirty;
+  std::vector<std::string> signatures(pages.size());
+  std::unordered_set<std::string> live_paths;
+  for (size_t i = 0; i < pages.size(); ++i) {
+    const SitePage& page = pages[i];
+    // Seiten landen nur unterhalb von out_dir: keine absoluten Pfade, keine ".."-Komponenten.
+    const std::filesystem::path rel(page.output_path);
+    bool escapes = rel.empty() || rel.has_root_name() || rel.has_root_directory();
+    for (const auto& part : rel) escapes = escapes || part == "..";
+    if (escapes) {
+      set_last_error("Ungültiger Seitenpfad (absolut oder außerhalb von out_dir): " + page.output_path);
+      return false;
+    }
+    if (!live_paths.insert(page.output_path).second) {
+      set_last_error("Seite doppelt angegeben: " + page.output_path);
+      return false;
+    }
+    std::string& sig = signatures[i];
+    sig = to_lower_ascii(page.template_token);
+    for (const auto& arg : page.args) {
+      sig += '\0';
+      sig += arg;
+    }
+    sig += '\0';
+    sig += options.minify ? 'm' : '-';
+    sig += '\0';
+    sig += options.stylesheet_href;
+
+    auto state = site_pages.find(page.output_path);
+    bool is_dirty = force || state == site_pages.end() || state->second.signature != sig ||
+                    !std::filesystem::exists(root / page.output_path, ec);
+    if (!is_dirty) {
+      for (const auto& dep : state->second.deps) {
+        if (dependency_hash(style_snapshot.get(), dep.token) != dep.value_hash) {
+          is_dirty = true;
+          break;
+        }
+      }
+    }
+    if (is_dirty) dirty.push_back(i);
+    else ++report.unchanged;
+  }
+
+  // Seiten, die nicht mehr angefragt werden, vergessen (die Dateien bleiben liegen).
+  for (auto it = site_pages.begin(); it != site_pages.end();) {
+    if (live_paths.count(it->first)) ++it;
+    else it = site_pages.erase(it);
+  }
+
+  std::vector<RenderJob> jobs;
+  jobs.reserve(dirty.size());
+  for (size_t idx : dirty) jobs.push_back({ pages[idx].template_token, pages[idx].args });
+  std::vector<std::string> rendered = render_batch_snapshot(style_snapshot.get(), jobs, options, 0);
+
+  bool ok = true;
+  for (size_t k = 0; k < dirty.size(); ++k) {
+    const SitePage& page = pages[dirty[k]];
+    SitePageState& state = site_pages[page.output_path];
+    state.signature = std::move(signatures[dirty[k]]);
+    collect_dependencies(style_snapshot.get(), page.template_token, page.args, state.deps);
+    ++report.rendered;
+
+    // Gleiches Ergebnis trotz geänderter Abhängigkeit: Datei (und mtime) bleibt unangetastet.
+    const uint64_t output_hash = fnv1a64(rendered[k]);
+    const std::filesystem::path target = root / page.output_path;
+    if (!force && state.output_hash == output_hash && std::filesystem::exists(target, ec)) continue;
+
+    std::filesystem::create_directories(target.parent_path(), ec);
+    std::filesystem::path tmp = target;
+    tmp += ".tmp";
+    {
+      std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+      out.write(rendered[k].data(), (std::streamsize)rendered[k].size());
+      if (!out.good()) {
+        set_last_error("Seite konnte nicht geschrieben werden: " + page.output_path);
+        site_pages.erase(page.output_path); // nächster Build versucht es erneut
+        ok = false;
+        continue;
+      }
+    }
+    // rename ersetzt atomar: eine Vorschau sieht nie eine halb geschriebene Seite.
+    std::filesystem::rename(tmp, target, ec);
+    if (ec) {
+      set_last_error("Seite konnte nicht geschrieben werden: " + page.output_path);
+      site_pages.erase(page.output_path);
+      ok = false;
+      continue;
+    }
+    state.output_hash = output_hash;
+    report.written.push_back(page.output_path);
+  }
+  last_site_report = report;
+  return ok;
+}
+
+I18nEngine::SiteBuildReport I18nEngine::get_last_site_report() {
+  std::lock_guard<std::mutex> lock(site_mutex);
+  return last_site_report;
+}
+
+void I18nEngine::reset_site() {
+  std::lock_guard<std::mutex> lock(site_mutex);
+  site_pages.clear();
+  last_site_report = SiteBuildReport{};
+}
+
+std::string I18nEngine::get_physics_json_for_template(const std::string& template_token,
+                                                      ArgList args) {
+  return physics_from_template(template_token, args, PhysicsFormat::Json);
+}
+
+std::string I18nEngine::get_physics_for_template(const std::string& template_token,
+                                                 ArgList args,
+                                                 PhysicsFormat format) {
+  return physics_from_template(template_token, args, format);
+}
+
+std::string I18nEngine::translate_plural(std::string_view token_in,
+                                         int count,
+                                         ArgList args) {
+  ScopedStat stat(*this, StatCall::TranslatePlural);
+  auto snapshot = acquire_snapshot();
+  if (!snapshot) return "⟦NO_CATALOG⟧";
+  TraceScope span(*this, TraceKind::Call, "translate_plural", token_in, args.size(), snapshot.get());
+  std::string normalized;
+  append_lower_ascii(normalized, token_in);
+  std::string base;
+  std::string variant;
+  std::string lookup;
+  if (parse_variant_suffix(normalized, base, variant) && !variant.empty()) {
+    lookup = base + "{" + variant + "}";
+  } else {
+    base = normalized;
+    const std::string desired = base + "{" + pick_variant_name(snapshot->meta_plural, count) + "}";
+    if (snapshot->catalog.find(desired) != snapshot->catalog.end()) {
+      lookup = desired;
+    } else if (snapshot->catalog.find(base + "{other}") != snapshot->catalog.end()) {
+      lookup = base + "{other}";
+    } else {
+      // Kleinste vorhandene Variante; die Familie liegt im sortierten RefIndex zusammen.
+      lookup = base;
+      if (snapshot->refs) {
+        const RefIndex& index = *snapshot->refs;
+        const std::string prefix = base + '{';
+        std::string_view best;
+        index.for_each_prefixed(prefix, [&](uint32_t id) {
+          const std::string_view t = index.token_at(id);
+          if (t.back() != '}') return;
+          const std::string_view v = t.substr(prefix.size(), t.size() - prefix.size() - 1);
+          if (best.empty() || v < best) best = v;
+        });
+        if (!best.empty()) {
+          lookup = prefix;
+          lookup.append(best.data(), best.size());
+          lookup += '}';
+        }
+      }
+    }
+  }
+
+  ArgCache arg_cache(*this, snapshot.get(), args);
+  ResolvePath path(arg_cache);
+  std::string out;
+  translate_into(snapshot.get(), lookup, args, path, 0, out, nullptr);
+  span.set_output(out.size());
+  return out;
+}
+
+std::string I18nEngine::dump_table() const {
+  std::string out;
+  ChunkWriter writer = ChunkWriter::to_string(out);
+  dump_table_to(writer);
+  return out;
+}
+
+bool I18nEngine::dump_table_to(ChunkWriter& writer) const {
+  EntryCursor cursor = iterate_entries(std::string());
+  std::string& out = writer.buffer();
+  if (!cursor.snapshot_) {
+    out += "Catalog not loaded\n";
+    return writer.finish();
+  }
+
+  writer.reserve(cursor.remaining() * 64);
+  out += "Token        | Label                  | Inhalt\n";
+  out += "------------------------------------------------------------\n";
+
+  EntryView entry;
+  while (cursor.next(entry)) {
+    out += entry.token;
+    if (entry.token.size() < 12) out.append(12 - entry.token.size(), ' ');
+    out += " | ";
+
+    out += entry.label;
+    if (entry.label.size() < 22) out.append(22 - entry.label.size(), ' ');
+    out += " | ";
+
+    out += entry.text;
+    out += "\n";
+    writer.maybe_flush();
+  }
+
+  return writer.finish();
+}
+
+std::string I18nEngine::find_any(const std::string& query) const {
+  std::string out;
+  ChunkWriter writer = ChunkWriter::to_string(out);
+  find_any_to(query, writer);
+  return out;
+}
+
+bool I18nEngine::find_any_to(const std::string& query, ChunkWriter& writer) const {
+  std::string& out = writer.buffer();
+  auto snapshot = acquire_snapshot();
+  if (!snapshot || !snapshot->refs) {
+    out += "(no catalog loaded)\n";
+    return writer.finish();
+  }
+  const RefIndex& index = *snapshot->refs;
+
+  std::vector<uint32_t> ids;
+  search_entries(snapshot.get(), query, ids);
+  for (uint32_t id : ids) {
+    const EntryRef& entry = snapshot->entry(id);
+    out += index.token_at(id);
+    out += "(";
+    out += entry.label_view();
+    out += "): ";
+    writer.write_ref(entry.text, entry.text_len);
+    out += "\n";
+    writer.maybe_flush();
+  }
+
+  if (ids.empty()) out += "(keine Treffer)\n";
+  return writer.finish();
+}
+
+size_t I18nEngine::find_page(const std::string& query, size_t offset, size_t limit, std::vector<SearchHit>& out) const {
+  out.clear();
+  auto snapshot = acquire_snapshot();
+  if (!snapshot || !snapshot->refs) return 0;
+  const RefIndex& index = *snapshot->refs;
+
+  std::vector<uint32_t> ids;
+  search_entries(snapshot.get(), query, ids);
+  if (offset >= ids.size()) return ids.size();
+  const size_t end = (limit == 0) ? ids.size() : std::min(ids.size(), offset + limit);
+  out.reserve(end - offset);
+  for (size_t i = offset; i < end; ++i) {
+    const EntryRef& entry = snapshot->entry(ids[i]);
+    SearchHit hit;
+    hit.token = index.token_at(ids[i]);
+    hit.label = entry.label_view();
+    hit.text = entry.text_view();
+    out.push_back(std::move(hit));
+  }
+  return ids.size();
+}
+
+I18nEngine::CheckResult I18nEngine::check_catalog() const {
+  CheckResult result;
+  auto snapshot = acquire_snapshot();
+  if (!snapshot || snapshot->catalog.empty() || !snapshot->refs) {
+    result.code = 2;
+    return result;
+  }
+  const auto& catalog = snapshot->catalog;
+  // Overlay-Ebenen flach neu bauen: der Check läuft ohnehin über jeden Eintrag und braucht dichte CSR-IDs.
+  const auto flat = snapshot->refs->base ? build_ref_index(catalog) : snapshot->refs;
+  const RefIndex& index = *flat;
+  const uint32_t n = (uint32_t)index.tokens.size();
+  result.tokens = n;
+
+  // 1) Placeholder-Lücken und fehlende Refs pro Eintrag. Zusammenhängende ID-Bereiche je Thread,
+  //    Aneinanderhängen in Bereichsreihenfolge ergibt wieder Token-Reihenfolge.
+  auto scan_range = [&](uint32_t begin, uint32_t end, std::vector<CheckIssue>& out) {
+    std::vector<int> idxs;
+    for (uint32_t id = begin; id < end; ++id) {
+      const std::string_view token = index.tokens[id];
+      const std::string_view text = catalog.at(token);
+      idxs.clear();
+      for (size_t i = 0; i < text.size();) {
+        if (text[i] == '%' && i + 1 < text.size() && is_digit((unsigned char)text[i + 1])) {
+          size_t j = i + 1;
+          int idx = 0;
+          while (j < text.size() && is_digit((unsigned char)text[j])) {
+            if (idx > 1000000) idx = 1000000;
+            else idx = idx * 10 + (text[j] - '0');
+            ++j;
+          }
+          idxs.push_back(idx);
+          i = j;
+          continue;
+        }
+        ++i;
+      }
+      if (!idxs.empty()) {
+        std::sort(idxs.begin(), idxs.end());
+        idxs.erase(std::unique(idxs.begin(), idxs.end()), idxs.end());
+        if (idxs.back() != (int)idxs.size() - 1) { // sortiert + eindeutig: lückenlos <=> max == size-1
+          CheckIssue issue;
+          issue.kind = CheckIssue::Kind::PlaceholderGap;
+          issue.token = token;
+          for (size_t k = 0; k < idxs.size(); ++k) {
+            if (k) issue.detail += ", ";
+            issue.detail += '%';
+            issue.detail += std::to_string(idxs[k]);
+          }
+          out.push_back(std::move(issue));
+        }
+      }
+      for (uint32_t m = index.missing_offsets[id]; m < index.missing_offsets[id + 1]; ++m) {
+        CheckIssue issue;
+        issue.kind = CheckIssue::Kind::MissingRef;
+        issue.is_error = true;
+        issue.token = token;
+        issue.detail = index.missing_tokens[m];
+        out.push_back(std::move(issue));
+      }
+    }
+  };
+
+  static constexpr uint32_t PARALLEL_MIN_ENTRIES = 16384;
+  unsigned workers = 1;
+  if (n >= PARALLEL_MIN_ENTRIES) {
+    workers = std::max(1u, std::thread::hardware_concurrency());
+    workers = std::min<unsigned>(workers, n / (PARALLEL_MIN_ENTRIES / 4));
+  }
+  std::vector<std::vector<CheckIssue>> parts(workers);
+  {
+    std::vector<std::thread> pool;
+    const uint32_t step = (n + workers - 1) / workers;
+    unsigned spawned = 1;
+    for (; spawned < workers; ++spawned) {
+      const uint32_t begin = std::min(n, spawned * step);
+      const uint32_t end = std::min(n, begin + step);
+      const unsigned w = spawned;
+      // Kann das System keinen Thread mehr anlegen, scannt der aufrufende Thread die restlichen Bereiche.
+      try {
+        pool.emplace_back([&, begin, end, w]() { scan_range(begin, end, parts[w]); });
+      } catch (const std::system_error&) {
+        break;
+      }
+    }
+    scan_range(0, std::min(n, step), parts[0]);
+    for (unsigned w = spawned; w < workers; ++w) {
+      const uint32_t begin = std::min(n, w * step);
+      scan_range(begin, std::min(n, begin + step), parts[w]);
+    }
+    for (auto& t : pool) t.join();
+  }
+  for (auto& part : parts) {
+    for (auto& issue : part) result.issues.push_back(std::move(issue));
+  }
+
+  // 2) Zyklen: iterativer Tarjan über die Vorwärts-CSR. Jede stark zusammenhängende Komponente mit
+  //    mehr als einem Eintrag (oder Selbstreferenz) wird einmal gemeldet, mit einem konkreten Pfad.
+  static constexpr uint32_t UNVISITED = NO_ENTRY;
+  std::vector<uint32_t> order(n, UNVISITED);
+  std::vector<uint32_t> low(n, 0);
+  std::vector<uint32_t> component(n, UNVISITED);
+  std::vector<uint8_t> on_stack(n, 0);
+  std::vector<uint32_t> scc_stack;
+  struct Frame {
+    uint32_t node;
+    uint32_t edge;
+  };
+  std::vector<Frame> frames;
+  std::vector<std::vector<uint32_t>> cyclic;
+  uint32_t counter = 0;
+  uint32_t component_count = 0;
+
+  for (uint32_t root = 0; root < n; ++root) {
+    if (order[root] != UNVISITED) continue;
+    frames.push_back({ root, index.fwd_offsets[root] });
+    order[root] = low[root] = counter++;
+    scc_stack.push_back(root);
+    on_stack[root] = 1;
+
+    while (!frames.empty()) {
+      Frame& f = frames.back();
+      const uint32_t v = f.node;
+      if (f.edge < index.fwd_offsets[v + 1]) {
+        const uint32_t w = index.fwd_edges[f.edge++];
+        if (order[w] == UNVISITED) {
+          order[w] = low[w] = counter++;
+          scc_stack.push_back(w);
+          on_stack[w] = 1;
+          frames.push_back({ w, index.fwd_offsets[w] }); // f ist danach ungültig
+        } else if (on_stack[w]) {
+          low[v] = std::min(low[v], order[w]);
+        }
+        continue;
+      }
+
+      if (low[v] == order[v]) {
+        std::vector<uint32_t> members;
+        uint32_t w;
+        do {
+          w = scc_stack.back();
+          scc_stack.pop_back();
+          on_stack[w] = 0;
+          component[w] = component_count;
+          members.push_back(w);
+        } while (w != v);
+        bool self_loop = false;
+        if (members.size() == 1) {
+          for (uint32_t e = index.fwd_offsets[v]; e < index.fwd_offsets[v + 1]; ++e) {
+            if (index.fwd_edges[e] == v) { self_loop = true; break; }
+          }
+        }
+        if (members.size() > 1 || self_loop) cyclic.push_back(std::move(members));
+        ++component_count;
+      }
+      frames.pop_back();
+      if (!frames.empty()) {
+        const uint32_t parent = frames.back().node;
+        low[parent] = std::min(low[parent], low[v]);
+      }
+    }
+  }
+
+  for (auto& members : cyclic) std::sort(members.begin(), members.end());
+  std::sort(cyclic.begin(), cyclic.end());
+  std::vector<uint32_t> parent(n, UNVISITED);
+  for (const auto& members : cyclic) {
+    // Kürzester Weg vom kleinsten Mitglied zurück zu sich selbst, nur innerhalb der Komponente.
+    const uint32_t start = members.front();
+    const uint32_t comp = component[start];
+    std::vector<uint32_t> queue{ start };
+    uint32_t last = UNVISITED;
+    for (size_t q = 0; q < queue.size() && last == UNVISITED; ++q) {
+      const uint32_t u = queue[q];
+      for (uint32_t e = index.fwd_offsets[u]; e < index.fwd_offsets[u + 1]; ++e) {
+        const uint32_t w = index.fwd_edges[e];
+        if (component[w] != comp) continue;
+        if (w == start) { last = u; break; }
+        if (parent[w] != UNVISITED) continue;
+        parent[w] = u;
+        queue.push_back(w);
+      }
+    }
+    std::vector<uint32_t> path{ start };
+    for (uint32_t u = last; u != start && u != UNVISITED; u = parent[u]) path.push_back(u);
+    std::reverse(path.begin() + 1, path.end());
+    for (uint32_t u : queue) parent[u] = UNVISITED;
+
+    CheckIssue issue;
+    issue.kind = CheckIssue::Kind::Cycle;
+    issue.is_error = true;
+    issue.token = index.tokens[start];
+    for (uint32_t u : path) {
+      issue.detail += index.tokens[u];
+      issue.detail += " -> ";
+    }
+    issue.detail += index.tokens[start];
+    result.issues.push_back(std::move(issue));
+  }
+
+  for (const auto& issue : result.issues) {
+    if (issue.is_error) ++result.errors;
+    else ++result.warnings;
+  }
+  result.code = result.errors > 0 ? 3 : 0;
+  return result;
+}
+
+bool I18nEngine::write_check_report(const CheckResult& result, ReportFormat format, ChunkWriter& writer) {
+  std::string& out = writer.buffer();
+  static constexpr const char* KIND_NAMES[] = { "placeholder_gap", "missing_ref", "cycle" };
+
+  if (format == ReportFormat::Json) {
+    out += "{\"status\":";
+    out += result.code == 2 ? "\"EMPTY\"" : (result.code == 3 ? "\"FAIL\"" : "\"OK\"");
+    out += ",\"code\":";
+    out += std::to_string(result.code);
+    out += ",\"tokens\":";
+    out += std::to_string(result.tokens);
+    out += ",\"warnings\":";
+    out += std::to_string(result.warnings);
+    out += ",\"errors\":";
+    out += std::to_string(result.errors);
+    out += ",\"issues\":[";
+    for (size_t i = 0; i < result.issues.size(); ++i) {
+      const CheckIssue& issue = result.issues[i];
+      if (i) out += ',';
+      out += "{\"severity\":";
+      out += issue.is_error ? "\"error\"" : "\"warning\"";
+      out += ",\"kind\":\"";
+      out += KIND_NAMES[(int)issue.kind];
+      out += "\",\"token\":";
+      append_json_string(out, issue.token);
+      out += ",\"detail\":";
+      append_json_string(out, issue.detail);
+      out += '}';
+      writer.maybe_flush();
+    }
+    out += "]}\n";
+    return writer.finish();
+  }
+
+  if (result.code == 2) {
+    out += "CHECK: FAIL\nGrund: Katalog ist leer oder nicht geladen.\n";
+    return writer.finish();
+  }
+
+  out += "CHECK: REPORT\n";
+  out += "------------------------------\n";
+  for (const auto& issue : result.issues) {
+    switch (issue.kind) {
+      case CheckIssue::Kind::PlaceholderGap:
+        out += "WARN "; out += issue.token;
+        out += ": Placeholder-Lücke. Gefunden: "; out += issue.detail;
+        break;
+      case CheckIssue::Kind::MissingRef:
+        out += "ERROR "; out += issue.token;
+        out += ": Missing inline ref @"; out += issue.detail;
+        break;
+      case CheckIssue::Kind::Cycle:
+        out += "ERROR CYCLE: "; out += issue.detail;
+        break;
+    }
+    out += "\n";
+    writer.maybe_flush();
+  }
+  out += "------------------------------\n";
+  out += "Tokens: "; out += std::to_string(result.tokens); out += "\n";
+  out += "Warnings: "; out += std::to_string(result.warnings); out += "\n";
+  out += "Errors: "; out += std::to_string(result.errors); out += "\n";
+
+  if (result.errors > 0) out += "CHECK: FAIL\n";
+  else if (result.warnings > 0) out += "CHECK: OK (mit Warnungen)\n";
+  else out += "CHECK: OK\n";
+  return writer.finish();
 }
 
-bool I18nEngine::parse_variant_suffix(const std::string& token,
+std::string I18nEngine::check_catalog_report(int& out_code) const {
+  const CheckResult result = check_catalog();
+  out_code = result.code;
+  std::string report;
+  ChunkWriter writer = ChunkWriter::to_string(report);
+  writer.reserve(256 + result.issues.size() * 64);
+  write_check_report(result, ReportFormat::Text, writer);
+  return report;
+}
+
+bool I18nEngine::looks_like_binary_catalog(const std::string& data) noexcept {
+  if (data.size() < BINARY_HEADER_SIZE_V1) return false;
+  if (std::memcmp(data.data(), BINARY_MAGIC, 4) != 0) return false;
+  const uint8_t version = static_cast<uint8_t>(data[4]);
+  return version == BINARY_VERSION_V1 || version == BINARY_VERSION;
+}
+
+bool I18nEngine::parse_variant_suffix(std::string_view token,
                                       std::string& out_base,
                                       std::string& out_variant) {
   const size_t open = token.find('{');
-  const size_t close = (open != std::string::npos) ? token.find('}', open + 1) : std::string::npos;
-  if (open == std::string::npos || close == std::string::npos || close != token.size() - 1) {
+  const size_t close = (open != std::string_view::npos) ? token.find('}', open + 1) : std::string_view::npos;
+  if (open == std::string_view::npos || close == std::string_view::npos || close != token.size() - 1) {
     return false;
   }
 
-  out_base = token.substr(0, open);
-  out_variant = token.substr(open + 1, close - open - 1);
+  out_base.assign(token.substr(0, open));
+  out_variant.assign(token.substr(open + 1, close - open - 1));
   if (out_variant.empty()) return false;
 
   out_base = to_lower_ascii(out_base);
@@ -1557,7 +4155,7 @@ const char* I18nEngine::pick_variant_name(PluralRule rule, int count) noexcept {
   return "other";
 }
 
-bool I18nEngine::is_variant_valid(const std::string& variant) noexcept {
+bool I18nEngine::is_variant_valid(std::string_view variant) noexcept {
   if (variant.empty() || variant.size() > 16) return false;
   for (char c : variant) {
     const unsigned char uc = (unsigned char)c;
@@ -1566,36 +4164,31 @@ bool I18nEngine::is_variant_valid(const std::string& variant) noexcept {
   return true;
 }
 
-bool I18nEngine::is_style_token(const std::string& token) noexcept {
-  std::string base = token;
+// Nur Pluralvarianten brauchen den (allozierenden) Suffix-Parser; alle anderen Tokens sind ihre eigene Basis.
+bool I18nEngine::is_style_token(std::string_view token) noexcept {
+  static constexpr std::string_view STYLE_PREFIX = "style_";
+  std::string base;
   std::string variant;
-  if (!parse_variant_suffix(token, base, variant)) {
-    base = token;
-  }
-
-  const char* STYLE_PREFIX = "style_";
-  static constexpr size_t STYLE_PREFIX_LEN = 6;
-  if (base.size() <= STYLE_PREFIX_LEN) return false;
-  return starts_with(base, STYLE_PREFIX);
+  std::string_view head = token;
+  if (token.find('{') != std::string_view::npos && parse_variant_suffix(token, base, variant)) head = base;
+  return head.size() > STYLE_PREFIX.size() && head.compare(0, STYLE_PREFIX.size(), STYLE_PREFIX) == 0;
 }
 
-bool I18nEngine::is_template_token(const std::string& token) noexcept {
-  std::string base = token;
+bool I18nEngine::is_template_token(std::string_view token) noexcept {
+  static constexpr std::string_view TEMPLATE_PREFIX = "tpl_";
+  std::string base;
   std::string variant;
-  if (!parse_variant_suffix(token, base, variant)) {
-    base = token;
-  }
-  const char* TEMPLATE_PREFIX = "tpl_";
-  static constexpr size_t TEMPLATE_PREFIX_LEN = 4;
-  return base.size() > TEMPLATE_PREFIX_LEN && starts_with(base, TEMPLATE_PREFIX);
+  std::string_view head = token;
+  if (token.find('{') != std::string_view::npos && parse_variant_suffix(token, base, variant)) head = base;
+  return head.size() > TEMPLATE_PREFIX.size() && head.compare(0, TEMPLATE_PREFIX.size(), TEMPLATE_PREFIX) == 0;
 }
 
-bool I18nEngine::parse_style_properties(const std::string& text, std::vector<StyleProperty>& out_props) {
+bool I18nEngine::parse_style_properties(std::string_view text, std::vector<StyleProperty>& out_props) {
   out_props.clear();
   size_t pos = 0;
   while (pos < text.size()) {
     size_t end = text.find(';', pos);
-    std::string segment = text.substr(pos, (end == std::string::npos) ? text.size() - pos : end - pos);
+    std::string segment(text.substr(pos, (end == std::string_view::npos) ? text.size() - pos : end - pos));
     pos = (end == std::string::npos) ? text.size() : end + 1;
     trim_inplace(segment);
     if (segment.empty()) continue;
@@ -1620,7 +4213,8 @@ bool I18nEngine::parse_style_properties(const std::string& text, std::vector<Sty
     StyleProperty prop;
     prop.prop_name = to_lower_ascii(std::move(name));
     prop.value = std::move(value);
-    prop.prop_hash = fnv1a32(reinterpret_cast<const uint8_t*>(prop.prop_name.data()), prop.prop_name.size());
+    const std::string channel = normalize_property_name(prop.prop_name);
+    prop.prop_hash = fnv1a32(reinterpret_cast<const uint8_t*>(channel.data()), channel.size());
     out_props.push_back(std::move(prop));
   }
   return !out_props.empty();
@@ -1636,45 +4230,794 @@ bool I18nEngine::parse_physical_value(const std::string& text, float& out_value)
   return true;
 }
 
-void I18nEngine::apply_physical_property(NativeStyle& style, const std::string& key, const std::string& raw_value) const {
-  if (key.empty()) return;
-  std::string name = key;
-  if (starts_with(name, "--")) name.erase(0, 2);
-  float value = 0.0f;
-  if (!parse_physical_value(raw_value, value)) return;
+std::string I18nEngine::normalize_property_name(const std::string& name) {
+  std::string out = to_lower_ascii(name);
+  if (starts_with(out, "--")) out.erase(0, 2);
+  return out;
+}
+
+I18nEngine::PropertyId I18nEngine::resolve_builtin_property(uint32_t hash, const std::string& name) noexcept {
+  // Hash-Dispatch über constexpr-Hashes; der Namensvergleich schützt nur gegen Kollisionen.
+  switch (hash) {
+    case fnv1a32_const("mass"):          return name == "mass" ? PROPERTY_MASS : PROPERTY_NONE;
+    case fnv1a32_const("friction"):      return name == "friction" ? PROPERTY_FRICTION : PROPERTY_NONE;
+    case fnv1a32_const("restitution"):   return name == "restitution" ? PROPERTY_RESTITUTION : PROPERTY_NONE;
+    case fnv1a32_const("drag"):          return name == "drag" ? PROPERTY_DRAG : PROPERTY_NONE;
+    case fnv1a32_const("gravity-scale"): return name == "gravity-scale" ? PROPERTY_GRAVITY_SCALE : PROPERTY_NONE;
+    case fnv1a32_const("gravity_scale"): return name == "gravity_scale" ? PROPERTY_GRAVITY_SCALE : PROPERTY_NONE;
+    case fnv1a32_const("spacing"):       return name == "spacing" ? PROPERTY_SPACING : PROPERTY_NONE;
+    case fnv1a32_const("gap"):           return name == "gap" ? PROPERTY_SPACING : PROPERTY_NONE;
+    default: return PROPERTY_NONE;
+  }
+}
+
+I18nEngine::PropertyId I18nEngine::PropertySchema::resolve(uint32_t hash, const std::string& name) const {
+  const PropertyId builtin = resolve_builtin_property(hash, name);
+  if (builtin != PROPERTY_NONE) return builtin;
+  auto it = custom_by_hash.find(hash);
+  if (it == custom_by_hash.end()) return PROPERTY_NONE;
+  if (custom_names[it->second - PROPERTY_BUILTIN_COUNT] != name) return PROPERTY_NONE;
+  return it->second;
+}
+
+void I18nEngine::apply_physical_property(NativeStyle& style, PropertyId id, float value) noexcept {
+  switch (id) {
+    case PROPERTY_MASS: style.mass = value; break;
+    case PROPERTY_FRICTION: style.friction = value; break;
+    case PROPERTY_RESTITUTION: style.restitution = value; break;
+    case PROPERTY_DRAG: style.drag = value; break;
+    case PROPERTY_GRAVITY_SCALE: style.gravity_scale = value; break;
+    case PROPERTY_SPACING: style.spacing = value; break;
+    default: {
+      if (id < PROPERTY_BUILTIN_COUNT) return;
+      const size_t slot = (size_t)(id - PROPERTY_BUILTIN_COUNT);
+      if (slot >= MAX_CUSTOM_PROPERTIES) return;
+      style.custom[slot] = value;
+      break;
+    }
+  }
+  style.set_mask |= (1u << id);
+  style.has_physical = true;
+}
 
-  if (name == "mass") { style.mass = value; style.has_physical = true; }
-  else if (name == "friction") { style.friction = value; style.has_physical = true; }
-  else if (name == "restitution") { style.restitution = value; style.has_physical = true; }
-  else if (name == "drag") { style.drag = value; style.has_physical = true; }
-  else if (name == "gravity-scale" || name == "gravity_scale") { style.gravity_scale = value; style.has_physical = true; }
-  else if (name == "spacing" || name == "gap") { style.spacing = value; style.has_physical = true; }
+bool I18nEngine::read_physical_property(const NativeStyle& style, PropertyId id, float& out_value) noexcept {
+  if (id >= PROPERTY_BUILTIN_COUNT + MAX_CUSTOM_PROPERTIES) return false;
+  switch (id) {
+    case PROPERTY_MASS: out_value = style.mass; break;
+    case PROPERTY_FRICTION: out_value = style.friction; break;
+    case PROPERTY_RESTITUTION: out_value = style.restitution; break;
+    case PROPERTY_DRAG: out_value = style.drag; break;
+    case PROPERTY_GRAVITY_SCALE: out_value = style.gravity_scale; break;
+    case PROPERTY_SPACING: out_value = style.spacing; break;
+    default: out_value = style.custom[id - PROPERTY_BUILTIN_COUNT]; break;
+  }
+  return (style.set_mask & (1u << id)) != 0;
 }
 
 I18nEngine::NativeStyle I18nEngine::evaluate_native_style(const std::vector<StyleProperty>& props,
                                                            const StyleCatalogSnapshot* style_state,
-                                                           const std::vector<std::string>& args) {
+                                                           ArgList args) {
   NativeStyle style;
   if (!style_state) return style;
-  std::unordered_set<std::string> seen;
+  ArgCache arg_cache(*this, style_state, args);
+  ResolvePath path(arg_cache);
+  ScratchFrame frame(*this);
+  std::string& resolved = frame.take();
   for (const auto& prop : props) {
-    if (prop.prop_name.empty()) continue;
-    std::string resolved = resolve_plain_text(style_state, prop.value, args, seen, 0);
-    apply_physical_property(style, prop.prop_name, resolved);
+    if (prop.prop_id == PROPERTY_NONE) continue;
+    resolved.clear();
+    resolve_plain_text(style_state, prop.value, args, path, 0, resolved);
+    float value = 0.0f;
+    if (!parse_physical_value(resolved, value)) continue;
+    apply_physical_property(style, prop.prop_id, value);
   }
   return style;
 }
 
-void I18nEngine::populate_style_registry(StyleCatalogSnapshot* snapshot) {
+void I18nEngine::assign_property_ids(StyleCatalogSnapshot* snapshot) {
+  if (!snapshot) return;
+  for (auto& kv : snapshot->style_registry.own()) { // Basis-Ebenen sind mit demselben Schema aufgelöst
+    for (auto& prop : kv.second) {
+      if (prop.prop_name.empty()) continue;
+      const std::string channel = normalize_property_name(prop.prop_name);
+      prop.prop_id = snapshot->schema ? snapshot->schema->resolve(prop.prop_hash, channel)
+                                      : resolve_builtin_property(prop.prop_hash, channel);
+    }
+  }
+}
+
+int I18nEngine::register_property(const std::string& name) {
+  const std::string channel = normalize_property_name(name);
+  if (channel.empty() || channel.size() > 64) {
+    set_last_error("Ungültiger Property-Name.");
+    return -1;
+  }
+  for (char c : channel) {
+    if (!(std::isalnum((unsigned char)c) || c == '-' || c == '_')) {
+      set_last_error("Property-Name enthält ungültige Zeichen: " + channel);
+      return -1;
+    }
+  }
+
+  const uint32_t hash = fnv1a32(reinterpret_cast<const uint8_t*>(channel.data()), channel.size());
+  // Schema wird nur atomar getauscht: ein Reload im Watcher-Thread liest es parallel. Schema-Tausch und
+  // Neubinden des aktiven Snapshots laufen unter install_mutex; jede spätere Installation bindet selbst
+  // an das neue Schema, so kann kein Reload mehr dazwischen landen und zurückgedreht werden.
+  std::lock_guard<std::mutex> locale_lock(locale_mutex); // Reihenfolge wie set_locale: Locale, dann Install
+  std::lock_guard<std::mutex> install_lock(install_mutex);
+  const auto current = std::atomic_load(&property_schema);
+  const PropertyId existing = current->resolve(hash, channel);
+  if (existing != PROPERTY_NONE) return existing;
+  if (current->custom_by_hash.count(hash)) {
+    set_last_error("Property-Hash kollidiert mit bestehendem Kanal: " + channel);
+    return -1;
+  }
+  if (current->custom_names.size() >= MAX_CUSTOM_PROPERTIES) {
+    set_last_error("Maximale Anzahl eigener Property-Kanäle erreicht.");
+    return -1;
+  }
+
+  auto schema = std::make_shared<PropertySchema>(*current);
+  const PropertyId id = (PropertyId)(PROPERTY_BUILTIN_COUNT + schema->custom_names.size());
+  schema->custom_names.push_back(channel);
+  schema->custom_by_hash.emplace(hash, id);
+  std::atomic_store(&property_schema, std::shared_ptr<const PropertySchema>(schema));
+
+  // Aktiven Snapshot und vorberechnete Locale-Sichten neu binden, damit der Kanal sofort sichtbar ist.
+  // Overlay-Basen werden beim Zurückschalten (pop_overlay) von install_snapshot nachgezogen.
+  for (auto& kv : locales) {
+    if (kv.second.merged) kv.second.merged = with_current_schema(kv.second.merged);
+  }
+  auto active = acquire_snapshot();
+  if (active) std::atomic_store_explicit(&active_snapshot, with_current_schema(active), std::memory_order_release);
+  return id;
+}
+
+std::shared_ptr<const I18nEngine::CatalogSnapshot> I18nEngine::with_current_schema(
+    std::shared_ptr<const CatalogSnapshot> snapshot) {
+  auto style_snapshot = std::dynamic_pointer_cast<const StyleCatalogSnapshot>(snapshot);
+  const auto schema = std::atomic_load(&property_schema);
+  if (!style_snapshot || style_snapshot->schema == schema) return snapshot;
+  auto next = std::make_shared<StyleCatalogSnapshot>(*style_snapshot);
+  next->generation = next_snapshot_generation();
+  next->schema = schema;
+  next->style_registry.flatten(); // Overlay: Basis-Einträge sind mit dem alten Schema aufgelöst
+  assign_property_ids(next.get());
+  compile_templates(next.get());
+  return next;
+}
+
+int I18nEngine::find_property(const std::string& name) const {
+  const std::string channel = normalize_property_name(name);
+  const uint32_t hash = fnv1a32(reinterpret_cast<const uint8_t*>(channel.data()), channel.size());
+  const PropertyId id = std::atomic_load(&property_schema)->resolve(hash, channel);
+  return id == PROPERTY_NONE ? -1 : (int)id;
+}
+
+size_t I18nEngine::property_count() const {
+  return std::atomic_load(&property_schema)->channel_count();
+}
+
+std::string I18nEngine::property_name(PropertyId id) const {
+  static const char* const BUILTIN_NAMES[PROPERTY_BUILTIN_COUNT] = {
+    "mass", "friction", "restitution", "drag", "gravity-scale", "spacing"
+  };
+  if (id < PROPERTY_BUILTIN_COUNT) return BUILTIN_NAMES[id];
+  const size_t slot = (size_t)(id - PROPERTY_BUILTIN_COUNT);
+  const auto schema = std::atomic_load(&property_schema);
+  if (slot >= schema->custom_names.size()) return {};
+  return schema->custom_names[slot];
+}
+
+std::string_view I18nEngine::FlatCatalog::const_iterator::label() const noexcept {
+  if (!layer_) return {};
+  const Record& r = layer_->records_[index_];
+  return { kv_.second.data() + r.text_len, r.label_len };
+}
+
+I18nEngine::FlatCatalog::const_iterator& I18nEngine::FlatCatalog::const_iterator::operator++() {
+  ++index_;
+  settle();
+  return *this;
+}
+
+// Zum nächsten sichtbaren Record: Ebenenwechsel am Ende, verdeckte Tokens der Basis überspringen.
+void I18nEngine::FlatCatalog::const_iterator::settle() {
+  while (layer_) {
+    if (index_ >= layer_->records_.size()) {
+      layer_ = layer_->base_;
+      index_ = 0;
+      continue;
+    }
+    const Record& r = layer_->records_[index_];
+    const std::string_view token = layer_->token_of(r);
+    if (!top_->shadows(layer_, token)) {
+      kv_.first = token;
+      kv_.second = std::string_view(token.data() + r.token_len, r.text_len);
+      return;
+    }
+    ++index_;
+  }
+}
+
+I18nEngine::FlatCatalog::const_iterator I18nEngine::FlatCatalog::begin() const {
+  const_iterator it;
+  it.top_ = this;
+  it.layer_ = this;
+  it.settle();
+  return it;
+}
+
+I18nEngine::FlatCatalog::const_iterator I18nEngine::FlatCatalog::make_iterator(const FlatCatalog* layer,
+                                                                                uint32_t index) const noexcept {
+  const Record& r = layer->records_[index];
+  const_iterator it;
+  it.top_ = this;
+  it.layer_ = layer;
+  it.index_ = index;
+  it.kv_.first = layer->token_of(r);
+  it.kv_.second = std::string_view(it.kv_.first.data() + r.token_len, r.text_len);
+  return it;
+}
+
+I18nEngine::FlatCatalog::const_iterator I18nEngine::FlatCatalog::find(std::string_view token) const {
+  HexKey key;
+  if (decode_hex_key(token, key)) return find(key);
+  const uint32_t hash = fnv1a32(reinterpret_cast<const uint8_t*>(token.data()), token.size());
+  for (const FlatCatalog* layer = this; layer; layer = layer->base_) {
+    const uint32_t index = layer->find_own(token, hash);
+    if (index != NO_ENTRY) return make_iterator(layer, index);
+  }
+  return end();
+}
+
+I18nEngine::FlatCatalog::const_iterator I18nEngine::FlatCatalog::find(const HexKey& key) const {
+  for (const FlatCatalog* layer = this; layer; layer = layer->base_) {
+    const uint32_t index = layer->find_own(key);
+    if (index != NO_ENTRY) return make_iterator(layer, index);
+  }
+  return end();
+}
+
+std::string_view I18nEngine::FlatCatalog::at(std::string_view token) const {
+  auto it = find(token);
+  if (it == end()) throw std::out_of_range(std::string(token));
+  return it->second;
+}
+
+size_t I18nEngine::FlatCatalog::size() const {
+  if (!base_) return records_.size();
+  size_t n = 0;
+  for (auto it = begin(); it != end(); ++it) ++n;
+  return n;
+}
+
+template <typename Match>
+uint32_t I18nEngine::FlatCatalog::probe(const std::vector<uint32_t>& slots, uint32_t hash, Match&& match) noexcept {
+  if (slots.empty()) return NO_ENTRY;
+  const size_t mask = slots.size() - 1;
+  for (size_t pos = hash & mask;; pos = (pos + 1) & mask) {
+    const uint32_t index = slots[pos];
+    if (index == NO_ENTRY || match(index)) return index;
+  }
+}
+
+uint32_t I18nEngine::FlatCatalog::find_own(std::string_view token, uint32_t hash) const noexcept {
+  return probe(slots_, hash, [&](uint32_t index) {
+    const Record& r = records_[index];
+    return r.hash == hash && token_of(r) == token;
+  });
+}
+
+// Reiner Zahlenvergleich, ohne die Arena anzufassen.
+uint32_t I18nEngine::FlatCatalog::find_own(const HexKey& key) const noexcept {
+  return probe(hex_slots_, key.hash(), [&](uint32_t index) {
+    const Record& r = records_[index];
+    return r.key_lo == key.lo && r.key_hi == key.hi && r.token_len == key.len;
+  });
+}
+
+bool I18nEngine::FlatCatalog::shadows(const FlatCatalog* layer, std::string_view token) const {
+  if (layer == this) return false;
+  HexKey key;
+  const bool hex = decode_hex_key(token, key);
+  const uint32_t hash = hex ? 0 : fnv1a32(reinterpret_cast<const uint8_t*>(token.data()), token.size());
+  for (const FlatCatalog* l = this; l != layer; l = l->base_) {
+    if ((hex ? l->find_own(key) : l->find_own(token, hash)) != NO_ENTRY) return true;
+  }
+  return false;
+}
+
+void I18nEngine::FlatCatalog::rehash(std::vector<uint32_t>& slots, const std::vector<Record>& records, bool hex,
+                                     size_t capacity) {
+  slots.assign(capacity, NO_ENTRY);
+  const size_t mask = capacity - 1;
+  for (uint32_t i = 0; i < (uint32_t)records.size(); ++i) {
+    if (records[i].hex != hex) continue;
+    size_t pos = records[i].hash & mask;
+    while (slots[pos] != NO_ENTRY) pos = (pos + 1) & mask;
+    slots[pos] = i;
+  }
+}
+
+// Hex- und Namens-Tabelle wachsen getrennt; vorab wird nur die Hex-Tabelle dimensioniert, da große
+// Kataloge fast nur aus Hex-Tokens bestehen.
+void I18nEngine::FlatCatalog::reserve(size_t entries, size_t arena_bytes) {
+  records_.reserve(entries);
+  arena_->reserve(arena_bytes);
+  size_t capacity = 16;
+  while (capacity < entries * 2) capacity <<= 1;
+  if (capacity > hex_slots_.size()) rehash(hex_slots_, records_, true, capacity);
+}
+
+I18nEngine::FlatCatalog::Emplaced I18nEngine::FlatCatalog::emplace(std::string_view token, std::string_view text,
+                                                                   std::string_view label) {
+  HexKey key;
+  const bool hex = decode_hex_key(token, key);
+  const uint32_t hash = hex ? key.hash() : fnv1a32(reinterpret_cast<const uint8_t*>(token.data()), token.size());
+  if ((hex ? find_own(key) : find_own(token, hash)) != NO_ENTRY) return Emplaced::Duplicate;
+  // Der Record speichert die Token-Länge als uint16 und Offsets als uint32; nichts darf abgeschnitten werden.
+  if (token.size() > MAX_TOKEN_BYTES ||
+      arena_->size() + token.size() + text.size() + label.size() > MAX_ARENA_BYTES) {
+    return Emplaced::TooLarge;
+  }
+  if (arena_.use_count() > 1) arena_ = std::make_shared<std::string>(*arena_); // geteilte Arena nie verändern
+
+  std::vector<uint32_t>& slots = hex ? hex_slots_ : slots_;
+  const size_t used = hex ? hex_count_ : records_.size() - hex_count_;
+  if ((used + 1) * 2 > slots.size()) rehash(slots, records_, hex, std::max<size_t>(16, slots.size() * 2));
+
+  Record r;
+  r.key_hi = key.hi;
+  r.key_lo = key.lo;
+  r.hash = hash;
+  r.offset = (uint32_t)arena_->size();
+  r.token_len = (uint16_t)token.size();
+  r.text_len = (uint32_t)text.size();
+  r.label_len = (uint32_t)label.size();
+  r.hex = hex;
+  arena_->append(token.data(), token.size());
+  arena_->append(text.data(), text.size());
+  arena_->append(label.data(), label.size());
+
+  const size_t mask = slots.size() - 1;
+  size_t pos = hash & mask;
+  while (slots[pos] != NO_ENTRY) pos = (pos + 1) & mask;
+  slots[pos] = (uint32_t)records_.size();
+  records_.push_back(r);
+  if (hex) ++hex_count_;
+  return Emplaced::Inserted;
+}
+
+uint32_t I18nEngine::RefIndex::find(std::string_view token) const noexcept {
+  if (base) {
+    const uint32_t id = base->find(token);
+    if (id != NO_ENTRY) return id;
+    auto it = std::lower_bound(added_order.begin(), added_order.end(), token,
+                               [&](uint32_t a, std::string_view t) { return token_at(a) < t; });
+    if (it == added_order.end() || token_at(*it) != token) return NO_ENTRY;
+    return *it;
+  }
+  auto it = std::lower_bound(tokens.begin(), tokens.end(), token);
+  if (it == tokens.end() || *it != token) return NO_ENTRY;
+  return (uint32_t)(it - tokens.begin());
+}
+
+I18nEngine::RefIndex::PrefixRange I18nEngine::RefIndex::prefix_range(std::string_view prefix) const {
+  // Tokens mit gemeinsamem Präfix liegen in beiden sortierten Listen zusammenhängend.
+  auto has_prefix = [&](std::string_view token) { return token.compare(0, prefix.size(), prefix) == 0; };
+  const RefIndex& full = base ? *base : *this;
+  PrefixRange range;
+  auto first = std::lower_bound(full.tokens.begin(), full.tokens.end(), prefix);
+  auto last = std::partition_point(first, full.tokens.end(), has_prefix);
+  range.first = (uint32_t)(first - full.tokens.begin());
+  range.last = (uint32_t)(last - full.tokens.begin());
+  if (base) {
+    auto added_first = std::lower_bound(added_order.begin(), added_order.end(), prefix,
+                                        [&](uint32_t a, std::string_view t) { return token_at(a) < t; });
+    auto added_last = std::partition_point(added_first, added_order.end(),
+                                           [&](uint32_t a) { return has_prefix(token_at(a)); });
+    range.added_first = (uint32_t)(added_first - added_order.begin());
+    range.added_last = (uint32_t)(added_last - added_order.begin());
+  }
+  return range;
+}
+
+void I18nEngine::RefIndex::ordered_ids(std::vector<uint32_t>& out) const {
+  out.clear();
+  out.reserve(size());
+  const uint32_t n = base ? base->size() : size();
+  uint32_t id = 0;
+  for (uint32_t added : added_order) { // nur bei Ebenen belegt
+    const std::string_view token = token_at(added);
+    for (; id < n && base->tokens[id] < token; ++id) out.push_back(id);
+    out.push_back(added);
+  }
+  for (; id < n; ++id) out.push_back(id);
+}
+
+std::shared_ptr<const I18nEngine::RefIndex> I18nEngine::build_ref_index(const FlatCatalog& catalog) {
+  auto index = std::make_shared<RefIndex>();
+  index->tokens.reserve(catalog.size());
+  for (const auto& kv : catalog) index->tokens.push_back(kv.first);
+  std::sort(index->tokens.begin(), index->tokens.end());
+
+  const size_t n = index->tokens.size();
+  index->fwd_offsets.reserve(n + 1);
+  index->missing_offsets.reserve(n + 1);
+  index->fwd_offsets.push_back(0);
+  index->missing_offsets.push_back(0);
+  std::vector<uint32_t> in_degree(n, 0);
+  std::vector<std::string> refs;
+  for (size_t i = 0; i < n; ++i) {
+    scan_inline_refs(catalog.at(index->tokens[i]), refs); // sortiert + eindeutig => Zeilen sortiert
+    for (auto& ref : refs) {
+      const uint32_t target = index->find(ref);
+      if (target == NO_ENTRY) {
+        index->missing_tokens.push_back(std::move(ref));
+      } else {
+        index->fwd_edges.push_back(target);
+        ++in_degree[target];
+      }
+    }
+    index->fwd_offsets.push_back((uint32_t)index->fwd_edges.size());
+    index->missing_offsets.push_back((uint32_t)index->missing_tokens.size());
+  }
+
+  // Rückwärtskanten per Counting-Sort: Zeilen entstehen in aufsteigender Quell-ID.
+  index->rev_offsets.assign(n + 1, 0);
+  for (size_t i = 0; i < n; ++i) index->rev_offsets[i + 1] = index->rev_offsets[i] + in_degree[i];
+  index->rev_edges.resize(index->fwd_edges.size());
+  std::vector<uint32_t> fill(index->rev_offsets.begin(), index->rev_offsets.end() - 1);
+  for (uint32_t src = 0; src < (uint32_t)n; ++src) {
+    for (uint32_t e = index->fwd_offsets[src]; e < index->fwd_offsets[src + 1]; ++e) {
+      index->rev_edges[fill[index->fwd_edges[e]]++] = src;
+    }
+  }
+
+  // "Wer verweist auf das fehlende Token X": Overlays, die X hinzufügen, finden so ihre Quellen ohne Vollscan.
+  index->missing_order.resize(index->missing_tokens.size());
+  for (uint32_t m = 0; m < (uint32_t)index->missing_order.size(); ++m) index->missing_order[m] = m;
+  std::stable_sort(index->missing_order.begin(), index->missing_order.end(), [&](uint32_t a, uint32_t b) {
+    return index->missing_tokens[a] < index->missing_tokens[b];
+  });
+  return index;
+}
+
+void I18nEngine::bind_entries(CatalogSnapshot* snapshot) {
+  const RefIndex& index = *snapshot->refs;
+  auto entries = std::make_shared<std::vector<EntryRef>>(index.tokens.size());
+  for (size_t i = 0; i < index.tokens.size(); ++i) {
+    auto it = snapshot->catalog.find(index.tokens[i]);
+    EntryRef& entry = (*entries)[i];
+    entry.text = it->second.data();
+    entry.text_len = (uint32_t)it->second.size();
+    entry.label_len = (uint32_t)it.label().size();
+  }
+  snapshot->entries = std::move(entries);
+  snapshot->entry_overrides.clear();
+}
+
+void I18nEngine::layer_ref_index(CatalogSnapshot* snapshot, const CatalogSnapshot& base, const std::vector<std::string>& changed) {
+  const RefIndex& below = *base.refs;
+  auto layer = std::make_shared<RefIndex>();
+  layer->base = below.base ? below.base : base.refs;
+  if (below.base) { // Ebene über Ebene: deren Tabellen übernehmen, die Tiefe bleibt 1
+    layer->tokens = below.tokens;
+    layer->added_order = below.added_order;
+    layer->rows = below.rows;
+  }
+
+  // Neue Tokens anhängen; neu zu scannen sind die geänderten Zeilen und alle, die bisher ins Leere
+  // auf ein jetzt hinzugefügtes Token zeigten.
+  std::vector<uint32_t> dirty;
+  std::vector<std::string_view> added;
+  for (const auto& token : changed) {
+    const uint32_t id = below.find(token);
+    if (id != NO_ENTRY) {
+      dirty.push_back(id);
+      continue;
+    }
+    dirty.push_back(layer->size());
+    layer->added_order.push_back(layer->size());
+    layer->tokens.push_back(snapshot->catalog.find(token)->first);
+    added.push_back(layer->tokens.back());
+  }
+  std::sort(layer->added_order.begin(), layer->added_order.end(), [&](uint32_t a, uint32_t b) {
+    return layer->token_at(a) < layer->token_at(b);
+  });
+  for (std::string_view token : added) below.for_each_missing_source(token, [&](uint32_t src) { dirty.push_back(src); });
+  std::sort(dirty.begin(), dirty.end());
+  dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+
+  bool same_refs = added.empty();
+  std::vector<std::string> refs;
+  for (uint32_t id : dirty) {
+    RefIndex::Row row;
+    scan_inline_refs(snapshot->catalog.at(layer->token_at(id)), refs);
+    for (auto& ref : refs) {
+      const uint32_t target = layer->find(ref);
+      if (target == NO_ENTRY) row.missing.push_back(std::move(ref));
+      else row.refs.push_back(target);
+    }
+    if (same_refs) {
+      RefIndex::Row before;
+      below.for_each_ref(id, [&](uint32_t target) { before.refs.push_back(target); });
+      below.for_each_missing(id, [&](const std::string& token) { before.missing.push_back(token); });
+      same_refs = before.refs == row.refs && before.missing == row.missing;
+    }
+    layer->rows[id] = std::move(row);
+  }
+  // Ohne neue Tokens und mit unveränderten Referenzen bleibt der Referenzgraph der Basis gültig.
+  if (same_refs) {
+    snapshot->refs = base.refs;
+  } else {
+    for (const auto& kv : layer->rows) {
+      for (uint32_t target : kv.second.refs) layer->rev_rows[target].push_back(kv.first);
+    }
+    for (auto& kv : layer->rev_rows) std::sort(kv.second.begin(), kv.second.end());
+    snapshot->refs = std::move(layer);
+  }
+
+  // Einträge: Basis-Array teilen, nur geänderte und neue Tokens zeigen in die eigene Arena.
+  snapshot->entries = base.entries;
+  snapshot->entry_overrides = base.entry_overrides;
+  for (const auto& token : changed) {
+    auto it = snapshot->catalog.find(token);
+    EntryRef& entry = snapshot->entry_overrides[snapshot->refs->find(token)];
+    entry.text = it->second.data();
+    entry.text_len = (uint32_t)it->second.size();
+    entry.label_len = (uint32_t)it.label().size();
+  }
+}
+
+I18nEngine::EntryCursor I18nEngine::iterate_entries(const std::string& prefix) const {
+  EntryCursor cursor;
+  cursor.snapshot_ = acquire_snapshot();
+  if (!cursor.snapshot_ || !cursor.snapshot_->refs) return cursor;
+  cursor.range_ = cursor.snapshot_->refs->prefix_range(prefix);
+  return cursor;
+}
+
+bool I18nEngine::EntryCursor::next(EntryView& out) noexcept {
+  uint32_t id;
+  if (range_.added_first < range_.added_last) {
+    const RefIndex& index = *snapshot_->refs;
+    const uint32_t added = index.added_order[range_.added_first];
+    const bool take_added = range_.first >= range_.last || index.token_at(added) < index.token_at(range_.first);
+    id = take_added ? added : range_.first;
+    if (take_added) ++range_.added_first;
+    else ++range_.first;
+  } else if (range_.first < range_.last) {
+    id = range_.first++;
+  } else {
+    return false;
+  }
+  const EntryRef& entry = snapshot_->entry(id);
+  out.token = snapshot_->refs->token_at(id);
+  out.label = entry.label_view();
+  out.text = entry.text_view();
+  return true;
+}
+
+namespace {
+inline uint32_t trigram_at(const char* p) noexcept {
+  return ((uint32_t)(unsigned char)p[0] << 16) | ((uint32_t)(unsigned char)p[1] << 8) | (uint32_t)(unsigned char)p[2];
+}
+
+void append_lowercase(std::string& out, std::string_view s) {
+  const size_t at = out.size();
+  out += s;
+  for (size_t i = at; i < out.size(); ++i) out[i] = (char)std::tolower((unsigned char)out[i]);
+}
+}
+
+const I18nEngine::SearchIndex& I18nEngine::search_index(const CatalogSnapshot* snapshot) {
+  LazySearchIndex& slot = *snapshot->search;
+  std::call_once(slot.once, [&]() {
+    auto index = std::make_unique<SearchIndex>();
+    const RefIndex& refs = *snapshot->refs;
+    const size_t n = refs.size();
+    if (refs.base) refs.ordered_ids(index->ids); // Positionen in Token-Reihenfolge, wie beim vollen Index
+
+    index->folded_offsets.reserve(n + 1);
+    index->label_offsets.reserve(n);
+    // Pass 1: Texte falten und jedes Trigramm über eine offene Hash-Tabelle auf einen dichten Slot
+    // abbilden. slot_last verhindert doppelte Postings, wenn ein Trigramm im Eintrag mehrfach vorkommt.
+    static constexpr uint32_t EMPTY_KEY = 0xFFFFFFFFu; // Trigramme belegen nur 24 Bit
+    std::vector<uint32_t> table_keys(1024, EMPTY_KEY), table_slots(1024);
+    std::vector<uint32_t> slot_keys, slot_counts, slot_last;
+    auto slot_for = [&](uint32_t g) -> uint32_t {
+      size_t mask = table_keys.size() - 1;
+      size_t pos = (g * 0x9E3779B1u) & mask;
+      while (table_keys[pos] != EMPTY_KEY) {
+        if (table_keys[pos] == g) return table_slots[pos];
+        pos = (pos + 1) & mask;
+      }
+      const uint32_t slot = (uint32_t)slot_keys.size();
+      slot_keys.push_back(g);
+      slot_counts.push_back(0);
+      slot_last.push_back(NO_ENTRY);
+      table_keys[pos] = g;
+      table_slots[pos] = slot;
+      if (slot_keys.size() * 2 > table_keys.size()) { // Ladefaktor <= 1/2
+        table_keys.assign(table_keys.size() * 2, EMPTY_KEY);
+        table_slots.resize(table_keys.size());
+        mask = table_keys.size() - 1;
+        for (uint32_t s = 0; s < (uint32_t)slot_keys.size(); ++s) {
+          size_t p = (slot_keys[s] * 0x9E3779B1u) & mask;
+          while (table_keys[p] != EMPTY_KEY) p = (p + 1) & mask;
+          table_keys[p] = slot_keys[s];
+          table_slots[p] = s;
+        }
+      }
+      return slot;
+    };
+    std::vector<uint32_t> entry_slots;
+    std::vector<uint32_t> entry_slot_offsets{ 0 };
+    entry_slot_offsets.reserve(n + 1);
+    for (uint32_t id = 0; id < (uint32_t)n; ++id) {
+      const EntryRef& entry = snapshot->entry(index->ids.empty() ? id : index->ids[id]);
+      const uint32_t begin = (uint32_t)index->folded.size();
+      index->folded_offsets.push_back(begin);
+      append_lowercase(index->folded, entry.text_view());
+      index->folded += '\0';
+      index->label_offsets.push_back((uint32_t)index->folded.size());
+      append_lowercase(index->folded, entry.label_view());
+
+      // Trigramme über das '\0' hinweg stören nicht: matches() prüft Text und Label getrennt.
+      const char* p = index->folded.data() + begin;
+      const size_t len = index->folded.size() - begin;
+      for (size_t k = 0; k + 3 <= len; ++k) {
+        const uint32_t slot = slot_for(trigram_at(p + k));
+        if (slot_last[slot] == id) continue;
+        slot_last[slot] = id;
+        ++slot_counts[slot];
+        entry_slots.push_back(slot);
+      }
+      entry_slot_offsets.push_back((uint32_t)entry_slots.size());
+    }
+    index->folded_offsets.push_back((uint32_t)index->folded.size());
+
+    // Pass 2: Slots nach Trigramm sortieren, dann Postings per Counting-Sort in ID-Reihenfolge füllen.
+    std::vector<uint32_t> by_key(slot_keys.size());
+    for (uint32_t s = 0; s < (uint32_t)by_key.size(); ++s) by_key[s] = s;
+    std::sort(by_key.begin(), by_key.end(), [&](uint32_t a, uint32_t b) { return slot_keys[a] < slot_keys[b]; });
+    std::vector<uint32_t> fill(slot_keys.size());
+    index->trigram_keys.reserve(by_key.size());
+    index->posting_offsets.reserve(by_key.size() + 1);
+    uint32_t total = 0;
+    for (uint32_t s : by_key) {
+      index->trigram_keys.push_back(slot_keys[s]);
+      index->posting_offsets.push_back(total);
+      fill[s] = total;
+      total += slot_counts[s];
+    }
+    index->posting_offsets.push_back(total);
+    index->postings.resize(total);
+    for (uint32_t id = 0; id < (uint32_t)n; ++id) {
+      for (uint32_t k = entry_slot_offsets[id]; k < entry_slot_offsets[id + 1]; ++k) {
+        index->postings[fill[entry_slots[k]]++] = id;
+      }
+    }
+    slot.index = std::move(index);
+    slot.built.store(true, std::memory_order_release);
+  });
+  return *slot.index;
+}
+
+void I18nEngine::search_entries(const CatalogSnapshot* snapshot, const std::string& query, std::vector<uint32_t>& out_ids) {
+  out_ids.clear();
+  const SearchIndex& index = search_index(snapshot);
+  const uint32_t n = (uint32_t)index.label_offsets.size();
+  auto emit = [&](uint32_t pos) { out_ids.push_back(index.ids.empty() ? pos : index.ids[pos]); };
+
+  std::string q;
+  append_lowercase(q, query);
+  const std::string_view needle(q);
+  auto matches = [&](uint32_t id) {
+    const std::string_view text(index.folded.data() + index.folded_offsets[id],
+                                index.label_offsets[id] - 1 - index.folded_offsets[id]);
+    const std::string_view label(index.folded.data() + index.label_offsets[id],
+                                 index.folded_offsets[id + 1] - index.label_offsets[id]);
+    return text.find(needle) != std::string_view::npos ||
+           (!label.empty() && label.find(needle) != std::string_view::npos);
+  };
+
+  // Unter drei Zeichen gibt es kein Trigramm: linear über die bereits gefalteten Texte.
+  if (q.size() < 3) {
+    for (uint32_t id = 0; id < n; ++id) {
+      if (matches(id)) emit(id);
+    }
+    return;
+  }
+
+  struct Posting {
+    const uint32_t* begin;
+    const uint32_t* end;
+  };
+  std::vector<uint32_t> grams;
+  for (size_t k = 0; k + 3 <= q.size(); ++k) grams.push_back(trigram_at(q.data() + k));
+  std::sort(grams.begin(), grams.end());
+  grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+  std::vector<Posting> lists;
+  lists.reserve(grams.size());
+  for (uint32_t g : grams) {
+    auto it = std::lower_bound(index.trigram_keys.begin(), index.trigram_keys.end(), g);
+    if (it == index.trigram_keys.end() || *it != g) return; // Trigramm kommt nirgends vor
+    const size_t slot = (size_t)(it - index.trigram_keys.begin());
+    lists.push_back({ index.postings.data() + index.posting_offsets[slot],
+                      index.postings.data() + index.posting_offsets[slot + 1] });
+  }
+  std::sort(lists.begin(), lists.end(), [](const Posting& a, const Posting& b) {
+    return (a.end - a.begin) < (b.end - b.begin);
+  });
+
+  // Kürzeste Liste treibt, die übrigen werden per lower_bound vorgespult.
+  std::vector<const uint32_t*> cursor(lists.size());
+  for (size_t k = 0; k < lists.size(); ++k) cursor[k] = lists[k].begin;
+  for (const uint32_t* it = lists[0].begin; it != lists[0].end; ++it) {
+    const uint32_t id = *it;
+    bool in_all = true;
+    for (size_t k = 1; k < lists.size() && in_all; ++k) {
+      cursor[k] = std::lower_bound(cursor[k], lists[k].end, id);
+      in_all = cursor[k] != lists[k].end && *cursor[k] == id;
+    }
+    if (in_all && matches(id)) emit(id);
+  }
+}
+
+bool I18nEngine::get_references(const std::string& token, std::vector<std::string>& out) const {
+  out.clear();
+  auto snapshot = acquire_snapshot();
+  if (!snapshot || !snapshot->refs) return false;
+  const RefIndex& index = *snapshot->refs;
+  const uint32_t id = index.find(to_lower_ascii(token)); // Tokens sind wie bei translate case-insensitiv
+  if (id == NO_ENTRY) return false;
+  index.for_each_ref(id, [&](uint32_t target) { out.emplace_back(index.token_at(target)); });
+  index.for_each_missing(id, [&](const std::string& missing) { out.push_back(missing); });
+  std::sort(out.begin(), out.end());
+  return true;
+}
+
+bool I18nEngine::get_dependents(const std::string& token, bool transitive, std::vector<std::string>& out) const {
+  out.clear();
+  auto snapshot = acquire_snapshot();
+  if (!snapshot || !snapshot->refs) return false;
+  const RefIndex& index = *snapshot->refs;
+  const uint32_t id = index.find(to_lower_ascii(token)); // Tokens sind wie bei translate case-insensitiv
+  if (id == NO_ENTRY) return false;
+
+  // BFS über Rückwärtskanten: Aufwand proportional zur betroffenen Menge, nicht zum Katalog.
+  std::vector<uint32_t> hits;
+  std::unordered_set<uint32_t> visited{ id };
+  std::vector<uint32_t> frontier{ id };
+  while (!frontier.empty()) {
+    const uint32_t cur = frontier.back();
+    frontier.pop_back();
+    index.for_each_dependent(cur, [&](uint32_t src) {
+      if (!visited.insert(src).second) return;
+      hits.push_back(src);
+      if (transitive) frontier.push_back(src);
+    });
+  }
+  out.reserve(hits.size());
+  for (uint32_t h : hits) out.emplace_back(index.token_at(h));
+  std::sort(out.begin(), out.end()); // Overlay-IDs sind nicht nach Token sortiert
+  return true;
+}
+
+void I18nEngine::populate_style_registry(StyleCatalogSnapshot* snapshot, const std::vector<std::string>* only) {
   if (!snapshot) return;
   snapshot->style_registry.clear();
   std::vector<StyleProperty> props;
   props.reserve(8);
-  for (const auto& kv : snapshot->catalog) {
-    if (!is_style_token(kv.first)) continue;
-    if (!parse_style_properties(kv.second, props)) continue;
-    snapshot->style_registry.emplace(kv.first, props);
-  }
+  for_each_entry(snapshot, only, [&](std::string_view token, std::string_view text) {
+    if (!is_style_token(token)) return;
+    if (!parse_style_properties(text, props)) return;
+    snapshot->style_registry.emplace(std::string(token), props);
+  });
+  assign_property_ids(snapshot);
 }
 
 uint32_t I18nEngine::fnv1a32(const uint8_t* data, size_t len) noexcept {
@@ -1714,7 +5057,7 @@ bool I18nEngine::export_binary_catalog(const char* path) const {
 
     if (base.empty() || !is_hex_token(base)) return false;
 
-    entries.push_back({ base, variant, kv.second, 0, 0 });
+    entries.push_back({ base, variant, std::string(kv.second), 0, 0 });
   }
 
   std::sort(entries.begin(), entries.end(), [](const ExportEntry& a, const ExportEntry& b) {
@@ -1747,9 +5090,9 @@ bool I18nEngine::export_binary_catalog(const char* path) const {
     string_table.insert(string_table.end(), entry.text.begin(), entry.text.end());
   }
 
-  const size_t cap_locale = std::min(meta_locale.size(), (size_t)std::numeric_limits<uint16_t>::max());
-  const size_t cap_fallback = std::min(meta_fallback.size(), (size_t)std::numeric_limits<uint16_t>::max());
-  const size_t cap_note = std::min(meta_note.size(), (size_t)std::numeric_limits<uint16_t>::max());
+  const size_t cap_locale = std::min(snapshot->meta_locale.size(), (size_t)std::numeric_limits<uint16_t>::max());
+  const size_t cap_fallback = std::min(snapshot->meta_fallback.size(), (size_t)std::numeric_limits<uint16_t>::max());
+  const size_t cap_note = std::min(snapshot->meta_note.size(), (size_t)std::numeric_limits<uint16_t>::max());
   const uint16_t locale_len = (uint16_t)cap_locale;
   const uint16_t fallback_len = (uint16_t)cap_fallback;
   const uint16_t note_len = (uint16_t)cap_note;
@@ -1759,9 +5102,9 @@ bool I18nEngine::export_binary_catalog(const char* path) const {
   append_le_u16(metadata_block, locale_len);
   append_le_u16(metadata_block, fallback_len);
   append_le_u16(metadata_block, note_len);
-  if (locale_len > 0) metadata_block.insert(metadata_block.end(), meta_locale.begin(), meta_locale.begin() + locale_len);
-  if (fallback_len > 0) metadata_block.insert(metadata_block.end(), meta_fallback.begin(), meta_fallback.begin() + fallback_len);
-  if (note_len > 0) metadata_block.insert(metadata_block.end(), meta_note.begin(), meta_note.begin() + note_len);
+  if (locale_len > 0) metadata_block.insert(metadata_block.end(), snapshot->meta_locale.begin(), snapshot->meta_locale.begin() + locale_len);
+  if (fallback_len > 0) metadata_block.insert(metadata_block.end(), snapshot->meta_fallback.begin(), snapshot->meta_fallback.begin() + fallback_len);
+  if (note_len > 0) metadata_block.insert(metadata_block.end(), snapshot->meta_note.begin(), snapshot->meta_note.begin() + note_len);
   const uint32_t metadata_size = (uint32_t)metadata_block.size();
 
   uint32_t checksum = 2166136261u;
@@ -1769,7 +5112,7 @@ bool I18nEngine::export_binary_catalog(const char* path) const {
   checksum = fnv1a32_append(checksum, entry_table.data(), entry_table.size());
   checksum = fnv1a32_append(checksum, string_table.data(), string_table.size());
 
-  uint8_t plural_rule = static_cast<uint8_t>(meta_plural);
+  uint8_t plural_rule = static_cast<uint8_t>(snapshot->meta_plural);
   if (plural_rule > static_cast<uint8_t>(PluralRule::ARABIC)) plural_rule = static_cast<uint8_t>(PluralRule::DEFAULT);
 
   std::vector<uint8_t> header;
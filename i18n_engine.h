@@ -1,15 +1,223 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <unordered_map>
+#include <map>
 #include <unordered_set>
 #include <set>
 #include <functional>
 #include <cstdint>
 #include <memory>
 #include <atomic>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <condition_variable>
+#include <deque>
+#include <optional>
+#include <string_view>
+#include <stdexcept>
 
 class I18nEngine {
+public:
+  // Kompakte Property-IDs: Built-ins sind fest, Host-Kanäle folgen ab PROPERTY_BUILTIN_COUNT.
+  using PropertyId = uint16_t;
+  static constexpr PropertyId PROPERTY_MASS = 0;
+  static constexpr PropertyId PROPERTY_FRICTION = 1;
+  static constexpr PropertyId PROPERTY_RESTITUTION = 2;
+  static constexpr PropertyId PROPERTY_DRAG = 3;
+  static constexpr PropertyId PROPERTY_GRAVITY_SCALE = 4;
+  static constexpr PropertyId PROPERTY_SPACING = 5;
+  static constexpr PropertyId PROPERTY_BUILTIN_COUNT = 6;
+  static constexpr PropertyId PROPERTY_NONE = 0xFFFF;
+  static constexpr size_t MAX_CUSTOM_PROPERTIES = 16;
+
+  // Physik-Payload: JSON für Web/Preview, MessagePack für Clients, die jeden Frame parsen.
+  enum class PhysicsFormat : uint8_t { Json = 0, MessagePack = 1 };
+
+  struct RenderOptions {
+    bool minify = false; // Whitespace-Folgen im HTML auf ein Leerzeichen reduzieren
+    std::string stylesheet_href; // gesetzt: <link> statt Inline-CSS für arg-freie Styles
+  };
+
+  // Nicht besitzende Sicht auf die Args eines Aufrufs: über einen std::string-Vektor (C++-API) oder
+  // über string_views, etwa aus (Zeiger, Länge)-Paaren des C-ABI. Gültig, solange die Quelle lebt.
+  class ArgList {
+  public:
+    ArgList() noexcept = default;
+    ArgList(const std::vector<std::string>& args) noexcept : strings_(args.data()), size_(args.size()) {}
+    ArgList(const std::string_view* args, size_t count) noexcept : views_(args), size_(count) {}
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    std::string_view operator[](size_t i) const noexcept {
+      return strings_ ? std::string_view(strings_[i]) : views_[i];
+    }
+    class iterator {
+    public:
+      iterator(const ArgList* list, size_t index) noexcept : list_(list), index_(index) {}
+      std::string_view operator*() const noexcept { return (*list_)[index_]; }
+      iterator& operator++() noexcept {
+        ++index_;
+        return *this;
+      }
+      bool operator!=(const iterator& other) const noexcept { return index_ != other.index_; }
+
+    private:
+      const ArgList* list_;
+      size_t index_;
+    };
+    iterator begin() const noexcept { return { this, 0 }; }
+    iterator end() const noexcept { return { this, size_ }; }
+
+  private:
+    const std::string* strings_ = nullptr;
+    const std::string_view* views_ = nullptr;
+    size_t size_ = 0;
+  };
+
+  // Meldung nach einem Reload im Hintergrund: status 0 = neuer Snapshot aktiv, -1 = Fehler (error gesetzt),
+  // 1 = abgebrochen (durch neueren Ladeauftrag ersetzt oder per cancel()).
+  using ReloadCallback = void (*)(void* user, int status, const char* error);
+
+  enum class LoadState : uint8_t { Pending = 0, Done = 1, Failed = 2, Cancelled = 3 };
+
+  // Asynchroner Ladeauftrag; Engine-Worker und Aufrufer halten ihn gemeinsam.
+  class LoadTicket {
+  public:
+    LoadState state() const;
+    // Wartet auf den Abschluss, timeout_ms < 0: unbegrenzt. Rückgabe: Zustand danach.
+    LoadState wait(int timeout_ms) const;
+    std::string error() const;
+    void cancel() noexcept { cancelled_.store(true, std::memory_order_release); }
+
+  private:
+    friend class I18nEngine;
+    std::string path_;
+    bool strict_ = false;
+    uint64_t sequence_ = 0;
+    bool reload_ = false; // für die Statistik: reload_async statt load_async
+    ReloadCallback callback_ = nullptr;
+    void* user_ = nullptr;
+    std::atomic<bool> cancelled_{ false };
+    mutable std::mutex mutex_;
+    mutable std::condition_variable finished_;
+    LoadState state_ = LoadState::Pending;
+    std::string error_;
+  };
+
+  struct RenderJob {
+    std::string template_token;
+    std::vector<std::string> args;
+  };
+
+  struct CheckIssue {
+    enum class Kind : uint8_t { PlaceholderGap = 0, MissingRef = 1, Cycle = 2 };
+    Kind kind = Kind::PlaceholderGap;
+    bool is_error = false;
+    std::string token;
+    std::string detail; // "%0, %2" | fehlender Token | Zykluspfad "a -> b -> a"
+  };
+
+  struct CheckResult {
+    int code = 0; // 0 OK (ggf. mit Warnungen), 2 Katalog leer/nicht geladen, 3 Fehler
+    size_t tokens = 0;
+    size_t warnings = 0;
+    size_t errors = 0;
+    std::vector<CheckIssue> issues; // Scan-Befunde in Token-Reihenfolge, danach Zyklen
+  };
+
+  enum class ReportFormat : uint8_t { Text = 0, Json = 1 };
+
+  struct SearchHit {
+    std::string token;
+    std::string label;
+    std::string text;
+  };
+
+  // Views in einen festgehaltenen Snapshot; gültig, solange der erzeugende EntryCursor lebt.
+  struct EntryView {
+    std::string_view token;
+    std::string_view label;
+    std::string_view text;
+  };
+
+  // Bytes des aktiven Snapshots nach Bestandteil (Kapazitäten inkl. Hash-Buckets, ohne Allocator-Verwaltung).
+  // Bei Overlays zählen die Felder nur die eigene Ebene; geteilte Basis-Ebenen stehen gesammelt in shared_base.
+  struct MemoryStats {
+    size_t entries = 0;        // sichtbare Einträge
+    size_t arena = 0;          // Token, Text und Label hintereinander
+    size_t table = 0;          // Hash-Tabelle und Records des Katalogs
+    size_t ref_index = 0;      // Referenzgraph samt sortierter Token-Liste
+    size_t entry_refs = 0;     // Text-/Label-Zeiger je Entry-ID
+    size_t search = 0;         // Trigramm-Index, 0 solange noch nicht gesucht wurde
+    size_t style_registry = 0;
+    size_t style_info = 0;
+    size_t templates = 0;
+    size_t shared_base = 0;
+    size_t total = 0;          // Summe der eigenen Bestandteile, ohne shared_base
+  };
+
+  // Span eines langsamen Aufrufs für den Trace-Hook. Die Wurzel (parent -1) ist der API-Aufruf selbst,
+  // danach folgen die inneren Stufen in Startreihenfolge. Zeiger gelten nur während des Callbacks.
+  struct TraceEvent {
+    const char* name;      // API-Name, "translate_impl" oder "build_style_definitions"
+    const char* token;     // leer bei build_style_definitions
+    uint64_t start_ns;     // steady_clock, unter Linux CLOCK_MONOTONIC
+    uint64_t duration_ns;
+    uint64_t output_bytes;
+    uint64_t generation;   // Generation des Snapshots, gegen den der Span lief
+    int32_t arg_count;
+    int32_t depth;         // tiefste innerhalb des Spans erreichte Rekursionstiefe
+    int32_t index;         // Position im Aufruf, 0 = Wurzel
+    int32_t parent;
+  };
+  using TraceCallback = std::function<void(const TraceEvent&)>;
+
+  struct SitePage {
+    std::string output_path; // relativ zum Ausgabeordner
+    std::string template_token;
+    std::vector<std::string> args;
+  };
+
+  struct SiteBuildReport {
+    size_t rendered = 0;              // neu gerendert: neue Seite oder geänderte Abhängigkeit
+    size_t unchanged = 0;             // Abhängigkeiten unverändert, Datei nicht angefasst
+    std::vector<std::string> written; // tatsächlich (neu) geschriebene Dateien
+  };
+
+  // Ziel der Streaming-Ausgabe: puffert bis CHUNK_SIZE und reicht dann an Callback oder
+  // File-Descriptor weiter. Im String-Modus wird direkt ins Ziel geschrieben, ohne Flush.
+  class ChunkWriter {
+  public:
+    using Callback = bool (*)(void* user, const char* data, size_t len); // false = abbrechen
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+    static constexpr size_t REF_THRESHOLD = 512; // größere Blöcke gehen ohne Kopie raus
+
+    static ChunkWriter to_callback(Callback callback, void* user) noexcept;
+    static ChunkWriter to_fd(int fd) noexcept;
+    static ChunkWriter to_string(std::string& target) noexcept;
+
+    std::string& buffer() noexcept { return target_ ? *target_ : buf_; }
+    size_t bytes_written() const noexcept { return target_ ? target_->size() : flushed_ + buf_.size(); }
+    void reserve(size_t bytes);
+    void maybe_flush();
+    void write_ref(const char* data, size_t len);
+    bool finish();
+    bool failed() const noexcept { return failed_; }
+
+  private:
+    bool emit(const char* a, size_t a_len, const char* b, size_t b_len);
+
+    Callback callback_ = nullptr;
+    void* user_ = nullptr;
+    int fd_ = -1;
+    std::string* target_ = nullptr;
+    std::string buf_;
+    size_t flushed_ = 0;
+    bool failed_ = false;
+  };
+
 private:
   enum class PluralRule : uint8_t {
     DEFAULT = 0,
@@ -17,23 +225,393 @@ private:
     ARABIC  = 2
   };
 
+  static constexpr uint32_t NO_ENTRY = 0xFFFFFFFFu;
+
+  // Referenzgraph über Entry-IDs (Index in die sortierte Token-Liste), vorwärts und rückwärts als CSR.
+  // Einmal pro Snapshot gebaut; Kopien des Snapshots teilen ihn, da sich die Einträge nicht ändern.
+  // Overlays bekommen eine Ebene über dem vollen Index der Basis: neue Tokens erhalten IDs ab
+  // base->size(), neu gescannte Zeilen verdecken die der Basis. Eine Ebene über einer Ebene übernimmt
+  // deren Tabellen, base zeigt also immer auf einen vollen Index.
+  struct RefIndex {
+    struct Row {
+      std::vector<uint32_t> refs;       // in Token-Reihenfolge der Referenzen
+      std::vector<std::string> missing;
+    };
+    // Tokens mit gemeinsamem Präfix: IDs [first, last) im vollen Index, Positionen [added_first, added_last) in added_order.
+    struct PrefixRange {
+      uint32_t first = 0, last = 0;
+      uint32_t added_first = 0, added_last = 0;
+    };
+
+    std::shared_ptr<const RefIndex> base;               // nur bei Overlay-Ebenen
+    std::vector<std::string_view> tokens;               // sortiert bzw. neue Tokens der Ebene; zeigen in die Arenen der Snapshots
+    std::vector<uint32_t> fwd_offsets, fwd_edges;       // @-Referenzen von Eintrag i
+    std::vector<uint32_t> rev_offsets, rev_edges;       // Einträge, die i referenzieren
+    std::vector<uint32_t> missing_offsets;              // Referenzen auf fehlende Tokens, je Eintrag
+    std::vector<std::string> missing_tokens;
+    std::vector<uint32_t> missing_order;                // Indizes in missing_tokens, nach Token sortiert
+    std::vector<uint32_t> added_order;                  // Ebene: IDs der neuen Tokens, nach Token sortiert
+    std::unordered_map<uint32_t, Row> rows;             // Ebene: neu gescannte Zeilen
+    std::unordered_map<uint32_t, std::vector<uint32_t>> rev_rows; // Ebene: Rückwärtskanten aus rows
+
+    uint32_t size() const noexcept { return (uint32_t)tokens.size() + (base ? base->size() : 0); }
+    std::string_view token_at(uint32_t id) const noexcept {
+      if (!base) return tokens[id];
+      const uint32_t n = base->size();
+      return id < n ? base->tokens[id] : tokens[id - n];
+    }
+    uint32_t find(std::string_view token) const noexcept;
+    PrefixRange prefix_range(std::string_view prefix) const;
+    void ordered_ids(std::vector<uint32_t>& out) const; // alle IDs in Token-Reihenfolge
+
+    template <typename Fn>
+    void for_each_ref(uint32_t id, Fn&& fn) const {
+      if (const Row* row = row_of(id)) {
+        for (uint32_t target : row->refs) fn(target);
+        return;
+      }
+      const RefIndex& full = base ? *base : *this;
+      for (uint32_t e = full.fwd_offsets[id]; e < full.fwd_offsets[id + 1]; ++e) fn(full.fwd_edges[e]);
+    }
+    template <typename Fn>
+    void for_each_missing(uint32_t id, Fn&& fn) const {
+      if (const Row* row = row_of(id)) {
+        for (const auto& token : row->missing) fn(token);
+        return;
+      }
+      const RefIndex& full = base ? *base : *this;
+      for (uint32_t m = full.missing_offsets[id]; m < full.missing_offsets[id + 1]; ++m) fn(full.missing_tokens[m]);
+    }
+    // Einträge, die id referenzieren; verdeckte Basis-Zeilen zählen nicht mehr.
+    template <typename Fn>
+    void for_each_dependent(uint32_t id, Fn&& fn) const {
+      const RefIndex& full = base ? *base : *this;
+      if (id < full.size()) {
+        for (uint32_t e = full.rev_offsets[id]; e < full.rev_offsets[id + 1]; ++e) {
+          if (!row_of(full.rev_edges[e])) fn(full.rev_edges[e]);
+        }
+      }
+      auto it = rev_rows.find(id);
+      if (it != rev_rows.end()) for (uint32_t src : it->second) fn(src);
+    }
+    // Einträge, deren Referenz auf token bisher ins Leere zeigt.
+    template <typename Fn>
+    void for_each_missing_source(std::string_view token, Fn&& fn) const {
+      const RefIndex& full = base ? *base : *this;
+      auto range = std::equal_range(full.missing_order.begin(), full.missing_order.end(), token, MissingLess{ &full });
+      for (auto it = range.first; it != range.second; ++it) {
+        const uint32_t src =
+            (uint32_t)(std::upper_bound(full.missing_offsets.begin(), full.missing_offsets.end(), *it) - full.missing_offsets.begin() - 1);
+        if (!row_of(src)) fn(src);
+      }
+      for (const auto& kv : rows) { // nur bei Ebenen belegt
+        if (std::find(kv.second.missing.begin(), kv.second.missing.end(), token) != kv.second.missing.end()) fn(kv.first);
+      }
+    }
+    template <typename Fn>
+    void for_each_prefixed(std::string_view prefix, Fn&& fn) const { // unsortiert
+      const PrefixRange range = prefix_range(prefix);
+      for (uint32_t id = range.first; id < range.last; ++id) fn(id);
+      for (uint32_t k = range.added_first; k < range.added_last; ++k) fn(added_order[k]);
+    }
+
+  private:
+    struct MissingLess {
+      const RefIndex* index;
+      bool operator()(uint32_t m, std::string_view token) const noexcept { return index->missing_tokens[m] < token; }
+      bool operator()(std::string_view token, uint32_t m) const noexcept { return token < index->missing_tokens[m]; }
+    };
+    const Row* row_of(uint32_t id) const {
+      if (!base) return nullptr;
+      auto it = rows.find(id);
+      return it != rows.end() ? &it->second : nullptr;
+    }
+  };
+
+  // Text und Label je Entry-ID; das Label liegt in der Arena direkt hinter dem Text (leer = keins).
+  struct EntryRef {
+    const char* text = nullptr;
+    uint32_t text_len = 0;
+    uint32_t label_len = 0;
+    std::string_view text_view() const noexcept { return { text, text_len }; }
+    std::string_view label_view() const noexcept { return { text + text_len, label_len }; }
+  };
+
+  // Trigramm-Index für find_any über Entry-IDs des RefIndex. Pro Eintrag liegt "text\0label"
+  // kleingeschrieben im Arena-String; Postings je Trigramm sind aufsteigend nach ID.
+  struct SearchIndex {
+    std::vector<uint32_t> ids;             // Position -> Entry-ID in Token-Reihenfolge; leer = identisch
+    std::string folded;
+    std::vector<uint32_t> folded_offsets;  // n + 1
+    std::vector<uint32_t> label_offsets;   // Beginn des Labels in folded
+    std::vector<uint32_t> trigram_keys;    // sortiert, 3 Bytes je Schlüssel
+    std::vector<uint32_t> posting_offsets; // trigram_keys.size() + 1
+    std::vector<uint32_t> postings;
+  };
+
+  // Wird erst beim ersten Suchaufruf gebaut; Kopien des Snapshots teilen den Slot.
+  struct LazySearchIndex {
+    std::once_flag once;
+    std::unique_ptr<const SearchIndex> index;
+    std::atomic<bool> built{ false }; // für memory_stats: index lesbar, ohne den Bau anzustoßen
+  };
+
+  // Map mit optionaler Basis-Ebene für Overlays: eigene Einträge und maskierte Schlüssel verdecken
+  // die Basis, die nie kopiert wird. Ohne Basis verhält sie sich wie die unordered_map darunter.
+  template <typename V>
+  class LayeredMap {
+  public:
+    using Map = std::unordered_map<std::string, V>;
+    using value_type = typename Map::value_type;
+
+    // Läuft über alle sichtbaren Einträge: erst die eigenen, dann die nicht verdeckten der Basis.
+    class const_iterator {
+    public:
+      const value_type& operator*() const { return *it_; }
+      const value_type* operator->() const { return &*it_; }
+      const_iterator& operator++() {
+        ++it_;
+        settle();
+        return *this;
+      }
+      bool operator==(const const_iterator& o) const { return layer_ == o.layer_ && (!layer_ || it_ == o.it_); }
+      bool operator!=(const const_iterator& o) const { return !(*this == o); }
+
+    private:
+      friend class LayeredMap;
+      const LayeredMap* top_ = nullptr;
+      const LayeredMap* layer_ = nullptr;
+      typename Map::const_iterator it_{};
+
+      void settle() {
+        while (layer_) {
+          if (it_ == layer_->own_.end()) {
+            layer_ = layer_->base_;
+            if (layer_) it_ = layer_->own_.begin();
+            continue;
+          }
+          if (!top_->shadows(layer_, it_->first)) return;
+          ++it_;
+        }
+      }
+    };
+
+    const_iterator begin() const {
+      const_iterator it;
+      it.top_ = this;
+      it.layer_ = this;
+      it.it_ = own_.begin();
+      it.settle();
+      return it;
+    }
+    const_iterator end() const { return const_iterator(); }
+    const_iterator find(const std::string& key) const {
+      for (const LayeredMap* layer = this; layer; layer = layer->base_) {
+        auto it = layer->own_.find(key);
+        if (it != layer->own_.end()) {
+          const_iterator out;
+          out.top_ = this;
+          out.layer_ = layer;
+          out.it_ = it;
+          return out;
+        }
+        if (!layer->masked_.empty() && layer->masked_.count(key)) break;
+      }
+      return end();
+    }
+    size_t count(const std::string& key) const { return find(key) != end() ? 1 : 0; }
+    const V& at(const std::string& key) const {
+      auto it = find(key);
+      if (it == end()) throw std::out_of_range(key);
+      return it->second;
+    }
+    bool empty() const { return begin() == end(); }
+    size_t size() const {
+      if (!base_) return own_.size();
+      size_t n = 0;
+      for (auto it = begin(); it != end(); ++it) ++n;
+      return n;
+    }
+    template <typename... Args>
+    std::pair<typename Map::iterator, bool> emplace(Args&&... args) { return own_.emplace(std::forward<Args>(args)...); }
+    V& operator[](const std::string& key) { return own_[key]; }
+    void clear() { own_.clear(); }
+
+    Map& own() noexcept { return own_; }
+    const Map& own() const noexcept { return own_; }
+    bool layered() const noexcept { return base_ != nullptr; }
+    void layer_on(const LayeredMap& base) noexcept { base_ = &base; }
+    void mask(const std::string& key) { masked_.insert(key); }
+    // Übernimmt alle sichtbaren Basis-Einträge; danach ist die Ebene eigenständig.
+    void flatten() {
+      if (!base_) return;
+      for (auto it = base_->begin(); it != base_->end(); ++it) {
+        if (!masked_.count(it->first)) own_.emplace(it->first, it->second);
+      }
+      base_ = nullptr;
+      masked_.clear();
+    }
+
+  private:
+    // true, wenn key oberhalb von layer eigen definiert oder maskiert ist.
+    bool shadows(const LayeredMap* layer, const std::string& key) const {
+      for (const LayeredMap* l = this; l != layer; l = l->base_) {
+        if (l->own_.count(key) || (!l->masked_.empty() && l->masked_.count(key))) return true;
+      }
+      return false;
+    }
+
+    Map own_;
+    std::unordered_set<std::string> masked_;
+    const LayeredMap* base_ = nullptr;
+  };
+
+  // Kompakte Einträge eines Snapshots: Token, Text und Label liegen hintereinander in einer Arena,
+  // eine offene Hash-Tabelle (lineares Sondieren) führt vom Token zur Record-Nummer. Pluralvarianten
+  // sind normale Einträge ("base{one}"). Kopien teilen die unveränderliche Arena; Overlays legen
+  // eine eigene Ebene über die Basis, wie LayeredMap.
+  // Hex-Token (6–32 Zeichen) als Zahl: bis zu 128 Bit plus Ziffernanzahl, damit führende Nullen zählen.
+  // Groß-/Kleinschreibung ist mit dem Dekodieren erledigt.
+  struct HexKey {
+    uint64_t hi = 0;
+    uint64_t lo = 0;
+    uint32_t len = 0;
+    bool operator==(const HexKey& o) const noexcept { return hi == o.hi && lo == o.lo && len == o.len; }
+    uint32_t hash() const noexcept {
+      const uint64_t h = (hi * 0x9E3779B97F4A7C15ull ^ lo ^ len) * 0xFF51AFD7ED558CCDull;
+      return (uint32_t)(h >> 32);
+    }
+  };
+
+  class FlatCatalog {
+  public:
+    using value_type = std::pair<std::string_view, std::string_view>; // Token, Text
+
+    class const_iterator {
+    public:
+      const value_type& operator*() const noexcept { return kv_; }
+      const value_type* operator->() const noexcept { return &kv_; }
+      std::string_view label() const noexcept;
+      const_iterator& operator++();
+      bool operator==(const const_iterator& o) const noexcept {
+        return layer_ == o.layer_ && (!layer_ || index_ == o.index_);
+      }
+      bool operator!=(const const_iterator& o) const noexcept { return !(*this == o); }
+
+    private:
+      friend class FlatCatalog;
+      const FlatCatalog* top_ = nullptr;
+      const FlatCatalog* layer_ = nullptr;
+      uint32_t index_ = 0;
+      value_type kv_;
+      void settle();
+    };
+
+    const_iterator begin() const;
+    const_iterator end() const noexcept { return const_iterator(); }
+    const_iterator find(std::string_view token) const; // Hex-Tokens gehen über find(HexKey)
+    const_iterator find(const HexKey& key) const;
+    size_t count(std::string_view token) const { return find(token) != end() ? 1 : 0; }
+    std::string_view at(std::string_view token) const;
+    bool empty() const { return begin() == end(); }
+    size_t size() const;
+    // Grenzen des Record-Layouts: Token-Längen sind uint16, Arena-Offsets uint32.
+    static constexpr size_t MAX_TOKEN_BYTES = UINT16_MAX;
+    static constexpr size_t MAX_ARENA_BYTES = UINT32_MAX;
+    enum class Emplaced : uint8_t { Inserted, Duplicate, TooLarge };
+    // Duplicate, wenn das Token in dieser Ebene schon existiert; TooLarge, wenn es eine der Grenzen sprengt.
+    Emplaced emplace(std::string_view token, std::string_view text, std::string_view label = {});
+    void reserve(size_t entries, size_t arena_bytes);
+    void layer_on(const FlatCatalog& base) noexcept { base_ = &base; }
+    bool layered() const noexcept { return base_ != nullptr; }
+    size_t own_size() const noexcept { return records_.size(); }
+    size_t arena_bytes() const noexcept { return arena_->capacity(); }
+    size_t table_bytes() const noexcept {
+      return records_.capacity() * sizeof(Record) + (slots_.capacity() + hex_slots_.capacity()) * sizeof(uint32_t);
+    }
+
+  private:
+    // Hex-Records tragen ihren Schlüssel selbst: ein Treffer kostet Slot, Record und Text, wie bei Namen.
+    struct Record {
+      uint64_t key_hi; // HexKey, bei Namen 0
+      uint64_t key_lo;
+      uint32_t hash;   // FNV-1a über den Namen bzw. HexKey::hash
+      uint32_t offset; // Token, danach Text, danach Label
+      uint32_t text_len;
+      uint32_t label_len;
+      uint16_t token_len;
+      bool hex;
+    };
+    template <typename Match>
+    static uint32_t probe(const std::vector<uint32_t>& slots, uint32_t hash, Match&& match) noexcept;
+    uint32_t find_own(std::string_view token, uint32_t hash) const noexcept;
+    uint32_t find_own(const HexKey& key) const noexcept;
+    bool shadows(const FlatCatalog* layer, std::string_view token) const;
+    const_iterator make_iterator(const FlatCatalog* layer, uint32_t index) const noexcept;
+    static void rehash(std::vector<uint32_t>& slots, const std::vector<Record>& records, bool hex, size_t capacity);
+    std::string_view token_of(const Record& r) const noexcept { return { arena_->data() + r.offset, r.token_len }; }
+
+    std::shared_ptr<std::string> arena_ = std::make_shared<std::string>();
+    std::vector<Record> records_;
+    std::vector<uint32_t> slots_;     // Namen (style_/tpl_, Pluralvarianten); Potenz von zwei, NO_ENTRY = frei
+    std::vector<uint32_t> hex_slots_; // Hex-Tokens nach HexKey; dito
+    size_t hex_count_ = 0;
+    const FlatCatalog* base_ = nullptr;
+  };
+
   struct CatalogSnapshot {
-    std::unordered_map<std::string, std::string> catalog;
-    std::unordered_map<std::string, std::string> labels;
-    std::unordered_map<std::string, std::set<std::string>> plural_variants;
+    FlatCatalog catalog;
     std::string meta_locale;
     std::string meta_fallback;
     std::string meta_note;
     PluralRule meta_plural = PluralRule::DEFAULT;
+    std::shared_ptr<const RefIndex> refs;
+    std::shared_ptr<const std::vector<EntryRef>> entries; // nach IDs des vollen Index; Kopien und Overlays teilen es
+    std::unordered_map<uint32_t, EntryRef> entry_overrides; // Overlay: geänderte und neue Einträge
+    const EntryRef& entry(uint32_t id) const {
+      if (!entry_overrides.empty()) {
+        auto it = entry_overrides.find(id);
+        if (it != entry_overrides.end()) return it->second;
+      }
+      return (*entries)[id];
+    }
+    std::shared_ptr<LazySearchIndex> search = std::make_shared<LazySearchIndex>();
+    std::shared_ptr<const CatalogSnapshot> base; // Overlay: darunterliegender Snapshot, hält die Basis-Ebenen am Leben
+    uint64_t generation = next_snapshot_generation(); // steigt mit jedem gebauten Snapshot; Kopien neu vergeben
     virtual ~CatalogSnapshot() = default;
   };
 
   struct StyleProperty {
-    uint32_t prop_hash;
+    uint32_t prop_hash;      // FNV1a32 über den Namen ohne führendes "--"
+    PropertyId prop_id = PROPERTY_NONE;
     std::string prop_name;
     std::string value;
   };
 
+  // Registry der physikalischen Kanäle. Wird beim Laden an den Snapshot gebunden,
+  // damit StyleProperty::prop_id und Auswertung immer zum selben Schema passen.
+  struct PropertySchema {
+    std::vector<std::string> custom_names;
+    std::unordered_map<uint32_t, PropertyId> custom_by_hash;
+    PropertyId resolve(uint32_t hash, const std::string& name) const;
+    size_t channel_count() const noexcept { return PROPERTY_BUILTIN_COUNT + custom_names.size(); }
+  };
+
+public:
+  // Aufzählung in Token-Reihenfolge ohne Kopien: hält den Snapshot fest, Sortierung stammt aus dessen RefIndex.
+  class EntryCursor {
+  public:
+    bool next(EntryView& out) noexcept;
+    size_t remaining() const noexcept {
+      return (size_t)(range_.last - range_.first) + (range_.added_last - range_.added_first);
+    }
+
+  private:
+    friend class I18nEngine;
+    std::shared_ptr<const CatalogSnapshot> snapshot_;
+    RefIndex::PrefixRange range_; // Overlay: Basis- und neue Tokens werden beim Lesen zusammengeführt
+  };
+
   struct NativeStyle {
     float mass = 0.0f;
     float friction = 0.0f;
@@ -42,20 +620,239 @@ private:
     float gravity_scale = 1.0f;
     float spacing = 0.0f;
     bool has_physical = false;
+    float custom[MAX_CUSTOM_PROPERTIES] = {};
+    uint32_t set_mask = 0; // Bit = PropertyId, gesetzt wenn der Kanal im Style definiert ist
+  };
+
+private:
+  // Vorkompiliertes tpl_-Template: Segmentliste plus statisches Style-Manifest.
+  struct TemplateSegment {
+    enum class Kind : uint8_t { Literal, Arg, StyleClass };
+    Kind kind = Kind::Literal;
+    uint32_t arg_index = 0;
+    std::string text; // Literal: HTML-Text, StyleClass: sanitisierter Klassenname
+  };
+
+  struct ManifestEntry {
+    std::string token;
+    bool arg_free = false;
+    std::string definition; // ".klasse{...}\n" für arg-freie Styles, sonst leer
+  };
+
+  struct CompiledTemplate {
+    std::vector<TemplateSegment> segments;
+    std::vector<ManifestEntry> style_manifest; // nach Token sortiert
+    std::vector<uint32_t> arg_indices;         // eindeutige %N-Indizes
+    std::string physics_json;                  // gültig, wenn arg_indices leer ist
+    std::string physics_msgpack;               // dito, MessagePack-Kodierung
+    bool split_tokens = false;                 // "@style_%0": Segmentierung nicht möglich
+  };
+
+  // Zustand über Chunk-Grenzen hinweg: Minify entscheidet nie anhand bereits geflushter Bytes.
+  struct HtmlEmitState {
+    bool minify = false;
+    bool wrote_text = false;    // schon etwas ausgegeben, führender Whitespace entfällt
+    bool pending_space = false; // zusammengefasster Whitespace, erst vor dem nächsten Text geschrieben
+  };
+
+  struct StyleCollector {
+    std::vector<std::string> tokens;
+    std::unordered_set<std::string> seen;
+  };
+
+  struct StyleInfo {
+    std::string css_class;  // einmal pro Snapshot sanitisiert
+    bool uses_args = false; // Referenz-Hülle enthält %N
   };
 
   struct StyleCatalogSnapshot : CatalogSnapshot {
-    std::unordered_map<std::string, std::vector<StyleProperty>> style_registry;
+    LayeredMap<std::vector<StyleProperty>> style_registry;
+    LayeredMap<StyleInfo> style_info;
+    LayeredMap<CompiledTemplate> templates;
+    std::shared_ptr<const PropertySchema> schema;
+  };
+
+  // Für den inkrementellen Site-Build: Token samt Inhalts-Hash zum Zeitpunkt des Renderns.
+  struct TokenDependency {
+    std::string token;
+    uint64_t value_hash = 0; // 0 = Token fehlte im Katalog
+  };
+
+  struct SitePageState {
+    std::string signature; // Template, Args und Render-Optionen
+    std::vector<TokenDependency> deps;
+    uint64_t output_hash = 0;
   };
 
   std::shared_ptr<const CatalogSnapshot> active_snapshot;
-  std::string last_error;
-  std::string current_path;
-  bool current_strict = false;
-  std::string meta_locale;
-  std::string meta_fallback;
-  std::string meta_note;
-  PluralRule meta_plural = PluralRule::DEFAULT;
+  std::shared_ptr<const PropertySchema> property_schema = std::make_shared<PropertySchema>();
+  const uint64_t instance_id = next_instance_id(); // Schlüssel für den Fehlertext pro Thread
+  // Quelle des zuletzt aus einer Datei geladenen Snapshots, Basis für reload(). Geschützt durch install_mutex.
+  struct LoadSource {
+    std::string path;
+    bool strict = false;
+  };
+  LoadSource current_source;
+  std::mutex install_mutex;
+  std::unordered_map<std::string, SitePageState> site_pages;
+  SiteBuildReport last_site_report;
+  std::mutex site_mutex;
+
+  // Hot-Reload-Watcher. Linux: inotify auf Datei und Verzeichnis, sonst Polling der Änderungszeit.
+  struct CatalogWatcher {
+    std::string path;
+    bool strict = false;
+    int debounce_ms = 0;
+    ReloadCallback callback = nullptr;
+    void* user = nullptr;
+    uint64_t content_hash = 0;   // Hash des zuletzt geladenen (oder verworfenen) Inhalts
+    std::atomic<bool> stop{ false };
+    int notify_fd = -1;
+    int dir_watch = -1;
+    int file_watch = -1;
+    int wake_fd[2] = { -1, -1 }; // Pipe, die poll() beim Stoppen aufweckt
+    std::thread thread;
+  };
+  std::unique_ptr<CatalogWatcher> watcher;
+  // Aus dem eigenen Callback gestoppte Watcher: ihr Thread kann sich nicht selbst joinen, das
+  // übernimmt der nächste watch_start/watch_stop von außen oder der Destruktor.
+  std::vector<std::unique_ptr<CatalogWatcher>> retired_watchers;
+  std::mutex watch_mutex;
+
+  // Asynchrones Laden: ein Worker pro Engine. Jeder Ladeauftrag (auch synchron) erhöht load_sequence;
+  // ältere Aufträge sehen das und werden verworfen, statt einen neueren Snapshot zu überschreiben.
+  std::thread load_worker;
+  std::mutex load_mutex;
+  std::condition_variable load_wakeup;
+  std::deque<std::shared_ptr<LoadTicket>> load_queue;
+  bool load_shutdown = false;
+  std::atomic<uint64_t> load_sequence{ 0 };
+
+  // Eine geladene Locale und die beim Laden vorberechnete Sicht über ihre Fallback-Kette.
+  struct LocaleSlot {
+    std::shared_ptr<const CatalogSnapshot> own;
+    std::shared_ptr<const CatalogSnapshot> merged;
+    std::vector<std::string> chain; // die Locale selbst, dann ihre Fallbacks in Suchreihenfolge
+  };
+  std::map<std::string, LocaleSlot> locales; // geordnet, damit die Sprachzuordnung deterministisch ist
+  std::string current_locale;
+  mutable std::mutex locale_mutex;
+
+  // Laufzeitstatistik, immer aktiv. Jeder Thread zählt per relaxed-Atomics in einen festen Shard
+  // (Round-Robin beim ersten Zugriff), damit parallele Aufrufer sich keine Cachezeile teilen.
+  // Export und Reset summieren bzw. leeren alle Shards.
+  enum class StatCall : uint8_t { Translate, TranslatePlural, RenderHtml, NativeStyle, Load, Reload, Count };
+  enum class StatEvent : uint8_t {
+    CacheHit, CacheMiss, Missing, Cycle, RecursionLimit, ResultTooLarge, ScratchResize, Count
+  };
+  enum class LoadPhase : uint8_t { Read, Parse, StyleRegistry, Index, Install, Count };
+  static constexpr size_t STAT_CALLS = (size_t)StatCall::Count;
+  static constexpr size_t STAT_EVENTS = (size_t)StatEvent::Count;
+  static constexpr size_t LOAD_PHASES = (size_t)LoadPhase::Count;
+  static constexpr size_t STATS_SHARDS = 16;
+  static constexpr size_t LATENCY_BUCKETS = 24; // Bucket k: bis 256 ns << k, der letzte ist nach oben offen
+  // Zwei Uhr-Lesungen kosten ein Mehrfaches der Zählung: Lookup-APIs messen die Latenz nur bei jedem
+  // n-ten Aufruf eines Threads, Ladevorgänge immer. Die Aufrufzahl selbst ist immer exakt.
+  static constexpr uint32_t LATENCY_SAMPLE_EVERY = 8;
+  struct alignas(64) StatsShard {
+    std::atomic<uint64_t> calls[STAT_CALLS]{};
+    std::atomic<uint64_t> timed[STAT_CALLS]{};   // gemessene Aufrufe, Grundlage von call_ns und latency
+    std::atomic<uint64_t> call_ns[STAT_CALLS]{};
+    std::atomic<uint64_t> latency[STAT_CALLS][LATENCY_BUCKETS]{};
+    std::atomic<uint64_t> events[STAT_EVENTS]{};
+    std::atomic<uint64_t> phase_runs[LOAD_PHASES]{};
+    std::atomic<uint64_t> phase_ns[LOAD_PHASES]{};
+  };
+  mutable StatsShard stats_shards[STATS_SHARDS];
+  std::atomic<uint64_t> last_phase_ns[LOAD_PHASES]{}; // Dauer je Phase beim jüngsten Lauf
+  // Über alle Shards summierter Stand, Grundlage beider Exporte.
+  struct StatsTotals {
+    uint64_t calls[STAT_CALLS]{};
+    uint64_t timed[STAT_CALLS]{};
+    uint64_t call_ns[STAT_CALLS]{};
+    uint64_t latency[STAT_CALLS][LATENCY_BUCKETS]{};
+    uint64_t events[STAT_EVENTS]{};
+    uint64_t phase_runs[LOAD_PHASES]{};
+    uint64_t phase_ns[LOAD_PHASES]{};
+    uint64_t last_phase_ns[LOAD_PHASES]{};
+  };
+  StatsTotals collect_stats() const;
+
+  // Misst vom Konstruktor bis zum Destruktor und bucht das Ergebnis auf einen Aufruf oder eine Ladephase.
+  class ScopedStat {
+  public:
+    ScopedStat(I18nEngine& engine, StatCall call) noexcept;
+    ScopedStat(I18nEngine& engine, LoadPhase phase) noexcept;
+    ~ScopedStat() { stop(); }
+    void stop() noexcept; // vorzeitig buchen; danach bucht der Destruktor nichts mehr
+    ScopedStat(const ScopedStat&) = delete;
+    ScopedStat& operator=(const ScopedStat&) = delete;
+
+  private:
+    I18nEngine& engine_;
+    bool phase_;
+    bool timed_ = true;
+    bool running_ = true;
+    uint8_t slot_;
+    std::chrono::steady_clock::time_point start_;
+  };
+  StatsShard& stats_shard() const noexcept;
+  void count_event(StatEvent event) noexcept;
+
+  // Trace-Hook. Jeder verfolgte Wurzel-Aufruf hält seinen Hook per shared_ptr; ein ersetzter Hook wird
+  // frei, sobald der letzte davon endet. Ohne Hook kostet ein Span eine relaxed-Ladeoperation von tracing.
+  struct TraceHook {
+    TraceCallback callback;
+    uint64_t threshold_ns = 0;
+    double sample_rate = 1.0;
+  };
+  static constexpr size_t MAX_TRACE_SPANS = 1024; // je Wurzel-Aufruf, weitere innere Spans entfallen
+  std::shared_ptr<const TraceHook> trace_hook; // nur über std::atomic_load/atomic_store
+  std::atomic<bool> tracing{ false };
+  std::mutex trace_mutex;
+
+  // Zeichnet einen Span auf, wenn ein Hook gesetzt ist. Call: öffentlicher Aufruf, wird Wurzel, wenn der
+  // Thread gerade nichts verfolgt und die Stichprobe ihn wählt. Inner: nur innerhalb einer laufenden Wurzel.
+  enum class TraceKind : uint8_t { Call, Inner };
+  class TraceScope {
+  public:
+    TraceScope(I18nEngine& engine, TraceKind kind, const char* name, std::string_view token, size_t arg_count,
+               const CatalogSnapshot* snapshot, int depth = 0) {
+      if (engine.tracing.load(std::memory_order_relaxed)) {
+        begin(engine, kind, name, token, arg_count, snapshot, depth);
+      }
+    }
+    ~TraceScope() {
+      if (index_ >= 0) end();
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+    bool active() const noexcept { return index_ >= 0; }
+    void set_output(size_t bytes) noexcept { output_ = bytes; }
+    // Ausgabegröße als Zuwachs von out bzw. stream zwischen diesem Aufruf und dem Ende des Spans.
+    void measure_output(const std::string* out, const ChunkWriter* stream = nullptr) noexcept {
+      if (index_ < 0) return;
+      out_ = out;
+      stream_ = stream;
+      output_start_ = stream ? stream->bytes_written() : out->size();
+    }
+
+  private:
+    void begin(I18nEngine& engine, TraceKind kind, const char* name, std::string_view token, size_t arg_count,
+               const CatalogSnapshot* snapshot, int depth);
+    void end();
+    int32_t index_ = -1; // -1: nicht aufgezeichnet
+    size_t output_ = 0;
+    size_t output_start_ = 0;
+    const std::string* out_ = nullptr;
+    const ChunkWriter* stream_ = nullptr;
+  };
+
+  bool add_locale(std::string name, std::shared_ptr<CatalogSnapshot> snapshot);
+  void leave_locale_mode();
+  std::string resolve_locale_name(const std::string& requested) const;
+  bool rebuild_locale_views(const std::string& changed);
+  std::shared_ptr<CatalogSnapshot> merge_locale_chain(const std::vector<std::string>& chain);
 
   static bool is_ws(unsigned char c) noexcept;
   static bool is_digit(unsigned char c) noexcept;
@@ -63,77 +860,268 @@ private:
   static bool is_digit_uc(char c) noexcept;
   static bool is_xdigit_uc(char c) noexcept;
   static void trim_inplace(std::string& s);
-  static bool is_hex_token(const std::string& s);
+  static bool is_hex_token(std::string_view s);
   static void strip_utf8_bom(std::string& s);
   static std::string to_lower_ascii(std::string s);
-  static std::string unescape_txt_min(const std::string& s);
-  static bool parse_line(const std::string& line_in,
+  static void append_lower_ascii(std::string& out, std::string_view s);
+  static std::string_view trim_view(std::string_view s) noexcept;
+  static void unescape_txt_min(std::string_view s, std::string& out);
+  static bool parse_line(std::string_view line,
                          std::string& out_token,
                          std::string& out_label,
                          std::string& out_text,
                          std::string& out_err);
-  static bool is_style_token(const std::string& token) noexcept;
-  static bool parse_style_properties(const std::string& text, std::vector<StyleProperty>& out_props);
+  static bool is_style_token(std::string_view token) noexcept;
+  static bool parse_style_properties(std::string_view text, std::vector<StyleProperty>& out_props);
   static bool parse_physical_value(const std::string& text, float& out_value);
-  static NativeStyle build_native_style(const std::vector<StyleProperty>& props);
-  static void populate_style_registry(StyleCatalogSnapshot* snapshot);
+  static std::string normalize_property_name(const std::string& name);
+  static PropertyId resolve_builtin_property(uint32_t hash, const std::string& name) noexcept;
+  // only: nur diese Tokens neu berechnen (Overlay), sonst den ganzen Katalog.
+  static void populate_style_registry(StyleCatalogSnapshot* snapshot, const std::vector<std::string>* only = nullptr);
+  template <typename Fn>
+  static void for_each_entry(const CatalogSnapshot* snapshot, const std::vector<std::string>* only, Fn&& fn) {
+    if (!only) {
+      for (auto it = snapshot->catalog.begin(); it != snapshot->catalog.end(); ++it) fn(it->first, it->second);
+      return;
+    }
+    for (const auto& token : *only) {
+      auto it = snapshot->catalog.find(token);
+      if (it != snapshot->catalog.end()) fn(it->first, it->second);
+    }
+  }
+  static std::shared_ptr<const RefIndex> build_ref_index(const FlatCatalog& catalog);
+  // Overlay: Ebene über Index und Einträgen der Basis, Aufwand proportional zu den geänderten Tokens.
+  static void layer_ref_index(CatalogSnapshot* snapshot, const CatalogSnapshot& base, const std::vector<std::string>& changed);
+  void finish_snapshot(StyleCatalogSnapshot* snapshot); // Style-Registry, Templates und Referenzindex
+  static void bind_entries(CatalogSnapshot* snapshot); // nur für volle Indizes
+  static void account_snapshot(const CatalogSnapshot* snapshot, MemoryStats& out);
+  static const SearchIndex& search_index(const CatalogSnapshot* snapshot);
+  static void search_entries(const CatalogSnapshot* snapshot, const std::string& query, std::vector<uint32_t>& out_ids);
+  static void assign_property_ids(StyleCatalogSnapshot* snapshot);
   static std::string read_file_utf8(const char* path, std::string& err);
-  static bool try_parse_inline_token(const std::string& s, size_t at_pos,
+  static bool try_parse_inline_token(std::string_view s, size_t at_pos,
                                      std::string& out_token, size_t& out_advance);
-  static void scan_inline_refs(const std::string& text, std::vector<std::string>& out_refs);
+  static void scan_inline_refs(std::string_view text, std::vector<std::string>& out_refs);
   static bool looks_like_binary_catalog(const std::string& data) noexcept;
-  static bool parse_variant_suffix(const std::string& token, std::string& out_base, std::string& out_variant);
-  static bool is_variant_valid(const std::string& variant) noexcept;
-  static bool is_template_token(const std::string& token) noexcept;
+  static bool parse_variant_suffix(std::string_view token, std::string& out_base, std::string& out_variant);
+  static bool is_variant_valid(std::string_view variant) noexcept;
+  static bool is_template_token(std::string_view token) noexcept;
   static uint32_t fnv1a32(const uint8_t* data, size_t len) noexcept;
+  static bool decode_hex_key(std::string_view token, HexKey& out) noexcept;
   static bool parse_meta_line(const std::string& line, std::string& key, std::string& value);
   static PluralRule parse_plural_rule_name(std::string v, bool& ok);
   static const char* pick_variant_name(PluralRule rule, int count) noexcept;
   static bool starts_with(const std::string& s, const char* pref);
+  static uint64_t next_instance_id() noexcept;
+  static uint64_t next_snapshot_generation() noexcept;
   void set_last_error(std::string msg);
   void clear_last_error();
   friend void set_engine_error(I18nEngine* eng, const std::string& msg);
   friend void clear_engine_error(I18nEngine* eng);
+  friend void count_result_too_large(I18nEngine* eng);
+
+  // Aktive Expansionskette für die Zyklenerkennung, auf dem Stack des äußersten Aufrufs. Jede Stufe
+  // erhöht depth, und ab MAX_RESOLVE_DEPTH wird abgebrochen; die Kette passt daher immer ins Array.
+  static constexpr int MAX_RESOLVE_DEPTH = 32;
+  struct ArgCache;
+  struct ArgSlot;
+  struct ResolvePath {
+    ResolvePath() = default;
+    explicit ResolvePath(ArgCache& cache) noexcept : arg_cache(&cache) {}
+    std::string_view tokens[MAX_RESOLVE_DEPTH + 2];
+    size_t size = 0;
+    ArgCache* arg_cache = nullptr; // Args des Top-Level-Aufrufs; ohne Cache wird jedes %N neu aufgelöst
+    ArgSlot* recording = nullptr;  // Arg, dessen Expansion gerade aufgezeichnet wird
+    bool contains(std::string_view token) const noexcept;
+  };
+  // Zwischenspeicher des Resolvers, einer je Thread. Strings werden stapelweise vergeben (ScratchFrame)
+  // und behalten ihre Kapazität über Aufrufe hinweg: nach dem Aufwärmen legt der Resolver nichts mehr
+  // auf dem Heap an. Ändert sich dabei eine Kapazität, zählt der äußerste Frame das als
+  // StatEvent::ScratchResize. Andere Allokationen (Plural-Formen, Templates) erfasst das nicht.
+  static constexpr size_t SCRATCH_KEEP_BYTES = 64 * 1024; // größere Strings gibt der äußerste Frame frei
+  struct ResolveScratch {
+    std::deque<std::string> strings; // deque: Referenzen bleiben beim Anhängen gültig
+    std::vector<size_t> capacities;  // Kapazität je String beim letzten Abgleich
+    size_t used = 0;
+    size_t peak = 0;                 // höchster Füllstand seit dem letzten Abgleich
+  };
+  class ScratchFrame {
+  public:
+    explicit ScratchFrame(I18nEngine& engine) noexcept;
+    ~ScratchFrame();
+    ScratchFrame(const ScratchFrame&) = delete;
+    ScratchFrame& operator=(const ScratchFrame&) = delete;
+    std::string& take(); // leerer String, gültig bis zum Ende dieses Frames
+
+  private:
+    I18nEngine& engine_;
+    ResolveScratch& scratch_;
+    size_t mark_;
+  };
+  // Args eines Top-Level-Aufrufs, beim Eintritt einmal klassifiziert: Literal ("=..."), Text oder
+  // Katalog-Referenz. Eine Referenz wird beim ersten %N expandiert und die Expansion danach an jeder
+  // Stelle und in jeder Tiefe wiederverwendet, sofern sie dort gleich ausfiele: keiner ihrer Tokens
+  // liegt auf dem aktuellen Pfad (sonst ⟦CYCLE⟧) und das Tiefenlimit reicht noch.
+  static constexpr size_t ARG_CACHE_SLOTS = 16; // weitere Args laufen ungecacht über resolve_arg
+  static constexpr size_t ARG_CLOSURE_MAX = 8;  // Expansionen über mehr Tokens werden nicht gecacht
+  // Trivial konstruierbar: ArgCache liegt bei jedem Aufruf auf dem Stack und setzt nur die Slots
+  // der vorhandenen Args.
+  struct ArgSlot {
+    struct KeyRef {
+      const char* data;
+      size_t size;
+    };
+    const std::string* key;      // Referenz: normalisierter Katalog-Key; sonst nullptr und text gilt
+    const char* text;            // Literal ohne '=' bzw. Text, wie er ist
+    size_t text_size;
+    std::string* value;          // Referenz: Expansion, gültig ab ready
+    bool ready;
+    bool cacheable;              // während der Aufzeichnung: kein Zyklus, kein Tiefenlimit
+    int base_depth;              // depth beim aufgezeichneten %N
+    int max_depth;               // tiefste Stufe der Expansion
+    size_t closure_size;
+    KeyRef closure[ARG_CLOSURE_MAX]; // expandierte Tokens (Snapshot-Keys)
+  };
+  struct ArgCache {
+    ArgCache(I18nEngine& engine, const CatalogSnapshot* state, ArgList args);
+    std::optional<ScratchFrame> frame; // erst bei der ersten Referenz; Text-Args brauchen keinen Speicher
+    ArgSlot slots[ARG_CACHE_SLOTS];
+    size_t size = 0;
+  };
 
-  std::string resolve_arg(const CatalogSnapshot* state,
-                          const std::string& arg,
-                          std::unordered_set<std::string>& seen,
-                          int depth);
-  std::string resolve_plain_text(const CatalogSnapshot* state,
-                                 const std::string& raw,
-                                 const std::vector<std::string>& args,
-                                 std::unordered_set<std::string>& seen,
-                                 int depth);
-  std::string translate_impl(const CatalogSnapshot* state,
-                             const std::string& token,
-                             const std::vector<std::string>& args,
-                             std::unordered_set<std::string>& seen,
-                             int depth);
+  // true, wenn arg (ohne '=') auf einen Katalog-Eintrag zeigt: Hex-Token, ggf. mit {variante}.
+  // key erhält dann den normalisierten Schlüssel.
+  bool find_arg_reference(const CatalogSnapshot* state, std::string_view arg, std::string& key);
+  // Alle Resolver hängen an out an, statt Teilergebnisse als eigene Strings zurückzugeben.
+  void resolve_arg(const CatalogSnapshot* state,
+                   std::string_view arg,
+                   ResolvePath& path,
+                   int depth,
+                   std::string& out);
+  // args[idx] über den ArgCache des Pfads, sonst wie resolve_arg.
+  void append_arg(const CatalogSnapshot* state,
+                  ArgList args,
+                  size_t idx,
+                  ResolvePath& path,
+                  int depth,
+                  std::string& out);
+  // Während path.recording: Tiefe und Token (nullptr bei resolve_plain_text) der laufenden Expansion festhalten.
+  static void record_expansion(ResolvePath& path, const CatalogSnapshot* state, const std::string* token, int depth);
+  static bool arg_reusable(const ArgSlot& slot, const ResolvePath& path, int depth) noexcept;
+  void resolve_plain_text(const CatalogSnapshot* state,
+                          std::string_view raw,
+                          ArgList args,
+                          ResolvePath& path,
+                          int depth,
+                          std::string& out);
+  void translate_into(const CatalogSnapshot* state,
+                      const std::string& token,
+                      ArgList args,
+                      ResolvePath& path,
+                      int depth,
+                      std::string& out,
+                      ChunkWriter* stream);
+  // Hängt die Style-Deklarationen an out an; false (out unverändert), wenn token kein Style ist
+  // oder nichts ergibt.
   bool try_build_style_string(const StyleCatalogSnapshot* style_state,
                               const std::string& token,
-                              const std::vector<std::string>& args,
-                              std::unordered_set<std::string>& seen,
+                              ArgList args,
+                              ResolvePath& path,
                               int depth,
-                              std::string& out_style);
-  std::string resolve_template_placeholders(const CatalogSnapshot* state,
-                                            const std::string& raw,
-                                            const std::vector<std::string>& args,
-                                            std::unordered_set<std::string>& seen,
-                                            int depth);
+                              std::string& out);
+  void resolve_template_placeholders(const CatalogSnapshot* state,
+                                     std::string_view raw,
+                                     ArgList args,
+                                     ResolvePath& path,
+                                     int depth,
+                                     std::string& out);
   bool build_style_definitions(const StyleCatalogSnapshot* style_state,
                                const std::vector<std::string>& tokens,
-                               const std::vector<std::string>& args,
-                               std::string& out_defs);
+                               ArgList args,
+                               std::string& out_defs,
+                               const CompiledTemplate* compiled = nullptr,
+                               ArgCache* arg_cache = nullptr);
+  static const ManifestEntry* find_manifest_entry(const CompiledTemplate& compiled, const std::string& token);
+  static bool style_uses_args(const CatalogSnapshot* state, const std::string& token,
+                              std::unordered_map<std::string, int8_t>& memo);
+  void index_styles(StyleCatalogSnapshot* snapshot, const std::vector<std::string>* only = nullptr);
+  void compile_templates(StyleCatalogSnapshot* snapshot, const std::vector<std::string>* only = nullptr);
+  std::shared_ptr<CatalogSnapshot> build_overlay_snapshot(std::shared_ptr<const StyleCatalogSnapshot> base,
+                                                          const CatalogSnapshot& delta);
+  bool push_overlay(std::shared_ptr<CatalogSnapshot> delta);
+  void render_compiled_body(const StyleCatalogSnapshot* style_state,
+                            const CompiledTemplate& compiled,
+                            const std::vector<std::string>& arg_values,
+                            size_t arg_count,
+                            HtmlEmitState& emit,
+                            ChunkWriter& out);
+  static void collect_html_styles(std::string_view src, StyleCollector& styles);
+  std::vector<std::string> render_batch_snapshot(const StyleCatalogSnapshot* style_snapshot,
+                                                 const std::vector<RenderJob>& jobs,
+                                                 const RenderOptions& options,
+                                                 unsigned threads);
+  static uint64_t dependency_hash(const CatalogSnapshot* state, std::string_view token);
+  void collect_dependencies(const StyleCatalogSnapshot* style_state,
+                            const std::string& template_token,
+                            ArgList args,
+                            std::vector<TokenDependency>& out);
+  bool render_snapshot(const StyleCatalogSnapshot* style_snapshot,
+                       std::string_view template_token,
+                       ArgList args,
+                       const RenderOptions& options,
+                       ChunkWriter& out);
   static std::string sanitize_css_class(const std::string& token);
-  static void replace_all(std::string& subject, const std::string& search, const std::string& replacement);
-  std::vector<std::string> gather_style_tokens(const std::string& text) const;
-  std::string get_physics_json(const std::vector<std::string>& style_tokens);
-  std::string get_physics_json_from_template(const std::string& template_token, const std::vector<std::string>& args);
+  static const std::string& css_class_for(const StyleCatalogSnapshot* style_state,
+                                          const std::string& token,
+                                          std::string& scratch);
+  static void emit_html_unit(const StyleCatalogSnapshot* style_state,
+                             std::string_view src, size_t& pos, HtmlEmitState& emit,
+                             std::string& out, StyleCollector* styles);
+  static std::string escape_html_attr(const std::string& value);
+  static bool has_split_inline_token(std::string_view raw) noexcept;
+  void render_template_body(const StyleCatalogSnapshot* style_state,
+                            std::string_view raw,
+                            ArgList args,
+                            HtmlEmitState& emit,
+                            std::string& out,
+                            StyleCollector& styles,
+                            ArgCache& arg_cache);
+  std::vector<std::string> gather_style_tokens(std::string_view text) const;
+  std::string serialize_physics(const StyleCatalogSnapshot* style_state,
+                                const std::vector<std::string>& style_tokens,
+                                PhysicsFormat format);
+  NativeStyle native_style_for(const StyleCatalogSnapshot* style_state,
+                               const std::string& token,
+                               ArgList args);
+  std::string physics_from_template(const std::string& template_token,
+                                    ArgList args,
+                                    PhysicsFormat format);
 
   std::shared_ptr<CatalogSnapshot> build_snapshot_from_text(std::string&& src, bool strict, std::string& err);
   std::shared_ptr<CatalogSnapshot> build_snapshot_from_binary(const uint8_t* data, size_t size, bool strict,
                                                               std::string& err);
-  void install_snapshot(std::shared_ptr<CatalogSnapshot> snapshot);
+  // Jeder Installationsweg holt sich zu Beginn eine Nummer aus begin_load(). install_snapshot installiert
+  // nur, wenn seitdem kein neuerer Auftrag begonnen hat; sonst false und der neuere gewinnt.
+  // source: Datei, aus der der Snapshot stammt (für reload()).
+  uint64_t begin_load() noexcept { return load_sequence.fetch_add(1, std::memory_order_acq_rel) + 1; }
+  bool install_snapshot(std::shared_ptr<const CatalogSnapshot> snapshot, uint64_t sequence,
+                        const LoadSource* source = nullptr);
+  // snapshot, neu gebunden an das aktuelle Property-Schema (Kopie), oder unverändert, wenn es schon passt
+  // oder keine Styles trägt. install_snapshot wendet das auf alles an, was es installiert: Ladeaufträge,
+  // Locale-Sichten und Overlay-Basen, die noch mit einem älteren Schema gebaut wurden.
+  std::shared_ptr<const CatalogSnapshot> with_current_schema(std::shared_ptr<const CatalogSnapshot> snapshot);
+  LoadSource loaded_source();
+  std::shared_ptr<CatalogSnapshot> build_snapshot_from_file(const std::string& path, bool strict, std::string& err);
+  bool load_file(const char* path, bool strict);
+  std::shared_ptr<LoadTicket> enqueue_load(const std::string& path, bool strict, bool reload,
+                                           ReloadCallback callback, void* user);
+  void run_load_worker();
+  void process_load(LoadTicket& ticket);
+  static void finish_load(LoadTicket& ticket, LoadState state, std::string error);
+  std::shared_ptr<CatalogSnapshot> build_snapshot_from_source(std::string src, bool strict, std::string& err);
+  void run_watcher(CatalogWatcher& w);
+  void stop_watchers(std::vector<std::unique_ptr<CatalogWatcher>> stopping);
+  void reload_watched(CatalogWatcher& w);
   std::shared_ptr<const CatalogSnapshot> acquire_snapshot() const noexcept;
   static bool is_binary_catalog_path(const std::string& path) noexcept;
 public:
@@ -143,25 +1131,111 @@ public:
     ARABIC  = 2
   };
 
+  ~I18nEngine();
   const char* get_last_error() const noexcept;
-  const std::string& get_meta_locale() const noexcept;
-  const std::string& get_meta_fallback() const noexcept;
-  const std::string& get_meta_note() const noexcept;
+  std::string get_meta_locale() const;
+  std::string get_meta_fallback() const;
+  std::string get_meta_note() const;
   PublicPluralRule get_meta_plural_rule() const noexcept;
   bool load_txt_catalog(std::string src, bool strict);
   bool load_txt_file(const char* path, bool strict);
   bool reload();
-  std::string translate(const std::string& token_in, const std::vector<std::string>& args);
-  std::string translate_plural(const std::string& token_in, int count, const std::vector<std::string>& args);
-  std::string render_to_html(const std::string& template_token, const std::vector<std::string>& args);
-  std::string get_physics_json_for_template(const std::string& template_token, const std::vector<std::string>& args);
+  // Mehrere Locales in einer Engine. Jede Locale wird einzeln geladen (name leer: aus @meta locale);
+  // ihre Kette über @meta fallback wird beim Laden zu einem Snapshot zusammengeführt, sodass ein
+  // Fehltreffer eine einzige Abfrage kostet. set_locale tauscht nur den aktiven Snapshot atomar.
+  // Namen werden exakt oder über die Sprache aufgelöst ("en_US" findet "en" und umgekehrt).
+  bool add_locale_file(const std::string& name, const std::string& path, bool strict);
+  bool add_locale_txt(const std::string& name, std::string src, bool strict);
+  bool set_locale(const std::string& name);
+  std::vector<std::string> locale_chain() const; // Kette der aktiven Locale, leer ohne set_locale
+  // Overlays für Mandanten: share_catalog übernimmt den aktiven Snapshot einer anderen Engine ohne Kopie,
+  // push_overlay_* legt eine Override-Ebene darüber. Nachschlagen prüft die Ebenen von oben nach unten;
+  // Style-Registry und Templates werden nur für überschriebene Tokens und ihre Abhängigen neu berechnet.
+  bool share_catalog(const I18nEngine& source);
+  bool push_overlay_txt(std::string src, bool strict);
+  bool push_overlay_file(const std::string& path, bool strict);
+  bool pop_overlay();
+  size_t overlay_depth() const;
+  MemoryStats memory_stats() const;
+  // Laufzeitstatistik seit Start bzw. letztem reset_stats: Aufrufe und Latenz-Histogramme je API,
+  // Ergebniszähler (Template-Cache, Marker, RESULT_TOO_LARGE) und Ladezeit je Phase.
+  std::string stats_json() const;
+  std::string stats_prometheus() const;
+  void reset_stats() noexcept;
+  // Meldet Aufrufe, die mindestens threshold_ns dauern, als Span-Baum an callback (im aufrufenden Thread).
+  // sample_rate (0..1) ist der Anteil der Aufrufe, die überhaupt gemessen werden. Leerer callback: aus.
+  void set_trace_hook(TraceCallback callback, uint64_t threshold_ns, double sample_rate);
+  // Lädt im Engine-eigenen Worker-Thread; der aktive Snapshot bedient Anfragen bis zum atomaren Tausch.
+  // Ein neuer Auftrag bricht ältere, noch nicht installierte ab. callback (optional) läuft im Worker.
+  std::shared_ptr<LoadTicket> load_async(const std::string& path, bool strict, ReloadCallback callback, void* user);
+  std::shared_ptr<LoadTicket> reload_async(ReloadCallback callback, void* user);
+  // Überwacht path (leer: die zuletzt per load_txt_file geladene Datei) samt Verzeichnis, sodass auch
+  // Speichern per Rename erkannt wird. Änderungsschübe werden über debounce_ms zusammengefasst; nur
+  // geänderter Inhalt wird im Watcher-Thread neu geladen und atomar installiert. callback (optional)
+  // läuft danach im Watcher-Thread.
+  bool watch_start(const std::string& path, bool strict, int debounce_ms, ReloadCallback callback, void* user);
+  void watch_stop();
+  bool is_watching();
+  std::string translate(const std::string& token_in, ArgList args);
+  std::string translate_plural(std::string_view token_in, int count, ArgList args);
+  std::string render_to_html(const std::string& template_token, ArgList args);
+  std::string render_to_html(const std::string& template_token,
+                             ArgList args,
+                             const RenderOptions& options);
+  // Streaming-Varianten ohne Größenlimit; false bei Abbruch durch Sink oder Schreibfehler.
+  bool translate_to(std::string_view token_in, ArgList args, ChunkWriter& out);
+  bool render_to(std::string_view template_token,
+                 ArgList args,
+                 const RenderOptions& options,
+                 ChunkWriter& out);
+  // Rendert alle Jobs parallel gegen einen gepinnten Snapshot; Ergebnisse in Job-Reihenfolge.
+  // threads == 0: hardware_concurrency().
+  std::vector<std::string> render_batch(const std::vector<RenderJob>& jobs,
+                                        const RenderOptions& options,
+                                        unsigned threads = 0);
+  // Inkrementeller Site-Build: rendert nur Seiten, deren Abhängigkeiten (Template, @-Referenzen,
+  // per Arg aufgelöste Tokens) sich seit dem letzten Build geändert haben. force: alles neu.
+  bool build_site(const std::string& out_dir,
+                  const std::vector<SitePage>& pages,
+                  const RenderOptions& options,
+                  bool force,
+                  SiteBuildReport& report);
+  SiteBuildReport get_last_site_report();
+  void reset_site();
+  // Referenz-Abfragen über den Snapshot-Index. dependents: wer verweist auf token (transitive: Hülle).
+  bool get_references(const std::string& token, std::vector<std::string>& out) const;
+  bool get_dependents(const std::string& token, bool transitive, std::vector<std::string>& out) const;
+  bool dump_table_to(ChunkWriter& out) const;
+  // Leerer prefix: alle Einträge.
+  EntryCursor iterate_entries(const std::string& prefix) const;
+  bool find_any_to(const std::string& query, ChunkWriter& out) const;
+  // Seitenweise Suche (offset/limit über die Treffer in Token-Reihenfolge, limit 0 = alle).
+  // Rückgabe: Gesamtzahl der Treffer.
+  size_t find_page(const std::string& query, size_t offset, size_t limit, std::vector<SearchHit>& out) const;
+  bool build_stylesheet(const std::vector<std::string>& template_tokens,
+                        std::string& out_css,
+                        std::string& out_file_name);
+  bool export_stylesheet(const char* out_dir,
+                         const std::vector<std::string>& template_tokens,
+                         std::string& out_file_name);
+  std::string get_physics_json_for_template(const std::string& template_token, ArgList args);
+  std::string get_physics_for_template(const std::string& template_token,
+                                       ArgList args,
+                                       PhysicsFormat format);
   std::string dump_table() const;
   std::string find_any(const std::string& query) const;
+  CheckResult check_catalog() const;
   std::string check_catalog_report(int& out_code) const;
+  static bool write_check_report(const CheckResult& result, ReportFormat format, ChunkWriter& out);
   bool export_binary_catalog(const char* path) const;
-  NativeStyle get_native_style(const std::string& style_token, const std::vector<std::string>& args);
+  NativeStyle get_native_style(std::string_view style_token, ArgList args);
   NativeStyle evaluate_native_style(const std::vector<StyleProperty>& props,
                                     const StyleCatalogSnapshot* style_state,
-                                    const std::vector<std::string>& args);
-  void apply_physical_property(NativeStyle& style, const std::string& key, const std::string& raw_value) const;
+                                    ArgList args);
+  static void apply_physical_property(NativeStyle& style, PropertyId id, float value) noexcept;
+  static bool read_physical_property(const NativeStyle& style, PropertyId id, float& out_value) noexcept;
+  int register_property(const std::string& name);
+  int find_property(const std::string& name) const;
+  size_t property_count() const;
+  std::string property_name(PropertyId id) const;
 };
@@ -9,7 +9,6 @@
 #include <vector>
 #include <chrono>
 #include <thread>
-#include <sys/stat.h>
 
 #include "i18n_api.h"
 #include "i18n_engine.h"
@@ -83,35 +82,29 @@ static bool load_catalog_force_text(void* engine, const char* path) {
   return i18n_load_txt(engine, contents.c_str(), 1) == 0;
 }
 
-static long long get_last_write_time(const char* filename) {
-  struct stat result;
-  if (stat(filename, &result) == 0) return static_cast<long long>(result.st_mtime);
-  return 0;
+static void on_catalog_reloaded(void* engine, int status, const char* error) {
+  if (status != 0) {
+    std::cerr << ">>> Live-Reload fehlgeschlagen: " << (error ? error : "Unknown error") << std::endl;
+    return;
+  }
+  std::cout << "\n[!] Änderung erkannt, Katalog im Hintergrund neu geladen." << std::endl;
+  I18nNativeStyle ice{};
+  if (i18n_get_native_style(engine, "style_cube-ice", nullptr, 0, &ice) == 0) {
+    std::cout << ">>> NEUE WERTE (Ice): Mass: " << ice.mass << " | Friction: " << ice.friction << std::endl;
+  }
 }
 
 static void live_reload_loop(void* engine, const char* filename) {
-  long long last_time = get_last_write_time(filename);
+  // Der Watcher der Engine erkennt auch schnelle Folge-Saves und Rename-Saves; dieser Thread bleibt frei.
+  if (i18n_watch_start(engine, filename, 1, 100, on_catalog_reloaded, engine) != 0) {
+    const char* err = i18n_last_error(engine);
+    std::cerr << ">>> Live-Reload nicht verfügbar: " << (err ? err : "Unknown error") << std::endl;
+    return;
+  }
   std::cout << ">>> Live-Reload aktiv. Warte auf Änderungen an " << filename << "..." << std::endl;
 
   while (true) {
-    long long current_time = get_last_write_time(filename);
-    if (current_time > last_time) {
-      last_time = current_time;
-      std::cout << "\n[!] Änderung erkannt! Lade Katalog neu..." << std::endl;
-
-      if (!load_catalog_force_text(engine, filename)) {
-        const char* err = i18n_last_error(engine);
-        std::cerr << ">>> Live-Reload fehlgeschlagen: " << (err ? err : "Unknown error") << std::endl;
-      } else {
-        std::cout << ">>> Katalog neu geladen." << std::endl;
-      }
-
-      I18nNativeStyle ice{};
-      if (i18n_get_native_style(engine, "style_cube-ice", nullptr, 0, &ice) == 0) {
-        std::cout << ">>> NEUE WERTE (Ice): Mass: " << ice.mass << " | Friction: " << ice.friction << std::endl;
-      }
-    }
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    std::this_thread::sleep_for(std::chrono::seconds(1));
   }
 }
 
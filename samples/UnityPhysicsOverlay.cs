@@ -1,5 +1,3 @@
-using System;
-using System.Collections.Generic;
 using System.IO;
 using System.Threading;
 using UnityEngine;
@@ -28,14 +26,16 @@ namespace Mycelia.Unity
         private int kernelIndex = 0;
 
         private I18n engine;
-        private FileSystemWatcher watcher;
         private int refreshPending;
 
         private void Awake()
         {
             engine = new I18n();
             LoadCatalog();
-            SetupWatcher();
+            // The engine watches the file (including atomic-rename saves), skips no-op saves and swaps the
+            // new catalog in on its own thread; the frame thread only re-reads the values.
+            engine.Reloaded += OnCatalogReloaded;
+            engine.StartWatching();
         }
 
         private void Update()
@@ -48,7 +48,6 @@ namespace Mycelia.Unity
 
         private void OnDestroy()
         {
-            watcher?.Dispose();
             engine?.Dispose();
         }
 
@@ -59,30 +58,16 @@ namespace Mycelia.Unity
             RefreshShaderValues();
         }
 
-        private void SetupWatcher()
+        private void OnCatalogReloaded(bool success, string error)
         {
-            string normalized = Path.GetFullPath(Path.Combine(Application.dataPath, "..", catalogPath));
-            string directory = Path.GetDirectoryName(normalized);
-            string filename = Path.GetFileName(normalized);
-
-            if (string.IsNullOrEmpty(directory) || string.IsNullOrEmpty(filename))
+            if (success)
             {
-                return;
+                Interlocked.Exchange(ref refreshPending, 1);
             }
-
-            watcher = new FileSystemWatcher(directory, filename)
+            else
             {
-                NotifyFilter = NotifyFilters.LastWrite | NotifyFilters.Size
-            };
-            watcher.Changed += OnCatalogChanged;
-            watcher.EnableRaisingEvents = true;
-        }
-
-        private void OnCatalogChanged(object sender, FileSystemEventArgs e)
-        {
-            // Avoid multiple events flooding the UI thread.
-            Interlocked.Exchange(ref refreshPending, 1);
-            ApplyThreadSafely(() => LoadCatalog());
+                Debug.LogWarning($"Catalog reload failed: {error}");
+            }
         }
 
         private void RefreshShaderValues()
@@ -97,59 +82,6 @@ namespace Mycelia.Unity
                 physicsShader.SetFloat("_GlobalRestitution", native.Restitution);
             }
         }
-
-        private void ApplyThreadSafely(Action callback)
-        {
-            if (callback == null) return;
-            UnityMainThreadDispatcher.Enqueue(callback);
-        }
     }
 }
 
-/// <summary>
-/// Simple dispatcher for Unity Main Thread callbacks (required for FileSystemWatcher).
-/// </summary>
-public static class UnityMainThreadDispatcher
-{
-    private static readonly Queue<Action> queue = new Queue<Action>();
-
-    public static void Enqueue(Action action)
-    {
-        if (action == null) return;
-        lock (queue)
-        {
-            queue.Enqueue(action);
-        }
-    }
-
-    [RuntimeInitializeOnLoadMethod(RuntimeInitializeLoadType.BeforeSceneLoad)]
-    public static void Initialize()
-    {
-        if (Application.isPlaying)
-        {
-            var go = new GameObject("UnityMainThreadDispatcher");
-            go.hideFlags = HideFlags.HideAndDontSave;
-            go.AddComponent<DispatcherBehaviour>();
-        }
-    }
-
-    private class DispatcherBehaviour : MonoBehaviour
-    {
-        private void Update()
-        {
-            while (true)
-            {
-                Action action = null;
-                lock (queue)
-                {
-                    if (queue.Count > 0)
-                    {
-                        action = queue.Dequeue();
-                    }
-                }
-                if (action == null) break;
-                action();
-            }
-        }
-    }
-}
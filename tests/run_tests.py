@@ -1,6 +1,10 @@
 import ctypes
+import json
 import os
+import struct
 import sys
+import tempfile
+import threading
 
 BASE_DIR = os.path.dirname(__file__)
 lib_name = "i18n_engine.dll" if os.name == "nt" else "libi18n_engine.so"
@@ -31,6 +35,152 @@ lib.i18n_get_meta_note_copy.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes
 lib.i18n_get_meta_note_copy.restype = ctypes.c_int
 lib.i18n_get_meta_plural_rule.argtypes = [ctypes.c_void_p]
 lib.i18n_get_meta_plural_rule.restype = ctypes.c_int
+lib.i18n_register_property.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+lib.i18n_register_property.restype = ctypes.c_int
+lib.i18n_get_native_property.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_char_p), ctypes.c_int, ctypes.c_int, ctypes.POINTER(ctypes.c_float)]
+lib.i18n_get_native_property.restype = ctypes.c_int
+lib.i18n_get_native_properties.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_char_p), ctypes.c_int, ctypes.POINTER(ctypes.c_float), ctypes.c_int, ctypes.POINTER(ctypes.c_uint32)]
+lib.i18n_get_native_properties.restype = ctypes.c_int
+lib.i18n_render_to_html_ex.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_char_p), ctypes.c_int, ctypes.c_int, ctypes.c_void_p, ctypes.c_int]
+lib.i18n_render_to_html_ex.restype = ctypes.c_int
+lib.i18n_get_physics_json.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_char_p), ctypes.c_int, ctypes.c_void_p, ctypes.c_int]
+lib.i18n_get_physics_json.restype = ctypes.c_int
+lib.i18n_render_to_html_linked.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_char_p), ctypes.c_int, ctypes.c_int, ctypes.c_char_p, ctypes.c_void_p, ctypes.c_int]
+lib.i18n_render_to_html_linked.restype = ctypes.c_int
+lib.i18n_build_stylesheet.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_char_p), ctypes.c_int, ctypes.c_void_p, ctypes.c_int]
+lib.i18n_build_stylesheet.restype = ctypes.c_int
+lib.i18n_export_stylesheet.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_char_p), ctypes.c_int, ctypes.c_void_p, ctypes.c_int]
+lib.i18n_export_stylesheet.restype = ctypes.c_int
+SINK_FN = ctypes.CFUNCTYPE(ctypes.c_int, ctypes.c_void_p, ctypes.POINTER(ctypes.c_char), ctypes.c_int)
+lib.i18n_render_to_sink.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_char_p), ctypes.c_int, ctypes.c_int, SINK_FN, ctypes.c_void_p]
+lib.i18n_render_to_sink.restype = ctypes.c_int
+lib.i18n_translate_to_sink.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_char_p), ctypes.c_int, SINK_FN, ctypes.c_void_p]
+lib.i18n_translate_to_sink.restype = ctypes.c_int
+lib.i18n_find_to_sink.argtypes = [ctypes.c_void_p, ctypes.c_char_p, SINK_FN, ctypes.c_void_p]
+lib.i18n_find_to_sink.restype = ctypes.c_int
+lib.i18n_find_to_fd.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int]
+lib.i18n_find_to_fd.restype = ctypes.c_int
+lib.i18n_get_physics.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_char_p), ctypes.c_int, ctypes.c_int, ctypes.c_void_p, ctypes.c_int]
+lib.i18n_get_physics.restype = ctypes.c_int
+
+class RenderJob(ctypes.Structure):
+    _fields_ = [("token", ctypes.c_char_p), ("args", ctypes.POINTER(ctypes.c_char_p)), ("args_len", ctypes.c_int)]
+
+
+lib.i18n_render_batch.argtypes = [ctypes.c_void_p, ctypes.POINTER(RenderJob), ctypes.c_int, ctypes.c_int, ctypes.c_char_p, ctypes.c_int]
+lib.i18n_render_batch.restype = ctypes.c_void_p
+lib.i18n_batch_count.argtypes = [ctypes.c_void_p]
+lib.i18n_batch_result.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.POINTER(ctypes.c_int)]
+lib.i18n_batch_result.restype = ctypes.POINTER(ctypes.c_char)
+lib.i18n_batch_free.argtypes = [ctypes.c_void_p]
+
+class SitePage(ctypes.Structure):
+    _fields_ = [("output_path", ctypes.c_char_p), ("token", ctypes.c_char_p),
+                ("args", ctypes.POINTER(ctypes.c_char_p)), ("args_len", ctypes.c_int)]
+
+
+lib.i18n_site_build.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.POINTER(SitePage), ctypes.c_int, ctypes.c_int, ctypes.c_char_p, ctypes.c_int]
+lib.i18n_site_build.restype = ctypes.c_int
+lib.i18n_site_written_copy.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int]
+lib.i18n_load_txt.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int]
+lib.i18n_add_locale_txt.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int]
+lib.i18n_set_locale.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+lib.i18n_get_locale_chain.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int]
+lib.i18n_share_catalog.argtypes = [ctypes.c_void_p, ctypes.c_void_p]
+lib.i18n_push_overlay_txt.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int]
+lib.i18n_pop_overlay.argtypes = [ctypes.c_void_p]
+lib.i18n_overlay_depth.argtypes = [ctypes.c_void_p]
+
+
+class MemoryStats(ctypes.Structure):
+    _fields_ = [(name, ctypes.c_uint64) for name in (
+        "entries", "arena", "table", "ref_index", "entry_refs", "search",
+        "style_registry", "style_info", "templates", "shared_base", "total")]
+
+
+lib.i18n_memory_stats.argtypes = [ctypes.c_void_p, ctypes.POINTER(MemoryStats)]
+lib.i18n_stats_json.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int]
+lib.i18n_stats_prometheus.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int]
+lib.i18n_stats_reset.argtypes = [ctypes.c_void_p]
+
+
+class TraceSpan(ctypes.Structure):
+    _fields_ = [("name", ctypes.c_char_p), ("token", ctypes.c_char_p), ("start_ns", ctypes.c_uint64),
+                ("duration_ns", ctypes.c_uint64), ("output_bytes", ctypes.c_uint64), ("generation", ctypes.c_uint64),
+                ("arg_count", ctypes.c_int32), ("depth", ctypes.c_int32), ("index", ctypes.c_int32),
+                ("parent", ctypes.c_int32)]
+
+
+TRACE_FN = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.POINTER(TraceSpan))
+
+
+class SpanArg(ctypes.Structure):
+    _fields_ = [("data", ctypes.c_char_p), ("len", ctypes.c_int)]
+
+
+class NativeStyle(ctypes.Structure):
+    _fields_ = [("mass", ctypes.c_float), ("friction", ctypes.c_float), ("restitution", ctypes.c_float),
+                ("drag", ctypes.c_float), ("gravity_scale", ctypes.c_float), ("spacing", ctypes.c_float),
+                ("has_values", ctypes.c_int)]
+
+
+lib.i18n_translate_n.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int, ctypes.POINTER(SpanArg), ctypes.c_int,
+                                 ctypes.c_void_p, ctypes.c_int]
+lib.i18n_translate_plural_n.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int, ctypes.c_int,
+                                        ctypes.POINTER(SpanArg), ctypes.c_int, ctypes.c_void_p, ctypes.c_int]
+lib.i18n_render_to_html_n.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int, ctypes.POINTER(SpanArg),
+                                      ctypes.c_int, ctypes.c_int, ctypes.c_void_p, ctypes.c_int]
+lib.i18n_get_native_style_n.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int, ctypes.POINTER(SpanArg),
+                                        ctypes.c_int, ctypes.POINTER(NativeStyle)]
+lib.i18n_set_trace.argtypes = [ctypes.c_void_p, TRACE_FN, ctypes.c_void_p, ctypes.c_uint64, ctypes.c_double]
+lib.i18n_get_references.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int]
+lib.i18n_get_dependents.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int, ctypes.c_char_p, ctypes.c_int]
+
+class CheckIssue(ctypes.Structure):
+    _fields_ = [("kind", ctypes.c_int), ("is_error", ctypes.c_int),
+                ("token", ctypes.POINTER(ctypes.c_char)), ("token_len", ctypes.c_int),
+                ("detail", ctypes.POINTER(ctypes.c_char)), ("detail_len", ctypes.c_int)]
+
+
+class SearchHit(ctypes.Structure):
+    _fields_ = [("token", ctypes.POINTER(ctypes.c_char)), ("token_len", ctypes.c_int),
+                ("label", ctypes.POINTER(ctypes.c_char)), ("label_len", ctypes.c_int),
+                ("text", ctypes.POINTER(ctypes.c_char)), ("text_len", ctypes.c_int)]
+
+
+lib.i18n_find_page.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int, ctypes.c_int]
+lib.i18n_find_page.restype = ctypes.c_void_p
+lib.i18n_find_page_total.argtypes = [ctypes.c_void_p]
+lib.i18n_find_page_count.argtypes = [ctypes.c_void_p]
+lib.i18n_find_page_hit.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.POINTER(SearchHit)]
+lib.i18n_find_page_free.argtypes = [ctypes.c_void_p]
+class EntryView(ctypes.Structure):
+    _fields_ = SearchHit._fields_
+
+
+lib.i18n_iter_begin.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+lib.i18n_iter_begin.restype = ctypes.c_void_p
+lib.i18n_iter_next.argtypes = [ctypes.c_void_p, ctypes.POINTER(EntryView)]
+lib.i18n_iter_end.argtypes = [ctypes.c_void_p]
+lib.i18n_check_to_sink.argtypes = [ctypes.c_void_p, ctypes.c_int, SINK_FN, ctypes.c_void_p]
+lib.i18n_check_run.argtypes = [ctypes.c_void_p]
+lib.i18n_check_run.restype = ctypes.c_void_p
+lib.i18n_check_code.argtypes = [ctypes.c_void_p]
+lib.i18n_check_issue_count.argtypes = [ctypes.c_void_p]
+lib.i18n_check_issue.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.POINTER(CheckIssue)]
+lib.i18n_check_free.argtypes = [ctypes.c_void_p]
+RELOAD_FN = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_int, ctypes.c_char_p)
+lib.i18n_watch_start.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int, ctypes.c_int, RELOAD_FN, ctypes.c_void_p]
+lib.i18n_watch_stop.argtypes = [ctypes.c_void_p]
+lib.i18n_load_async.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int, RELOAD_FN, ctypes.c_void_p]
+lib.i18n_load_async.restype = ctypes.c_void_p
+lib.i18n_reload_async.argtypes = [ctypes.c_void_p, RELOAD_FN, ctypes.c_void_p]
+lib.i18n_reload_async.restype = ctypes.c_void_p
+lib.i18n_load_status.argtypes = [ctypes.c_void_p]
+lib.i18n_load_wait.argtypes = [ctypes.c_void_p, ctypes.c_int]
+lib.i18n_load_error_copy.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_int]
+lib.i18n_load_cancel.argtypes = [ctypes.c_void_p]
+lib.i18n_load_free.argtypes = [ctypes.c_void_p]
 lib.i18n_abi_version.restype = ctypes.c_uint32
 lib.i18n_binary_version_supported_max.restype = ctypes.c_uint32
 
@@ -76,6 +226,515 @@ def translate_plural(engine, token, count, args=None):
     return buf.value.decode("utf-8")
 
 
+def render(engine, token, args=None, flags=0):
+    args = args or []
+    arr, buffers = prepare_args(args)
+    needed = lib.i18n_render_to_html_ex(engine, token.encode("utf-8"), arr, len(args), flags, None, 0)
+    if needed < 0:
+        raise RuntimeError(last_error(engine))
+    buf = ctypes.create_string_buffer(needed + 1)
+    lib.i18n_render_to_html_ex(engine, token.encode("utf-8"), arr, len(args), flags, buf, len(buf))
+    return buf.value.decode("utf-8")
+
+
+def physics_json(engine, token, args=None):
+    args = args or []
+    arr, buffers = prepare_args(args)
+    needed = lib.i18n_get_physics_json(engine, token.encode("utf-8"), arr, len(args), None, 0)
+    buf = ctypes.create_string_buffer(needed + 1)
+    lib.i18n_get_physics_json(engine, token.encode("utf-8"), arr, len(args), buf, len(buf))
+    return buf.value.decode("utf-8")
+
+
+def physics_packed(engine, token, args=None):
+    args = args or []
+    arr, buffers = prepare_args(args)
+    needed = lib.i18n_get_physics(engine, token.encode("utf-8"), arr, len(args), 1, None, 0)
+    buf = ctypes.create_string_buffer(needed + 1)
+    lib.i18n_get_physics(engine, token.encode("utf-8"), arr, len(args), 1, buf, len(buf))
+    return buf.raw[:needed]
+
+
+def stylesheet(engine, templates=None):
+    templates = templates or []
+    arr, buffers = prepare_args(templates)
+    css_len = lib.i18n_build_stylesheet(engine, arr, len(templates), None, 0)
+    css = ctypes.create_string_buffer(css_len + 1)
+    lib.i18n_build_stylesheet(engine, arr, len(templates), css, len(css))
+    name = ctypes.create_string_buffer(64)
+    lib.i18n_export_stylesheet(engine, None, arr, len(templates), name, len(name))
+    return css.value.decode("utf-8"), name.value.decode("utf-8")
+
+
+def render_linked(engine, token, href, args=None):
+    args = args or []
+    arr, buffers = prepare_args(args)
+    needed = lib.i18n_render_to_html_linked(engine, token.encode("utf-8"), arr, len(args), 0, href.encode("utf-8"), None, 0)
+    buf = ctypes.create_string_buffer(needed + 1)
+    lib.i18n_render_to_html_linked(engine, token.encode("utf-8"), arr, len(args), 0, href.encode("utf-8"), buf, len(buf))
+    return buf.value.decode("utf-8")
+
+
+def render_streamed(engine, token, args=None, flags=0, abort=False):
+    args = args or []
+    arr, buffers = prepare_args(args)
+    chunks = []
+
+    def sink(user, data, length):
+        chunks.append(ctypes.string_at(data, length))
+        return 1 if abort else 0
+
+    rc = lib.i18n_render_to_sink(engine, token.encode("utf-8"), arr, len(args), flags, SINK_FN(sink), None)
+    return rc, b"".join(chunks).decode("utf-8")
+
+
+def find_to_fd(engine, query):
+    with tempfile.TemporaryFile() as fh:
+        rc = lib.i18n_find_to_fd(engine, query.encode("utf-8"), fh.fileno())
+        fh.seek(0)
+        return rc, fh.read().decode("utf-8")
+
+
+def find_page(engine, query, offset, limit):
+    page = lib.i18n_find_page(engine, query.encode("utf-8"), offset, limit)
+    hits = []
+    for i in range(lib.i18n_find_page_count(page)):
+        hit = SearchHit()
+        assert lib.i18n_find_page_hit(page, i, ctypes.byref(hit)) == 0
+        hits.append(ctypes.string_at(hit.token, hit.token_len).decode("utf-8"))
+    total = lib.i18n_find_page_total(page)
+    lib.i18n_find_page_free(page)
+    return total, hits
+
+
+def iterate(cursor):
+    entries = []
+    view = EntryView()
+    while lib.i18n_iter_next(cursor, ctypes.byref(view)) == 1:
+        entries.append(tuple(ctypes.string_at(ptr, n).decode("utf-8") for ptr, n in
+                             ((view.token, view.token_len), (view.label, view.label_len), (view.text, view.text_len))))
+    return entries
+
+
+def render_batch(engine, jobs, threads=0):
+    native = (RenderJob * len(jobs))()
+    keep = []
+    for i, (token, args) in enumerate(jobs):
+        arr, buffers = prepare_args(args)
+        keep.append((arr, buffers))
+        native[i].token = token.encode("utf-8")
+        native[i].args = arr
+        native[i].args_len = len(args)
+    batch = lib.i18n_render_batch(engine, native, len(jobs), 0, None, threads)
+    assert lib.i18n_batch_count(batch) == len(jobs)
+    results = []
+    for i in range(len(jobs)):
+        length = ctypes.c_int()
+        data = lib.i18n_batch_result(batch, i, ctypes.byref(length))
+        results.append(ctypes.string_at(data, length.value).decode("utf-8"))
+    lib.i18n_batch_free(batch)
+    return results
+
+
+def site_build(engine, out_dir, pages, flags=0):
+    native = (SitePage * len(pages))()
+    keep = []
+    for i, (path, token, args) in enumerate(pages):
+        arr, buffers = prepare_args(args)
+        keep.append((arr, buffers))
+        native[i].output_path = path.encode("utf-8")
+        native[i].token = token.encode("utf-8")
+        native[i].args = arr
+        native[i].args_len = len(args)
+    rendered = lib.i18n_site_build(engine, out_dir.encode("utf-8"), native, len(pages), flags, None, 0)
+    buf = ctypes.create_string_buffer(4096)
+    lib.i18n_site_written_copy(engine, buf, len(buf))
+    return rendered, sorted(buf.value.decode("utf-8").split())
+
+
+def token_list(fn, engine, *args):
+    needed = fn(engine, *args, None, 0)
+    if needed < 0:
+        return None
+    buf = ctypes.create_string_buffer(needed + 1)
+    fn(engine, *args, buf, len(buf))
+    return buf.value.decode("utf-8").split()
+
+
+def check_watcher(engine):
+    events = []
+    signal = threading.Event()
+
+    def on_reload(user, status, error):
+        events.append((status, error.decode("utf-8") if error else None))
+        signal.set()
+
+    callback = RELOAD_FN(on_reload)
+
+    def save(path, text, atomic):
+        target = path + ".tmp" if atomic else path
+        with open(target, "w", encoding="utf-8") as fh:
+            fh.write(text)
+        if atomic:
+            os.replace(target, path)
+
+    def expect_reload(timeout=5.0):
+        assert signal.wait(timeout), "kein Reload"
+        signal.clear()
+        return events[-1]
+
+    with tempfile.TemporaryDirectory() as watch_dir:
+        path = os.path.join(watch_dir, "live.txt")
+        save(path, "a1b2c3: Eins\n", False)
+        assert lib.i18n_load_txt_file(engine, path.encode("utf-8"), 1) == 0
+        assert lib.i18n_watch_start(engine, None, 1, 20, callback, None) == 0
+        assert lib.i18n_watch_start(engine, None, 1, 20, callback, None) == -1
+        save(path, "a1b2c3: Zwei\n", False)
+        assert expect_reload() == (0, None) and translate(engine, "a1b2c3") == "Zwei"
+        save(path, "a1b2c3: Drei\n", True)  # Rename-Save ersetzt die überwachte Datei
+        assert expect_reload() == (0, None) and translate(engine, "a1b2c3") == "Drei"
+        save(path, "a1b2c3: Drei\n", False)  # gleicher Inhalt: kein Reload
+        assert not signal.wait(0.3)
+        # ... und auch kein Abbruch eines laufenden asynchronen Ladevorgangs.
+        big = os.path.join(watch_dir, "big.txt")
+        with open(big, "w", encoding="utf-8") as fh:
+            fh.write("a1b2c3: Groß\n" + "".join(f"{i:06x}: v\n" for i in range(0x100000, 0x140000)))
+        pending = lib.i18n_load_async(engine, big.encode("utf-8"), 1, RELOAD_FN(), None)
+        save(path, "a1b2c3: Drei\n", False)
+        assert lib.i18n_load_wait(pending, 10000) == 1 and translate(engine, "a1b2c3") == "Groß"  # 1 = fertig
+        lib.i18n_load_free(pending)
+        assert not signal.wait(0.3)
+        assert lib.i18n_load_txt_file(engine, path.encode("utf-8"), 1) == 0
+        save(path, "a1b2c3: Vier\na1b2c3: doppelt\n", True)
+        status, error = expect_reload()
+        assert status == -1 and error and translate(engine, "a1b2c3") == "Drei"
+        assert lib.i18n_watch_stop(engine) == 0
+        save(path, "a1b2c3: Fünf\n", False)
+        assert not signal.wait(0.2) and translate(engine, "a1b2c3") == "Drei"
+        # Stoppen aus dem eigenen Callback: der Watcher-Thread darf sich nicht selbst joinen.
+        stopped = []
+        self_stop = RELOAD_FN(lambda user, status, error: (stopped.append(lib.i18n_watch_stop(engine)), signal.set()))
+        assert lib.i18n_watch_start(engine, None, 1, 20, self_stop, None) == 0
+        save(path, "a1b2c3: Sechs\n", False)
+        assert signal.wait(5.0) and stopped == [0]
+        signal.clear()
+        assert lib.i18n_watch_start(engine, None, 1, 20, callback, None) == 0  # räumt den alten Thread ab
+        assert lib.i18n_watch_stop(engine) == 0
+
+
+def check_async_load(engine):
+    LOAD_DONE, LOAD_FAILED, LOAD_CANCELLED = 1, 2, 3
+    events = []
+    callback = RELOAD_FN(lambda user, status, error: events.append(status))
+
+    def load_error(handle):
+        buf = ctypes.create_string_buffer(512)
+        lib.i18n_load_error_copy(handle, buf, len(buf))
+        return buf.value.decode("utf-8")
+
+    with tempfile.TemporaryDirectory() as load_dir:
+        paths = []
+        for i, text in enumerate(["a1b2c3: Eins\n", "a1b2c3: Zwei\n", "a1b2c3: Eins\na1b2c3: doppelt\n"]):
+            paths.append(os.path.join(load_dir, f"cat{i}.txt"))
+            with open(paths[-1], "w", encoding="utf-8") as fh:
+                fh.write(text)
+
+        handle = lib.i18n_load_async(engine, paths[0].encode("utf-8"), 1, callback, None)
+        assert lib.i18n_load_wait(handle, -1) == LOAD_DONE and events == [0]
+        assert translate(engine, "a1b2c3") == "Eins"
+        lib.i18n_load_free(handle)
+
+        # Zwei Aufträge direkt nacheinander: der ältere darf den neueren nie überschreiben.
+        first = lib.i18n_load_async(engine, paths[0].encode("utf-8"), 1, callback, None)
+        second = lib.i18n_load_async(engine, paths[1].encode("utf-8"), 1, callback, None)
+        assert lib.i18n_load_wait(second, 5000) == LOAD_DONE
+        assert lib.i18n_load_status(first) in (LOAD_DONE, LOAD_CANCELLED)
+        assert translate(engine, "a1b2c3") == "Zwei"
+        lib.i18n_load_free(first)
+        lib.i18n_load_free(second)
+
+        # Synchrones Laden überholt einen laufenden asynchronen Auftrag ebenfalls.
+        pending = lib.i18n_load_async(engine, paths[0].encode("utf-8"), 1, RELOAD_FN(), None)
+        assert lib.i18n_load_txt_file(engine, paths[1].encode("utf-8"), 1) == 0
+        assert lib.i18n_load_wait(pending, 5000) in (LOAD_DONE, LOAD_CANCELLED)
+        assert translate(engine, "a1b2c3") == "Zwei"
+        lib.i18n_load_free(pending)
+
+        broken = lib.i18n_load_async(engine, paths[2].encode("utf-8"), 1, RELOAD_FN(), None)
+        assert lib.i18n_load_wait(broken, 5000) == LOAD_FAILED and load_error(broken)
+        assert translate(engine, "a1b2c3") == "Zwei"
+        lib.i18n_load_free(broken)
+
+        reload = lib.i18n_reload_async(engine, RELOAD_FN(), None)
+        lib.i18n_load_cancel(reload)
+        assert lib.i18n_load_wait(reload, 5000) in (LOAD_DONE, LOAD_CANCELLED)
+        lib.i18n_load_free(reload)
+
+        # Wie synchrones Laden verlässt ein asynchroner Katalog den Locale-Modus.
+        with open(paths[0], "w", encoding="utf-8") as fh:
+            fh.write("a1b2c3: Async\n")
+        localized = lib.i18n_new()
+        try:
+            assert lib.i18n_add_locale_txt(localized, None, b"@meta locale=de\na1b2c3: Alt\n", 1) == 0
+            assert lib.i18n_set_locale(localized, b"de") == 0
+            handle = lib.i18n_load_async(localized, paths[0].encode("utf-8"), 1, RELOAD_FN(), None)
+            assert lib.i18n_load_wait(handle, 5000) == LOAD_DONE and translate(localized, "a1b2c3") == "Async"
+            lib.i18n_load_free(handle)
+            assert lib.i18n_add_locale_txt(localized, None, b"@meta locale=de\na1b2c3: Neu\n", 1) == 0
+            assert translate(localized, "a1b2c3") == "Async"
+        finally:
+            lib.i18n_free(localized)
+
+
+def check_locales(engine):
+    def chain():
+        buf = ctypes.create_string_buffer(256)
+        lib.i18n_get_locale_chain(engine, buf, len(buf))
+        return buf.value.decode("utf-8").split()
+
+    de = "@meta locale=de_DE\n@meta fallback=en_US\na1a1a1: Hallo\nc1c1c1{one}: Ein Item\nc1c1c1{other}: %0 Items\n"
+    en = "@meta locale=en\na1a1a1: Hello\nb2b2b2: Only @a1a1a1\nc1c1c1{one}: One item\nc1c1c1{few}: %0 few\n"
+    assert lib.i18n_add_locale_txt(engine, None, de.encode("utf-8"), 1) == 0
+    assert lib.i18n_set_locale(engine, b"de") == 0 and chain() == ["de_DE"]
+    assert translate(engine, "b2b2b2") == "⟦b2b2b2⟧"
+    assert lib.i18n_add_locale_txt(engine, None, en.encode("utf-8"), 1) == 0  # Kette wird sofort neu aufgelöst
+    assert chain() == ["de_DE", "en"]
+    assert translate(engine, "a1a1a1") == "Hallo"
+    assert translate(engine, "b2b2b2") == "Only Hallo"  # Fallback-Eintrag, Referenz aus der aktiven Locale
+    assert translate_plural(engine, "c1c1c1", 1) == "Ein Item"
+    assert lib.i18n_set_locale(engine, b"en_GB") == 0 and chain() == ["en"]
+    assert translate(engine, "b2b2b2") == "Only Hello"
+    assert lib.i18n_set_locale(engine, b"fr") == -1 and "fr" in last_error(engine)
+    assert translate(engine, "a1a1a1") == "Hello"
+    assert lib.i18n_load_txt(engine, b"a1a1a1: Einzeln\n", 1) == 0 and chain() == []
+
+
+def check_hex_keys(engine):
+    wide = "0123456789abcdef0123456789ABCDEF"
+    src = f"00abcdef: null\nabcdef: kurz\nABCDEF12: gross\n{wide}: breit\n"
+    assert lib.i18n_load_txt(engine, src.encode("utf-8"), 1) == 0
+    assert translate(engine, "00ABCDEF") == "null" and translate(engine, "abcdef") == "kurz"
+    assert translate(engine, "000abcdef") == "⟦000abcdef⟧"  # führende Nullen gehören zum Schlüssel
+    assert translate(engine, "abcdef12") == "gross" and translate(engine, wide.lower()) == "breit"
+    assert lib.i18n_load_txt(engine, b"abcdef: a\nABCDEF: b\n", 1) == -1 and "Doppelter Token" in last_error(engine)
+    # Tokens über 65535 Bytes passen nicht in den Record und werden beim Laden abgewiesen.
+    assert lib.i18n_load_txt(engine, b"style_" + b"x" * 65536 + b": a\n", 1) == -1
+    assert "65535" in last_error(engine)
+
+
+def span_call(fn, engine, token, args, count=(), flags=()):
+    # token und args als (bytes, len) aus größeren Puffern: nichts davon ist NUL-terminiert
+    arr = (SpanArg * len(args))(*[SpanArg(data, size) for data, size in args]) if args else None
+    needed = fn(engine, token[0], token[1], *count, arr, len(args), *flags, None, 0)
+    buf = ctypes.create_string_buffer(max(needed, 0) + 1)
+    assert fn(engine, token[0], token[1], *count, arr, len(args), *flags, buf, len(buf)) == needed
+    return buf.raw[:needed].decode("utf-8")
+
+
+def check_span_args(engine):
+    src = ("a1a1a1: [%0|%1]\nb2b2b2: Wert\nc3c3c3: %0\nc3c3c3{one}: eins %0\nc3c3c3{other}: viele %0\n"
+           "style_box: --mass: 3; color: %0;\ntpl_box: <p class=\"@style_box\">%1</p>\n")
+    assert lib.i18n_load_txt(engine, src.encode("utf-8"), 1) == 0
+    token = (b"A1A1A1-rest", 6)
+    assert span_call(lib.i18n_translate_n, engine, token, [(b"b2b2b2xx", 6), (b"x\0y", 3)]) == "[Wert|x\0y]"
+    assert span_call(lib.i18n_translate_n, engine, token, [(b"=b2b2b2", 7), (None, 0)]) == "[b2b2b2|]"
+    assert span_call(lib.i18n_translate_n, engine, token, [(b"zz", 2)]) == "[zz|⟦arg:1⟧]"
+    assert span_call(lib.i18n_translate_plural_n, engine, (b"c3c3c3c3", 6), [(b"1", 1)], (1,)) == "eins 1"
+    html = span_call(lib.i18n_render_to_html_n, engine, (b"tpl_box", 7), [(b"#ff0000;;", 7), (b"Hi", 2)], flags=(0,))
+    assert "color: #ff0000;" in html and html.endswith('<p class="style_box">Hi</p>')
+    style = NativeStyle()
+    arg = (SpanArg * 1)(SpanArg(b"#00ff00", 7))
+    assert lib.i18n_get_native_style_n(engine, b"style_boxes", 9, arg, 1, ctypes.byref(style)) == 0
+    assert style.has_values == 1 and style.mass == 3.0
+    assert lib.i18n_translate_n(engine, b"a1a1a1", -1, None, 0, None, 0) == -1
+
+
+def check_arg_cache(engine):
+    src = "a1a1a1: %0-%0 <@b2b2b2>\nb2b2b2: [%0|%1]\nc3c3c3: C @d4d4d4\nd4d4d4: D\ne5e5e5: %0 @f6f6f6\nf6f6f6: (%0)\n"
+    assert lib.i18n_load_txt(engine, src.encode("utf-8"), 1) == 0
+    tokens = []
+    on_span = TRACE_FN(lambda user, span: tokens.append(span[0].token.decode()))
+    assert lib.i18n_set_trace(engine, on_span, None, 0, 1.0) == 0
+    arr, _buffers = prepare_args(["C3C3C3", "=c3c3c3"])
+    assert lib.i18n_translate(engine, b"a1a1a1", arr, 2, None, 0) == len("C D-C D <[C D|c3c3c3]>")
+    assert tokens.count("c3c3c3") == 1 and tokens.count("d4d4d4") == 1  # einmal expandiert, dreimal eingesetzt
+    assert lib.i18n_set_trace(engine, TRACE_FN(), None, 0, 1.0) == 0
+    assert translate(engine, "a1a1a1", ["C3C3C3", "=c3c3c3"]) == "C D-C D <[C D|c3c3c3]>"
+    # Unter @f6f6f6 liegt f6f6f6 auf dem Pfad: dort wird das Arg neu expandiert und ergibt den Zyklus.
+    assert translate(engine, "e5e5e5", ["f6f6f6"]) == "(⟦arg:0⟧) (⟦CYCLE:f6f6f6⟧)"
+    # Ein Hook, der selbst übersetzt, darf das Ergebnis des äußeren Aufrufs nicht überschreiben.
+    inner = lib.i18n_new()
+    try:
+        assert lib.i18n_load_txt(inner, b"a1a1a1: innen und deutlich laenger als aussen\n", 1) == 0
+        on_span = TRACE_FN(lambda user, span: translate(inner, "a1a1a1"))
+        assert lib.i18n_set_trace(engine, on_span, None, 0, 1.0) == 0
+        buf = ctypes.create_string_buffer(256)
+        assert lib.i18n_translate(engine, b"d4d4d4", None, 0, buf, len(buf)) == 1 and buf.value == b"D"
+        assert lib.i18n_set_trace(engine, TRACE_FN(), None, 0, 1.0) == 0
+    finally:
+        lib.i18n_free(inner)
+
+
+def stats_text(fn, engine):
+    needed = fn(engine, None, 0)
+    buf = ctypes.create_string_buffer(needed + 1)
+    fn(engine, buf, len(buf))
+    return buf.value.decode("utf-8")
+
+
+def check_stats():
+    engine = lib.i18n_new()
+    try:
+        src = "a1a1a1: @b2b2b2 und @c3c3c3\nb2b2b2: zurück zu @a1a1a1\n"
+        assert lib.i18n_load_txt(engine, src.encode("utf-8"), 1) == 0
+        assert translate(engine, "a1a1a1") == "zurück zu ⟦CYCLE:a1a1a1⟧ und ⟦MISSING:@c3c3c3⟧"
+        assert translate(engine, "ffffff") == "⟦ffffff⟧"
+        stats = json.loads(stats_text(lib.i18n_stats_json, engine))  # translate() ruft zweimal (Länge, Inhalt)
+        calls = stats["calls"]["translate"]
+        assert calls["count"] == 4 and calls["timed"] <= 1 and sum(calls["buckets"]) == calls["timed"]
+        assert stats["calls"]["load"]["count"] == stats["calls"]["load"]["timed"] == 1  # Laden immer gemessen
+        assert stats["calls"]["reload"]["count"] == 0
+        assert len(stats["bucket_bounds_ns"]) + 1 == len(stats["calls"]["translate"]["buckets"])
+        assert stats["events"]["missing"] == 4 and stats["events"]["cycle"] == 2
+        assert stats["load_phases"]["parse"]["runs"] == 1 and stats["load_phases"]["install"]["runs"] == 1
+        assert stats["load_phases"]["read"]["runs"] == 0  # Quelltext, keine Datei
+        prom = stats_text(lib.i18n_stats_prometheus, engine)
+        assert 'i18n_calls_total{api="translate"} 4\n' in prom
+        assert 'i18n_call_duration_seconds_count{api="translate"} %d\n' % calls["timed"] in prom
+        assert 'i18n_events_total{event="cycle"} 2\n' in prom
+        assert lib.i18n_stats_reset(engine) == 0
+        stats = json.loads(stats_text(lib.i18n_stats_json, engine))
+        assert stats["calls"]["translate"]["count"] == 0 and stats["events"]["missing"] == 0
+        assert stats["load_phases"]["parse"]["last_ns"] == 0
+        # Nach dem Aufwärmen wächst der Scratch des Resolvers nicht mehr.
+        translate(engine, "a1a1a1", ["x" * 200])
+        assert lib.i18n_stats_reset(engine) == 0
+        for _ in range(19):
+            translate(engine, "a1a1a1", ["x" * 200])
+        stats = json.loads(stats_text(lib.i18n_stats_json, engine))
+        assert stats["events"]["scratch_resize"] == 0 and stats["events"]["cycle"] == 38
+        # Lange Style-Refs (über SSO) werden im Scratch geparst, nicht in eigenen Strings.
+        src = "a1a1a1: x @style_button_primary{hover} y\nstyle_button_primary{hover}: color: #00f;\n"
+        assert lib.i18n_load_txt(engine, src.encode("utf-8"), 1) == 0
+        assert translate(engine, "a1a1a1") == "x color: #00f; y"
+        assert lib.i18n_stats_reset(engine) == 0
+        for _ in range(19):
+            translate(engine, "a1a1a1")
+        stats = json.loads(stats_text(lib.i18n_stats_json, engine))
+        assert stats["events"]["scratch_resize"] == 0 and stats["events"]["missing"] == 0
+    finally:
+        lib.i18n_free(engine)
+
+
+def check_trace(engine):
+    spans = []
+    on_span = TRACE_FN(lambda user, span: spans.append(
+        (span[0].name.decode(), span[0].token.decode(), span[0].depth, span[0].parent,
+         span[0].output_bytes, span[0].generation, span[0].arg_count)))
+    src = "a1a1a1: <@b2b2b2>\nb2b2b2: [@c3c3c3]\nc3c3c3: %0\n"
+    assert lib.i18n_load_txt(engine, src.encode("utf-8"), 1) == 0
+    assert lib.i18n_set_trace(engine, on_span, None, 0, 1.0) == 0
+    arr, _buffers = prepare_args(["x"])
+    assert lib.i18n_translate(engine, b"A1A1A1", arr, 1, None, 0) == len("<[x]>")
+    root, *inner = spans
+    assert root[:4] == ("translate", "A1A1A1", 2, -1) and root[4] == 5 and root[6] == 1
+    assert [(s[1], s[2], s[3]) for s in inner] == [("a1a1a1", 2, 0), ("b2b2b2", 2, 1), ("c3c3c3", 2, 2)]
+    assert [s[4] for s in inner] == [5, 3, 1] and all(s[5] == root[5] for s in inner)
+    generation = root[5]
+    assert lib.i18n_load_txt(engine, src.encode("utf-8"), 1) == 0
+    spans.clear()
+    translate(engine, "c3c3c3", ["y"])
+    assert spans[0][5] > generation
+    spans.clear()
+    assert lib.i18n_set_trace(engine, on_span, None, 10 ** 12, 1.0) == 0  # nichts ist so langsam
+    translate(engine, "a1a1a1", ["x"])
+    assert spans == []
+    assert lib.i18n_set_trace(engine, on_span, None, 0, 0.5) == 0
+    for _ in range(4):
+        lib.i18n_translate(engine, b"c3c3c3", arr, 1, None, 0)
+    assert [s[0] for s in spans].count("translate") == 2
+    spans.clear()
+    assert lib.i18n_set_trace(engine, TRACE_FN(), None, 0, 1.0) == 0
+    translate(engine, "a1a1a1", ["x"])
+    assert spans == []
+
+
+def check_overlays(base):
+    tenant = lib.i18n_new()
+    try:
+        assert lib.i18n_memory_stats(tenant, ctypes.byref(MemoryStats())) == -1
+        box = render(base, "tpl_box", ["#ff0000", "Titel"])
+        cube = render(base, "tpl_cube")
+        assert lib.i18n_push_overlay_txt(tenant, b"style_frame: x;", 1) == -1  # keine Basis
+        assert lib.i18n_share_catalog(tenant, base) == 0 and lib.i18n_overlay_depth(tenant) == 0
+        assert render(tenant, "tpl_box", ["#ff0000", "Titel"]) == box
+        theme = "style_frame: padding: 2rem; border: 2px dashed %0;\nstyle_badge: color: #ff00ff;\n"
+        assert lib.i18n_push_overlay_txt(tenant, theme.encode("utf-8"), 1) == 0
+        assert lib.i18n_overlay_depth(tenant) == 1
+        base_mem, tenant_mem = MemoryStats(), MemoryStats()
+        assert lib.i18n_memory_stats(base, ctypes.byref(base_mem)) == 0 and base_mem.shared_base == 0
+        assert lib.i18n_memory_stats(tenant, ctypes.byref(tenant_mem)) == 0
+        assert tenant_mem.entries == base_mem.entries + 1  # style_badge ist neu
+        assert tenant_mem.shared_base == base_mem.total and tenant_mem.arena < base_mem.arena
+        themed = render(tenant, "tpl_box", ["#ff0000", "Titel"])
+        assert ".style_frame{padding: 2rem; border: 2px dashed #ff0000;}" in themed
+        assert ".style_title{font-weight: 700; padding: 2rem;" in themed  # abhängiger Style neu aufgelöst
+        assert render(tenant, "tpl_cube") != cube  # nutzt style_title{hover} -> style_frame
+        assert translate(tenant, "style_badge") == "color: #ff00ff;"
+        assert render(base, "tpl_box", ["#ff0000", "Titel"]) == box  # Basis unverändert
+        assert lib.i18n_push_overlay_txt(tenant, b"tpl_cube: <b>@style_badge</b>\n", 1) == 0
+        assert lib.i18n_overlay_depth(tenant) == 2 and render(tenant, "tpl_cube").endswith("<b>style_badge</b>")
+        # Index-Ebenen: neue Tokens, verdeckte Zeilen und aufgelöste Lücken einer Ebene darunter.
+        cube_users = token_list(lib.i18n_get_dependents, base, b"style_cube", 0)
+        assert token_list(lib.i18n_get_references, tenant, b"tpl_cube") == ["style_badge"]
+        assert token_list(lib.i18n_get_dependents, tenant, b"style_cube", 0) == [t for t in cube_users if t != "tpl_cube"]
+        assert lib.i18n_push_overlay_txt(tenant, b"style_aa: @style_ghost;\n", 1) == 0
+        assert token_list(lib.i18n_get_references, tenant, b"style_aa") == ["style_ghost"]
+        assert "style_ghost" in run_check(tenant)[1]
+        assert lib.i18n_push_overlay_txt(tenant, b"style_ghost: --x: 1;\n", 1) == 0
+        assert token_list(lib.i18n_get_dependents, tenant, b"style_ghost", 0) == ["style_aa"]
+        assert token_list(lib.i18n_get_dependents, tenant, b"style_badge", 0) == ["tpl_cube"]
+        assert token_list(lib.i18n_get_dependents, tenant, b"style_frame", 0) == ["style_title", "tpl_box"]
+        assert "style_ghost" not in run_check(tenant)[1]
+        assert find_page(tenant, "--x: 1", 0, 10) == (1, ["style_ghost"])
+        cursor = lib.i18n_iter_begin(base, b"style_")
+        base_styles = [entry[0] for entry in iterate(cursor)]
+        lib.i18n_iter_end(cursor)
+        cursor = lib.i18n_iter_begin(tenant, b"style_")
+        assert [entry[0] for entry in iterate(cursor)] == sorted(base_styles + ["style_aa", "style_badge", "style_ghost"])
+        lib.i18n_iter_end(cursor)
+        assert lib.i18n_pop_overlay(tenant) == 0 and lib.i18n_pop_overlay(tenant) == 0
+        assert lib.i18n_pop_overlay(tenant) == 0 and render(tenant, "tpl_box", ["#ff0000", "Titel"]) == themed
+        assert lib.i18n_pop_overlay(tenant) == 0 and render(tenant, "tpl_cube") == cube
+        assert lib.i18n_pop_overlay(tenant) == -1
+    finally:
+        lib.i18n_free(tenant)
+
+
+def native_property(engine, token, prop_id, args=None):
+    args = args or []
+    arr, buffers = prepare_args(args)
+    value = ctypes.c_float()
+    rc = lib.i18n_get_native_property(engine, token.encode("utf-8"), arr, len(args), prop_id, ctypes.byref(value))
+    return rc, value.value
+
+
+def check_schema_views():
+    # Ein neuer Kanal muss auch in vorberechneten Locale-Sichten und unter Overlays ankommen.
+    engine = lib.i18n_new()
+    try:
+        assert lib.i18n_add_locale_txt(engine, None, b"@meta locale=de\nstyle_z: --lift: 2;\n", 1) == 0
+        assert lib.i18n_add_locale_txt(engine, None, b"@meta locale=en\nstyle_z: --lift: 5;\n", 1) == 0
+        assert lib.i18n_set_locale(engine, b"en") == 0
+        assert lib.i18n_push_overlay_txt(engine, b"style_w: --lift: 7;\n", 1) == 0
+        lift = lib.i18n_register_property(engine, b"--lift")
+        assert native_property(engine, "style_w", lift) == (1, 7.0)
+        assert lib.i18n_pop_overlay(engine) == 0 and native_property(engine, "style_z", lift) == (1, 5.0)
+        assert lib.i18n_set_locale(engine, b"de") == 0 and native_property(engine, "style_z", lift) == (1, 2.0)
+    finally:
+        lib.i18n_free(engine)
+
+
 def load_catalog(engine, fname):
     path = os.path.join(BASE_DIR, "catalogs", fname)
     if lib.i18n_load_txt_file(engine, path.encode("utf-8"), 1) != 0:
@@ -89,6 +748,31 @@ def run_check(engine):
     return code, buf.value.decode("utf-8")
 
 
+def check_json(engine):
+    chunks = []
+
+    def sink(user, data, length):
+        chunks.append(ctypes.string_at(data, length))
+        return 0
+
+    code = lib.i18n_check_to_sink(engine, 1, SINK_FN(sink), None)
+    return code, json.loads(b"".join(chunks).decode("utf-8"))
+
+
+def check_records(engine):
+    run = lib.i18n_check_run(engine)
+    records = []
+    for i in range(lib.i18n_check_issue_count(run)):
+        issue = CheckIssue()
+        assert lib.i18n_check_issue(run, i, ctypes.byref(issue)) == 0
+        records.append((issue.kind, issue.is_error,
+                        ctypes.string_at(issue.token, issue.token_len).decode("utf-8"),
+                        ctypes.string_at(issue.detail, issue.detail_len).decode("utf-8")))
+    code = lib.i18n_check_code(run)
+    lib.i18n_check_free(run)
+    return code, records
+
+
 def check_meta(engine):
     buf = ctypes.create_string_buffer(128)
     lib.i18n_get_meta_locale_copy(engine, buf, len(buf))
@@ -119,6 +803,8 @@ def main():
         ("cycle.txt", False),
         ("plural_variants.txt", True),
         ("args_token_resolution.txt", True),
+        ("physics_channels.txt", True),
+        ("templates.txt", True),
     ]
     failures = 0
     for fname, should_pass in tests:
@@ -139,12 +825,128 @@ def main():
                 assert fallback == "en_US"
                 assert note == "Training 2026"
                 assert plural == 0
+                check_watcher(engine)
+                check_async_load(engine)
+            if fname == "cycle.txt":
+                assert "ERROR CYCLE: a1a1a1 -> b2b2b2 -> a1a1a1" in report
+                code, doc = check_json(engine)
+                assert code == 3 and doc["status"] == "FAIL" and doc["errors"] == 1
+                assert doc["issues"] == [{"severity": "error", "kind": "cycle", "token": "a1a1a1",
+                                          "detail": "a1a1a1 -> b2b2b2 -> a1a1a1"}]
+            if fname == "missing_ref.txt":
+                assert check_records(engine) == (3, [(1, 1, "123abc", "deadbeef")])
             if fname == "plural_variants.txt":
                 result = translate_plural(engine, "c1c1c1", 2, ["2"])
                 assert "2" in result
+                check_locales(engine)
+                check_hex_keys(engine)
+                check_stats()
+                check_trace(engine)
+                check_span_args(engine)
+                check_arg_cache(engine)
+                check_schema_views()
             if fname == "args_token_resolution.txt":
                 assert translate(engine, "aa11bb", ["deadbeef"]) == "Wert Bedeutungsstring"
                 assert translate(engine, "cc22dd", ["=deadbeef"]) == "Literal deadbeef"
+            if fname == "templates.txt":
+                html = render(engine, "tpl_box", ["#ff0000", "Titel"])
+                assert html.startswith("<style>\n.style_frame{padding: 1rem; border: 1px solid #ff0000;}\n")
+                assert html.endswith('</style>\n<div class="style_frame">   <h1 class="style_title">Titel</h1>')
+                assert render(engine, "tpl_box", ["#ff0000", "Titel"], 1).endswith('<div class="style_frame"> <h1 class="style_title">Titel</h1>')
+                injected = render(engine, "tpl_inject", ['<p class="@style_cube">x</p>'])
+                assert ".style_cube{" in injected and '<p class="style_cube">x</p>' in injected
+                assert 'class="style_cube style_title-hover-"' in render(engine, "tpl_cube")
+                assert physics_json(engine, "tpl_cube") == ('{"style_cube":{"mass":2,"friction":0.5,"restitution":0,'
+                                                            '"drag":0,"gravity_scale":1,"spacing":1.25}}')
+                packed = physics_packed(engine, "tpl_cube")
+                assert packed[:13] == b"\x81\xaastyle_cube\x86" and len(packed) == 13 + 6 * 6
+                assert struct.unpack(">BBf", packed[13 + 5 * 6:]) == (5, 0xCA, 1.25)
+                assert physics_json(engine, "tpl_box", ["#fff", "x"]) == "{}"
+                assert "style_cube" in physics_json(engine, "tpl_inject", ['<i class="@style_cube"></i>'])
+                css, name = stylesheet(engine)
+                assert css.startswith(".style_cube{") and ".style_title" not in css
+                assert name.startswith("mycelia.") and name.endswith(".css") and len(name) == len("mycelia.00000000.css")
+                css_cube, name_cube = stylesheet(engine, ["tpl_cube"])
+                assert css_cube == ".style_cube{--mass: 2; --friction: 0.5; --spacing: 1.25; color: #0f172a;}\n"
+                assert name_cube == name
+                assert stylesheet(engine, ["tpl_box"])[0] == ""
+                linked = render_linked(engine, "tpl_box", name, ["#00ff00", "T"])
+                assert linked.startswith('<link rel="stylesheet" href="%s">\n<style>\n.style_frame{' % name)
+                linked_cube = render_linked(engine, "tpl_cube", "a.css")
+                assert linked_cube.startswith('<link rel="stylesheet" href="a.css">\n<style>\n.style_title-hover-{')
+                assert ".style_cube{" not in linked_cube
+                assert stylesheet(engine, ["tpl_inject"])[0] == ""
+                linked_inject = render_linked(engine, "tpl_inject", "a.css", ['<p class="@style_cube">x</p>'])
+                assert '<style>\n.style_cube{--mass: 2;' in linked_inject  # nicht im Template-Stylesheet
+                assert render_streamed(engine, "tpl_box", ["#ff0000", "Titel"], 1) == (0, render(engine, "tpl_box", ["#ff0000", "Titel"], 1))
+                names = []
+                on_span = TRACE_FN(lambda user, span: names.append((span[0].name, span[0].parent)))
+                assert lib.i18n_set_trace(engine, on_span, None, 0, 1.0) == 0
+                render(engine, "tpl_box", ["#ff0000", "Titel"])
+                assert lib.i18n_set_trace(engine, TRACE_FN(), None, 0, 0.0) == 0
+                assert (b"render_to_html", -1) in names and (b"build_style_definitions", 0) in names
+                assert render_streamed(engine, "tpl_cube") == (0, render(engine, "tpl_cube"))
+                rc, partial = render_streamed(engine, "tpl_box", ["#ff0000", "Titel"], abort=True)
+                assert rc == -1 and last_error(engine) == "SINK_ABORTED" and partial.startswith("<style>")
+                jobs = [("tpl_box", ["#%06x" % i, "Karte %d" % i]) for i in range(40)] + [("tpl_cube", []), ("tpl_missing", [])]
+                assert render_batch(engine, jobs, 4) == [render(engine, tok, args) for tok, args in jobs]
+                check_overlays(engine)
+                rc, found = find_to_fd(engine, "--mass")
+                assert rc == 0 and found.startswith("style_cube(")
+                assert find_page(engine, "STYLE_", 0, 0) == (4, ["style_title", "style_title{hover}", "tpl_box", "tpl_cube"])
+                assert find_page(engine, "style_", 1, 2) == (4, ["style_title{hover}", "tpl_box"])
+                assert find_page(engine, "zz", 0, 10) == (0, [])
+                cursor = lib.i18n_iter_begin(engine, b"style_title")
+                lib.i18n_load_txt(engine, b"style_other: x;", 0)  # Cursor hält den alten Snapshot fest
+                assert iterate(cursor) == [("style_title", "", "font-weight: 700; @style_frame;"),
+                                           ("style_title{hover}", "", "@style_title; color: #38bdf8;")]
+                lib.i18n_iter_end(cursor)
+                cursor = lib.i18n_iter_begin(engine, None)
+                assert iterate(cursor) == [("style_other", "", "x;")]
+                lib.i18n_iter_end(cursor)
+                load_catalog(engine, fname)
+                assert token_list(lib.i18n_get_references, engine, b"tpl_cube") == ["style_cube", "style_title{hover}"]
+                assert token_list(lib.i18n_get_dependents, engine, b"style_frame", 0) == ["style_title", "tpl_box"]
+                assert token_list(lib.i18n_get_dependents, engine, b"style_frame", 1) == [
+                    "style_title", "style_title{hover}", "tpl_box", "tpl_cube"]
+                assert token_list(lib.i18n_get_dependents, engine, b"style_nope", 1) is None
+                assert token_list(lib.i18n_get_references, engine, b"TPL_Cube") == ["style_cube", "style_title{hover}"]
+                assert token_list(lib.i18n_get_dependents, engine, b"Style_Frame", 0) == ["style_title", "tpl_box"]
+                pages = [("box.html", "tpl_box", ["#123456", "Box"]), ("cube.html", "tpl_cube", []),
+                         ("sub/inject.html", "tpl_inject", ['<i class="@style_cube"></i>'])]
+                with tempfile.TemporaryDirectory() as site_dir:
+                    assert site_build(engine, site_dir, pages) == (3, ["box.html", "cube.html", "sub/inject.html"])
+                    assert site_build(engine, site_dir, pages) == (0, [])
+                    assert site_build(engine, site_dir, pages, flags=1)[0] == 3  # Minify ändert die Ausgabe
+                    assert site_build(engine, site_dir, pages)[0] == 3
+                    for bad in ("../escape.html", "sub/../../escape.html", os.path.join(site_dir, "abs.html")):
+                        assert site_build(engine, site_dir, [(bad, "tpl_cube", [])])[0] == -1
+                    assert not os.path.exists(os.path.join(os.path.dirname(site_dir), "escape.html"))
+                    with open(os.path.join(BASE_DIR, "catalogs", fname), encoding="utf-8") as fh:
+                        edited = fh.read().replace("--mass: 2;", "--mass: 3;").replace("color: #0f172a", "color: #111111")
+                    assert lib.i18n_load_txt(engine, edited.encode("utf-8"), 1) == 0
+                    assert site_build(engine, site_dir, pages) == (2, ["cube.html", "sub/inject.html"])
+                    with open(os.path.join(site_dir, "cube.html"), encoding="utf-8") as fh:
+                        assert "#111111" in fh.read()
+                    load_catalog(engine, fname)
+            if fname == "physics_channels.txt":
+                buoyancy = lib.i18n_register_property(engine, b"--buoyancy")
+                stiffness = lib.i18n_register_property(engine, b"stiffness")
+                assert buoyancy == 6 and stiffness == 7
+                assert lib.i18n_register_property(engine, b"--Buoyancy") == buoyancy
+                assert lib.i18n_register_property(engine, b"--gap") == 5
+                rc, value = native_property(engine, "style_buoy", buoyancy)
+                assert rc == 1 and abs(value - 0.75) < 1e-6
+                rc, value = native_property(engine, "style_buoy", stiffness, ["12.5"])
+                assert rc == 1 and abs(value - 12.5) < 1e-6
+                rc, value = native_property(engine, "style_plain", buoyancy)
+                assert rc == 0
+                values = (ctypes.c_float * 8)()
+                mask = ctypes.c_uint32()
+                count = lib.i18n_get_native_properties(engine, b"style_buoy", None, 0, values, 8, ctypes.byref(mask))
+                assert count == 8
+                assert abs(values[0] - 2.5) < 1e-6 and abs(values[5] - 3.0) < 1e-6
+                assert mask.value == (1 << 0) | (1 << 5) | (1 << buoyancy)
         except Exception as exc:
             print(f"❌ {fname}: {exc}")
             failures += 1